@@ -297,6 +297,11 @@ foreach(component ${Magnum_FIND_COMPONENTS})
     elseif(${component} STREQUAL MeshTools)
         set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
 
+    # Scene graph library
+    elseif(${component} STREQUAL SceneGraph)
+        find_package(Threads REQUIRED)
+        set(_MAGNUM_${_COMPONENT}_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
     # Primitives library
     elseif(${component} STREQUAL Primitives)
         set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
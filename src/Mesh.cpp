@@ -85,7 +85,7 @@ std::size_t Mesh::indexSize(IndexType type) {
 
 Mesh::Mesh(MeshPrimitive primitive): _primitive(primitive), _vertexCount(0), _indexCount(0)
     #ifndef MAGNUM_TARGET_GLES2
-    , _indexStart(0), _indexEnd(0)
+    , _indexStart(0), _indexEnd(0), _instanceCount(1)
     #endif
     , _indexOffset(0), _indexType(IndexType::UnsignedInt), _indexBuffer(nullptr)
 {
@@ -102,7 +102,7 @@ Mesh::~Mesh() {
 
 Mesh::Mesh(Mesh&& other) noexcept: _id(other._id), _primitive(other._primitive), _vertexCount(other._vertexCount), _indexCount(other._indexCount)
     #ifndef MAGNUM_TARGET_GLES2
-    , _indexStart(other._indexStart), _indexEnd(other._indexEnd)
+    , _indexStart(other._indexStart), _indexEnd(other._indexEnd), _instanceCount(other._instanceCount)
     #endif
     , _indexOffset(other._indexOffset), _indexType(other._indexType), _indexBuffer(other._indexBuffer), _attributes(std::move(other._attributes))
     #ifndef MAGNUM_TARGET_GLES2
@@ -123,6 +123,7 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
     #ifndef MAGNUM_TARGET_GLES2
     std::swap(_indexStart, other._indexStart);
     std::swap(_indexEnd, other._indexEnd);
+    std::swap(_instanceCount, other._instanceCount);
     #endif
     std::swap(_indexOffset, other._indexOffset);
     std::swap(_indexType, other._indexType);
@@ -175,18 +176,35 @@ Mesh& Mesh::setIndexBuffer(Buffer& buffer, GLintptr offset, IndexType type, Unsi
 }
 
 #ifndef MAGNUM_TARGET_GLES2
-void Mesh::drawInternal(Int firstVertex, Int vertexCount, GLintptr indexOffset, Int indexCount, Int indexStart, Int indexEnd)
+void Mesh::drawInternal(Int firstVertex, Int vertexCount, GLintptr indexOffset, Int indexCount, Int indexStart, Int indexEnd, Int instanceCount)
 #else
 void Mesh::drawInternal(Int firstVertex, Int vertexCount, GLintptr indexOffset, Int indexCount)
 #endif
 {
     /* Nothing to draw */
+    #ifndef MAGNUM_TARGET_GLES2
+    if((!vertexCount && !indexCount) || !instanceCount) return;
+    #else
     if(!vertexCount && !indexCount) return;
+    #endif
 
     (this->*bindImplementation)();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Instanced non-indexed mesh */
+    if(instanceCount != 1 && !indexCount)
+        glDrawArraysInstanced(GLenum(_primitive), firstVertex, vertexCount, instanceCount);
+
+    /* Instanced indexed mesh, there is no ranged variant */
+    else if(instanceCount != 1)
+        glDrawElementsInstanced(GLenum(_primitive), indexCount, GLenum(_indexType), reinterpret_cast<GLvoid*>(indexOffset), instanceCount);
+
+    /* Non-indexed mesh */
+    else if(!indexCount)
+    #else
     /* Non-indexed mesh */
     if(!indexCount)
+    #endif
         glDrawArrays(GLenum(_primitive), firstVertex, vertexCount);
 
     #ifndef MAGNUM_TARGET_GLES2
@@ -216,6 +234,9 @@ void Mesh::vertexAttribPointer(const Attribute& attribute) {
     glEnableVertexAttribArray(attribute.location);
     attribute.buffer->bind(Buffer::Target::Array);
     glVertexAttribPointer(attribute.location, attribute.size, attribute.type, attribute.normalized, attribute.stride, reinterpret_cast<const GLvoid*>(attribute.offset));
+    #ifndef MAGNUM_TARGET_GLES2
+    if(attribute.divisor) glVertexAttribDivisor(attribute.location, attribute.divisor);
+    #endif
 }
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -223,6 +244,7 @@ void Mesh::vertexAttribPointer(const IntegerAttribute& attribute) {
     glEnableVertexAttribArray(attribute.location);
     attribute.buffer->bind(Buffer::Target::Array);
     glVertexAttribIPointer(attribute.location, attribute.size, attribute.type, attribute.stride, reinterpret_cast<const GLvoid*>(attribute.offset));
+    if(attribute.divisor) glVertexAttribDivisor(attribute.location, attribute.divisor);
 }
 
 #ifndef MAGNUM_TARGET_GLES
@@ -230,6 +252,7 @@ void Mesh::vertexAttribPointer(const LongAttribute& attribute) {
     glEnableVertexAttribArray(attribute.location);
     attribute.buffer->bind(Buffer::Target::Array);
     glVertexAttribLPointer(attribute.location, attribute.size, attribute.type, attribute.stride, reinterpret_cast<const GLvoid*>(attribute.offset));
+    if(attribute.divisor) glVertexAttribDivisor(attribute.location, attribute.divisor);
 }
 #endif
 #endif
@@ -305,6 +328,7 @@ void Mesh::attributePointerImplementationVAO(const Attribute& attribute) {
 void Mesh::attributePointerImplementationDSA(const Attribute& attribute) {
     glEnableVertexArrayAttribEXT(_id, attribute.location);
     glVertexArrayVertexAttribOffsetEXT(_id, attribute.buffer->id(), attribute.location, attribute.size, attribute.type, attribute.normalized, attribute.stride, attribute.offset);
+    if(attribute.divisor) glVertexArrayVertexAttribDivisorEXT(_id, attribute.location, attribute.divisor);
 }
 #endif
 
@@ -322,6 +346,7 @@ void Mesh::attributePointerImplementationVAO(const IntegerAttribute& attribute)
 void Mesh::attributePointerImplementationDSA(const IntegerAttribute& attribute) {
     glEnableVertexArrayAttribEXT(_id, attribute.location);
     glVertexArrayVertexAttribIOffsetEXT(_id, attribute.buffer->id(), attribute.location, attribute.size, attribute.type, attribute.stride, attribute.offset);
+    if(attribute.divisor) glVertexArrayVertexAttribDivisorEXT(_id, attribute.location, attribute.divisor);
 }
 #endif
 
@@ -338,6 +363,7 @@ void Mesh::attributePointerImplementationVAO(const LongAttribute& attribute) {
 void Mesh::attributePointerImplementationDSA(const LongAttribute& attribute) {
     glEnableVertexArrayAttribEXT(_id, attribute.location);
     glVertexArrayVertexAttribLOffsetEXT(_id, attribute.buffer->id(), attribute.location, attribute.size, attribute.type, attribute.stride, attribute.offset);
+    if(attribute.divisor) glVertexArrayVertexAttribDivisorEXT(_id, attribute.location, attribute.divisor);
 }
 #endif
 #endif
@@ -380,16 +406,28 @@ void Mesh::bindImplementationVAO() {
 }
 
 void Mesh::unbindImplementationDefault() {
-    for(const Attribute& attribute: _attributes)
+    /* Without VAOs the divisor is global state, reset it back so it doesn't
+       leak into meshes drawn later. Not setting it unconditionally in
+       vertexAttribPointer(), as that would need ARB_instanced_arrays for
+       non-instanced meshes too. */
+    for(const Attribute& attribute: _attributes) {
         glDisableVertexAttribArray(attribute.location);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(attribute.divisor) glVertexAttribDivisor(attribute.location, 0);
+        #endif
+    }
 
     #ifndef MAGNUM_TARGET_GLES2
-    for(const IntegerAttribute& attribute: _integerAttributes)
+    for(const IntegerAttribute& attribute: _integerAttributes) {
         glDisableVertexAttribArray(attribute.location);
+        if(attribute.divisor) glVertexAttribDivisor(attribute.location, 0);
+    }
 
     #ifndef MAGNUM_TARGET_GLES
-    for(const LongAttribute& attribute: _longAttributes)
+    for(const LongAttribute& attribute: _longAttributes) {
         glDisableVertexAttribArray(attribute.location);
+        if(attribute.divisor) glVertexAttribDivisor(attribute.location, 0);
+    }
     #endif
     #endif
 }
@@ -29,6 +29,7 @@
  */
 
 #include <vector>
+#include <Utility/Assert.h>
 #include <Utility/ConfigurationValue.h>
 
 #include "AbstractShaderProgram.h"
@@ -283,6 +284,36 @@ respective shader, bind required textures (see
 @ref AbstractShaderProgram-rendering-workflow "AbstractShaderProgram documentation"
 for more infromation) and call @ref Mesh::draw().
 
+@section Mesh-instancing Instanced rendering
+
+If the same mesh is drawn many times with only slightly different parameters
+(e.g. transformation), the draws can be merged into single instanced draw
+call. Put the per-instance data into separate buffer, add it using
+@ref addInstancedVertexBuffer() and set instance count using
+@ref setInstanceCount(). Attributes added this way advance once per given
+number of instances instead of once per vertex:
+@code
+class MyShader: public AbstractShaderProgram {
+    public:
+        typedef Attribute<0, Vector3> Position;
+        typedef Attribute<1, Matrix4> TransformationMatrix;
+
+    // ...
+};
+
+Buffer vertexBuffer, transformationBuffer;
+mesh.addVertexBuffer(vertexBuffer, 0, MyShader::Position())
+    .addInstancedVertexBuffer(transformationBuffer, 1, 0, MyShader::TransformationMatrix());
+
+// Each frame upload the transformations and draw all instances at once
+transformationBuffer.setData(transformations, BufferUsage::StreamDraw);
+mesh.setInstanceCount(transformations.size())
+    .draw();
+@endcode
+
+See also @ref SceneGraph::InstancedDrawableGroup for integration with scene
+graph.
+
 @section Mesh-performance-optimization Performance optimizations
 
 If @extension{APPLE,vertex_array_object}, OpenGL ES 3.0 or
@@ -303,7 +334,7 @@ drawing commands are used on desktop OpenGL and OpenGL ES 3.0. See also
 @ref draw() for more information.
 
 @todo Support for indirect draw buffer (OpenGL 4.0, @extension{ARB,draw_indirect})
-@todo Redo in a way that allows glMultiDrawArrays, glDrawArraysInstanced etc.
+@todo Redo in a way that allows glMultiDrawArrays etc.
 @todo test vertex specification & drawing
 @todo How to glDrawElementsBaseVertex()/vertex offset -- in draw()?
  */
@@ -494,6 +525,28 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /** @brief Instance count */
+        Int instanceCount() const { return _instanceCount; }
+
+        /**
+         * @brief Set instance count
+         * @return Reference to self (for method chaining)
+         *
+         * If set to value other than `1`, the mesh is drawn using instanced
+         * drawing commands. If set to `0`, no draw commands are issued when
+         * calling @ref draw(). Default is `1`.
+         * @see @ref addInstancedVertexBuffer(), @ref Mesh-instancing
+         * @requires_gl31 %Extension @extension{ARB,draw_instanced}
+         * @requires_gles30 Instanced drawing is not available in OpenGL ES
+         *      2.0.
+         */
+        Mesh& setInstanceCount(Int count) {
+            _instanceCount = count;
+            return *this;
+        }
+        #endif
+
         /**
          * @brief Add buffer with (interleaved) vertex attributes for use with given shader
          * @return Reference to self (for method chaining)
@@ -555,9 +608,43 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
          * @todoc Add back the *s when Doxygen is sane again
          */
         template<class ...T> inline Mesh& addVertexBuffer(Buffer& buffer, GLintptr offset, const T&... attributes) {
-            addVertexBufferInternal(buffer, offset, strideOfInterleaved(attributes...), attributes...);
+            addVertexBufferInternal(buffer, offset, strideOfInterleaved(attributes...), 0, attributes...);
+            return *this;
+        }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Add buffer with (interleaved) per-instance vertex attributes
+         * @param buffer        Buffer with the attributes
+         * @param divisor       Number of instances for which the attributes
+         *      have the same value, must be at least `1`
+         * @param offset        Offset of the array from the beginning
+         * @param attributes    Attribute definitions and gaps, same as in
+         *      @ref addVertexBuffer()
+         * @return Reference to self (for method chaining)
+         *
+         * Similar to @ref addVertexBuffer(), but the attributes advance once
+         * per @p divisor instances instead of once per vertex. Use together
+         * with @ref setInstanceCount(). See @ref Mesh-instancing for an
+         * example.
+         *
+         * @attention The buffer passed as parameter is not managed by the
+         *      mesh, you must ensure it will exist for whole lifetime of the
+         *      mesh and delete it afterwards.
+         *
+         * @see @fn_gl{VertexAttribDivisor} or
+         *      @fn_gl_extension{VertexArrayVertexAttribDivisor,EXT,direct_state_access}
+         *      if @extension{APPLE,vertex_array_object} is available
+         * @requires_gl33 %Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Instanced drawing is not available in OpenGL ES
+         *      2.0.
+         */
+        template<class ...T> inline Mesh& addInstancedVertexBuffer(Buffer& buffer, UnsignedInt divisor, GLintptr offset, const T&... attributes) {
+            CORRADE_ASSERT(divisor, "Mesh::addInstancedVertexBuffer(): divisor must be at least one", *this);
+            addVertexBufferInternal(buffer, offset, strideOfInterleaved(attributes...), divisor, attributes...);
             return *this;
         }
+        #endif
 
         /**
          * @brief Set index buffer
@@ -604,15 +691,17 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
          *
          * Expects an active shader with all uniforms set. See
          * @ref AbstractShaderProgram-rendering-workflow "AbstractShaderProgram documentation"
-         * for more information.
+         * for more information. If @ref instanceCount() is not `1`,
+         * instanced drawing commands are used.
          * @see @fn_gl{EnableVertexAttribArray}, @fn_gl{BindBuffer},
          *      @fn_gl{VertexAttribPointer}, @fn_gl{DisableVertexAttribArray}
          *      or @fn_gl{BindVertexArray} (if @extension{APPLE,vertex_array_object}
-         *      is available), @fn_gl{DrawArrays} or @fn_gl{DrawElements}/@fn_gl{DrawRangeElements}.
+         *      is available), @fn_gl{DrawArrays}/@fn_gl{DrawArraysInstanced}
+         *      or @fn_gl{DrawElements}/@fn_gl{DrawRangeElements}/@fn_gl{DrawElementsInstanced}.
          */
         void draw() {
             #ifndef MAGNUM_TARGET_GLES2
-            drawInternal(0, _vertexCount, _indexOffset, _indexCount, _indexStart, _indexEnd);
+            drawInternal(0, _vertexCount, _indexOffset, _indexCount, _indexStart, _indexEnd, _instanceCount);
             #else
             drawInternal(0, _vertexCount, _indexOffset, _indexCount);
             #endif
@@ -628,6 +717,7 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
             bool normalized;
             GLintptr offset;
             GLsizei stride;
+            GLuint divisor;
         };
 
         #ifndef MAGNUM_TARGET_GLES2
@@ -638,6 +728,7 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
             GLenum type;
             GLintptr offset;
             GLsizei stride;
+            GLuint divisor;
         };
 
         #ifndef MAGNUM_TARGET_GLES
@@ -648,6 +739,7 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
             GLenum type;
             GLintptr offset;
             GLsizei stride;
+            GLuint divisor;
         };
         #endif
         #endif
@@ -665,19 +757,19 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         inline static GLsizei strideOfInterleaved() { return 0; }
 
         /* Adding interleaved vertex attributes */
-        template<UnsignedInt location, class T, class ...U> inline void addVertexBufferInternal(Buffer& buffer, GLintptr offset, GLsizei stride, const AbstractShaderProgram::Attribute<location, T>& attribute, const U&... attributes) {
-            addVertexAttribute(buffer, attribute, offset, stride);
+        template<UnsignedInt location, class T, class ...U> inline void addVertexBufferInternal(Buffer& buffer, GLintptr offset, GLsizei stride, GLuint divisor, const AbstractShaderProgram::Attribute<location, T>& attribute, const U&... attributes) {
+            addVertexAttribute(buffer, attribute, offset, stride, divisor);
 
             /* Add size of this attribute to offset for next attribute */
-            addVertexBufferInternal(buffer, offset+attribute.dataSize(), stride, attributes...);
+            addVertexBufferInternal(buffer, offset+attribute.dataSize(), stride, divisor, attributes...);
         }
-        template<class ...T> inline void addVertexBufferInternal(Buffer& buffer, GLintptr offset, GLsizei stride, GLintptr gap, const T&... attributes) {
+        template<class ...T> inline void addVertexBufferInternal(Buffer& buffer, GLintptr offset, GLsizei stride, GLuint divisor, GLintptr gap, const T&... attributes) {
             /* Add the gap to offset for next attribute */
-            addVertexBufferInternal(buffer, offset+gap, stride, attributes...);
+            addVertexBufferInternal(buffer, offset+gap, stride, divisor, attributes...);
         }
-        inline void addVertexBufferInternal(Buffer&, GLsizei, GLintptr) {}
+        inline void addVertexBufferInternal(Buffer&, GLsizei, GLintptr, GLuint) {}
 
-        template<UnsignedInt location, class T> inline void addVertexAttribute(typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::Type, Float>::value, Buffer&>::type buffer, const AbstractShaderProgram::Attribute<location, T>& attribute, GLintptr offset, GLsizei stride) {
+        template<UnsignedInt location, class T> inline void addVertexAttribute(typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::Type, Float>::value, Buffer&>::type buffer, const AbstractShaderProgram::Attribute<location, T>& attribute, GLintptr offset, GLsizei stride, GLuint divisor) {
             for(UnsignedInt i = 0; i != Implementation::Attribute<T>::vectorCount(); ++i)
                 (this->*attributePointerImplementation)(Attribute{
                     &buffer,
@@ -686,24 +778,26 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
                     GLenum(attribute.dataType()),
                     bool(attribute.dataOptions() & AbstractShaderProgram::Attribute<location, T>::DataOption::Normalized),
                     offset,
-                    stride
+                    stride,
+                    divisor
                 });
         }
 
         #ifndef MAGNUM_TARGET_GLES2
-        template<UnsignedInt location, class T> inline void addVertexAttribute(typename std::enable_if<std::is_integral<typename Implementation::Attribute<T>::Type>::value, Buffer&>::type buffer, const AbstractShaderProgram::Attribute<location, T>& attribute, GLintptr offset, GLsizei stride) {
+        template<UnsignedInt location, class T> inline void addVertexAttribute(typename std::enable_if<std::is_integral<typename Implementation::Attribute<T>::Type>::value, Buffer&>::type buffer, const AbstractShaderProgram::Attribute<location, T>& attribute, GLintptr offset, GLsizei stride, GLuint divisor) {
             (this->*attributeIPointerImplementation)(IntegerAttribute{
                 &buffer,
                 location,
                 GLint(attribute.components()),
                 GLenum(attribute.dataType()),
                 offset,
-                stride
+                stride,
+                divisor
             });
         }
 
         #ifndef MAGNUM_TARGET_GLES
-        template<UnsignedInt location, class T> inline void addVertexAttribute(typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::Type, Double>::value, Buffer&>::type buffer, const AbstractShaderProgram::Attribute<location, T>& attribute, GLintptr offset, GLsizei stride) {
+        template<UnsignedInt location, class T> inline void addVertexAttribute(typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::Type, Double>::value, Buffer&>::type buffer, const AbstractShaderProgram::Attribute<location, T>& attribute, GLintptr offset, GLsizei stride, GLuint divisor) {
             for(UnsignedInt i = 0; i != Implementation::Attribute<T>::vectorCount(); ++i)
                 (this->*attributeLPointerImplementation)(LongAttribute{
                     &buffer,
@@ -711,7 +805,8 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
                     GLint(attribute.components()),
                     GLenum(attribute.dataType()),
                     offset,
-                    stride
+                    stride,
+                    divisor
                 });
         }
         #endif
@@ -728,7 +823,7 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         #endif
 
         #ifndef MAGNUM_TARGET_GLES2
-        void drawInternal(Int firstVertex, Int vertexCount, GLintptr indexOffset, Int indexCount, Int indexStart, Int indexEnd);
+        void drawInternal(Int firstVertex, Int vertexCount, GLintptr indexOffset, Int indexCount, Int indexStart, Int indexEnd, Int instanceCount);
         #else
         void drawInternal(Int firstVertex, Int vertexCount, GLintptr indexOffset, Int indexCount);
         #endif
@@ -789,6 +884,7 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         Int _vertexCount, _indexCount;
         #ifndef MAGNUM_TARGET_GLES2
         UnsignedInt _indexStart, _indexEnd;
+        Int _instanceCount;
         #endif
         GLintptr _indexOffset;
         IndexType _indexType;
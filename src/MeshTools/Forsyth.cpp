@@ -0,0 +1,164 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Forsyth.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Tipsify.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+namespace {
+
+/* Scoring constants from the paper */
+constexpr Float CacheDecayPower = 1.5f;
+constexpr Float LastTriangleScore = 0.75f;
+constexpr Float ValenceBoostScale = 2.0f;
+constexpr Float ValenceBoostPower = 0.5f;
+
+}
+
+void Forsyth::operator()(std::size_t cacheSize) {
+    /* Neighboring triangles for each vertex, per-vertex live triangle count.
+       Live triangles of i-th vertex are kept at the beginning of its
+       neighbor range, emitted triangles are swapped past the end. */
+    std::vector<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Tipsify(indices, vertexCount).buildAdjacency(liveTriangleCount, neighborOffset, neighbors);
+
+    /* Vertex score for given cache position. Vertices of the last emitted
+       triangle have fixed score so the algorithm doesn't prefer continuing
+       on the same edge. */
+    std::vector<Float> cacheScore(cacheSize);
+    for(std::size_t i = 0; i != cacheSize; ++i) {
+        if(i < 3) cacheScore[i] = LastTriangleScore;
+        else cacheScore[i] = std::pow(1.0f - Float(i - 3)/(cacheSize - 3), CacheDecayPower);
+    }
+
+    /* Vertex score boost for given live triangle count, vertices with only a
+       few remaining triangles are preferred so they don't become isolated */
+    const UnsignedInt maxValence = liveTriangleCount.empty() ? 0 :
+        *std::max_element(liveTriangleCount.begin(), liveTriangleCount.end());
+    std::vector<Float> valenceScore(maxValence+1);
+    for(UnsignedInt i = 1; i <= maxValence; ++i)
+        valenceScore[i] = ValenceBoostScale*std::pow(Float(i), -ValenceBoostPower);
+
+    /* Per-vertex cache position (-1 if not in cache) */
+    std::vector<Int> cachePosition(vertexCount, -1);
+    auto vertexScore = [&](UnsignedInt v) -> Float {
+        if(!liveTriangleCount[v]) return -1.0f;
+        const Int position = cachePosition[v];
+        return valenceScore[liveTriangleCount[v]] + (position == -1 ? 0.0f : cacheScore[position]);
+    };
+
+    /* Initial vertex and triangle scores */
+    const std::size_t triangleCount = indices.size()/3;
+    std::vector<Float> vertexScores(vertexCount);
+    for(UnsignedInt v = 0; v != vertexCount; ++v)
+        vertexScores[v] = vertexScore(v);
+    std::vector<Float> triangleScores(triangleCount);
+    for(std::size_t t = 0; t != triangleCount; ++t)
+        triangleScores[t] = vertexScores[indices[t*3]] + vertexScores[indices[t*3+1]] + vertexScores[indices[t*3+2]];
+
+    /* Simulated LRU cache, with space for vertices of one more triangle */
+    std::vector<UnsignedInt> cache, newCache;
+    cache.reserve(cacheSize+3);
+    newCache.reserve(cacheSize+3);
+
+    /* Per-triangle emitted flag, output index buffer */
+    std::vector<UnsignedByte> emitted(triangleCount);
+    std::vector<UnsignedInt> outputIndices;
+    outputIndices.reserve(indices.size());
+
+    /* Cursor for finding next triangle when there isn't any in cache */
+    std::size_t cursor = 0;
+    UnsignedInt best = triangleCount ? UnsignedInt(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin()) : 0xFFFFFFFFu;
+    while(best != 0xFFFFFFFFu) {
+        emitted[best] = true;
+
+        /* Emit the triangle, remove it from live triangles of its vertices
+           and put the vertices on the front of the cache */
+        newCache.clear();
+        for(UnsignedInt i = 0; i != 3; ++i) {
+            const UnsignedInt v = indices[best*3+i];
+            outputIndices.push_back(v);
+
+            UnsignedInt* const begin = neighbors.data() + neighborOffset[v];
+            UnsignedInt* const last = begin + --liveTriangleCount[v];
+            std::swap(*std::find(begin, last+1, best), *last);
+
+            if(std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+                newCache.push_back(v);
+        }
+        const std::size_t emittedVertexCount = newCache.size();
+
+        /* Append rest of the cache, vertices falling out of the cache get
+           their position reset */
+        for(UnsignedInt v: cache) {
+            if(std::find(newCache.begin(), newCache.begin()+emittedVertexCount, v) != newCache.begin()+emittedVertexCount) continue;
+            newCache.push_back(v);
+        }
+        for(std::size_t i = cacheSize; i < newCache.size(); ++i)
+            cachePosition[newCache[i]] = -1;
+        if(newCache.size() > cacheSize) newCache.resize(cacheSize);
+        for(std::size_t i = 0; i != newCache.size(); ++i)
+            cachePosition[newCache[i]] = i;
+
+        /* Update scores of vertices which were in cache, propagate the
+           difference to their live triangles */
+        auto updateScore = [&](UnsignedInt v) {
+            const Float score = vertexScore(v);
+            const Float difference = score - vertexScores[v];
+            vertexScores[v] = score;
+            for(UnsignedInt i = neighborOffset[v], end = i + liveTriangleCount[v]; i != end; ++i)
+                triangleScores[neighbors[i]] += difference;
+        };
+        for(UnsignedInt v: cache) if(cachePosition[v] == -1) updateScore(v);
+        std::swap(cache, newCache);
+        for(UnsignedInt v: cache) updateScore(v);
+
+        /* Next is best live triangle touching vertices in cache */
+        best = 0xFFFFFFFFu;
+        Float bestScore = -1.0f;
+        for(UnsignedInt v: cache)
+            for(UnsignedInt i = neighborOffset[v], end = i + liveTriangleCount[v]; i != end; ++i) {
+                const UnsignedInt t = neighbors[i];
+                if(triangleScores[t] <= bestScore) continue;
+                best = t;
+                bestScore = triangleScores[t];
+            }
+
+        /* If there is none, take next arbitrary live triangle */
+        if(best == 0xFFFFFFFFu) {
+            while(cursor != triangleCount && emitted[cursor]) ++cursor;
+            if(cursor != triangleCount) best = cursor;
+        }
+    }
+
+    /* Swap original index buffer with optimized */
+    std::swap(indices, outputIndices);
+}
+
+}}}
@@ -0,0 +1,77 @@
+#ifndef Magnum_MeshTools_Forsyth_h
+#define Magnum_MeshTools_Forsyth_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::MeshTools::forsyth()
+ */
+
+#include <vector>
+
+#include "Types.h"
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
+
+class MAGNUM_MESHTOOLS_EXPORT Forsyth {
+    public:
+        Forsyth(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount): indices(indices), vertexCount(vertexCount) {}
+
+        void operator()(std::size_t cacheSize);
+
+    private:
+        std::vector<UnsignedInt>& indices;
+        const UnsignedInt vertexCount;
+};
+
+}
+
+/**
+@brief Optimize the mesh for vertex cache using Forsyth's algorithm
+@param[in,out] indices  Indices array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+
+Optimizes the mesh for vertex-bound applications by rearranging its index
+array for beter usage of post-transform vertex cache. Each vertex is scored
+based on its position in simulated LRU cache and count of not yet emitted
+triangles, the triangle with highest sum of vertex scores is emitted next.
+Runs in linear time, similarly to tipsify(), but is a few times slower. The
+output is less dependent on exact cache size and type, which of the two
+algorithms gives better result depends on the mesh and target hardware, use
+vertexCacheStatistics() to compare them on particular mesh. Algorithm used: *Tom Forsyth - Linear-Speed Vertex Cache Optimisation,
+2006, http://home.comcast.net/~tom_forsyth/papers/fast_vert_cache_opt.html*.
+Winding of the triangles is preserved.
+@see tipsify()
+*/
+inline void forsyth(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize) {
+    Implementation::Forsyth(indices, vertexCount)(cacheSize);
+}
+
+}}
+
+#endif
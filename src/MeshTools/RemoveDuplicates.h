@@ -28,10 +28,10 @@
  * @brief Function Magnum::MeshTools::removeDuplicates()
  */
 
+#include <algorithm>
 #include <limits>
-#include <unordered_map>
+#include <type_traits>
 #include <vector>
-#include <Utility/MurmurHash2.h>
 
 #include "Math/Functions.h"
 #include "Magnum.h"
@@ -42,24 +42,76 @@ namespace Implementation {
 
 template<class Vertex, std::size_t vertexSize = Vertex::Size> class RemoveDuplicates {
     public:
+        typedef typename Vertex::Type Type;
+        typedef Math::Vector<vertexSize, std::size_t> Cell;
+
         RemoveDuplicates(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices): indices(indices), vertices(vertices) {}
 
-        void operator()(typename Vertex::Type epsilon = Math::TypeTraits<typename Vertex::Type>::epsilon());
+        void operator()(Type epsilon = Math::TypeTraits<Type>::epsilon());
+
+    protected:
+        constexpr static UnsignedInt empty() { return ~UnsignedInt(0); }
 
-    private:
-        class IndexHash {
+        /* Open-addressing hash table with linear probing, each slot is either
+           empty or contains index of an unique vertex */
+        class HashTable {
             public:
-                std::size_t operator()(const Math::Vector<vertexSize, std::size_t>& data) const {
-                    return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
+                explicit HashTable(std::size_t size) {
+                    std::size_t capacity = 16;
+                    while(capacity < 2*size) capacity <<= 1;
+                    slots.assign(capacity, empty());
                 }
-        };
 
-        struct HashedVertex {
-            UnsignedInt oldIndex, newIndex;
+                /* Returns either empty slot or slot with index for which
+                   `equal(index)` returns true */
+                template<class Equal> UnsignedInt& find(std::size_t hash, Equal equal) {
+                    const std::size_t mask = slots.size()-1;
+                    for(std::size_t i = hash & mask; ; i = (i + 1) & mask)
+                        if(slots[i] == empty() || equal(slots[i])) return slots[i];
+                }
 
-            HashedVertex(UnsignedInt oldIndex, UnsignedInt newIndex): oldIndex(oldIndex), newIndex(newIndex) {}
+            private:
+                std::vector<UnsignedInt> slots;
         };
 
+        template<class T> static std::size_t hash(const T& data) {
+            std::size_t h = 0;
+            for(std::size_t i = 0; i != vertexSize; ++i)
+                h = (h ^ std::size_t(data[i]))*std::size_t(0x9e3779b97f4a7c15ull);
+            return h ^ (h >> (sizeof(std::size_t)*4));
+        }
+
+        static bool equal(const Vertex& a, const Vertex& b) {
+            for(std::size_t i = 0; i != vertexSize; ++i)
+                if(a[i] != b[i]) return false;
+            return true;
+        }
+
+        static bool near(const Vertex& a, const Vertex& b, Type epsilon) {
+            for(std::size_t i = 0; i != vertexSize; ++i)
+                if(!((a[i] > b[i] ? a[i] - b[i] : b[i] - a[i]) < epsilon)) return false;
+            return true;
+        }
+
+        /* Cells have size of two epsilons, so for each vertex only the nearer
+           neighbor cell in each direction needs to be searched. The neighbor
+           is equal to the vertex cell if there is no cell in that direction. */
+        static Cell cell(const Vertex& v, const Vertex& min, Double cellScale, Cell* neighbor = nullptr) {
+            Cell c;
+            for(std::size_t i = 0; i != vertexSize; ++i) {
+                const Double position = Double(v[i] - min[i])*cellScale;
+                c[i] = std::size_t(position);
+                if(neighbor) (*neighbor)[i] = position - Double(c[i]) >= 0.5 ?
+                    c[i] + 1 : (c[i] ? c[i] - 1 : c[i]);
+            }
+            return c;
+        }
+
+        template<class Find> void remove(Find find);
+        void removeExact();
+        Vertex bounds(Type& epsilon) const;
+        void removeFuzzy(Type epsilon);
+
         std::vector<UnsignedInt>& indices;
         std::vector<Vertex>& vertices;
 };
@@ -77,10 +129,21 @@ template<class Vertex, std::size_t vertexSize = Vertex::Size> class RemoveDuplic
 @param[in] epsilon      Epsilon value, vertices nearer than this distance will
     be melt together.
 
-Removes duplicate vertices from the mesh.
-@see duplicate()
+Removes duplicate vertices from the mesh. Each vertex is melt into the first
+(in order of index array) unique vertex which differs from it less than
+@p epsilon in all important fields, or it becomes an unique vertex itself.
+Thus no two resulting vertices are nearer than @p epsilon to each other.
+Resulting vertices are ordered by their first occurence in index array,
+vertices not referenced by any index are removed.
+
+The vertices are hashed into uniform grid with cell size of two epsilons in
+single pass, for each vertex at most `2^vertexSize` cells are searched. For
+integral vertex types and @p epsilon not larger than `1` only exactly equal
+vertices are melt together, which is done using single hash lookup per
+vertex. Each vertex is processed only once, regardless of how many times it
+is referenced by index array.
+@see duplicate(), removeDuplicatesParallel()
 
-@todo Different (no cycle) implementation for integral vertices
 @todo Interpolate vertices, not collapse them to first in the cell
 @todo Ability to specify other attributes for interpolation
 */
@@ -90,9 +153,46 @@ template<class Vertex, std::size_t vertexSize = Vertex::Size> inline void remove
 
 namespace Implementation {
 
-template<class Vertex, std::size_t vertexSize> void RemoveDuplicates<Vertex, vertexSize>::operator()(typename Vertex::Type epsilon) {
+template<class Vertex, std::size_t vertexSize> void RemoveDuplicates<Vertex, vertexSize>::operator()(Type epsilon) {
     if(indices.empty()) return;
 
+    if(std::is_integral<Type>::value && epsilon <= Type(1))
+        removeExact();
+    else removeFuzzy(epsilon);
+}
+
+template<class Vertex, std::size_t vertexSize> template<class Find> void RemoveDuplicates<Vertex, vertexSize>::remove(Find find) {
+    /* New index for each original vertex, computed on first occurence */
+    std::vector<UnsignedInt> newIndices(vertices.size(), empty());
+    std::vector<Vertex> uniqueVertices;
+
+    for(UnsignedInt& index: indices) {
+        UnsignedInt& newIndex = newIndices[index];
+        if(newIndex == empty()) newIndex = find(vertices[index], uniqueVertices);
+        index = newIndex;
+    }
+
+    std::swap(uniqueVertices, vertices);
+}
+
+template<class Vertex, std::size_t vertexSize> void RemoveDuplicates<Vertex, vertexSize>::removeExact() {
+    HashTable table(vertices.size());
+
+    remove([&table](const Vertex& v, std::vector<Vertex>& uniqueVertices) {
+        UnsignedInt& slot = table.find(hash(v), [&](UnsignedInt i) {
+            return equal(uniqueVertices[i], v);
+        });
+
+        if(slot == empty()) {
+            slot = uniqueVertices.size();
+            uniqueVertices.push_back(v);
+        }
+
+        return slot;
+    });
+}
+
+template<class Vertex, std::size_t vertexSize> Vertex RemoveDuplicates<Vertex, vertexSize>::bounds(Type& epsilon) const {
     /* Get mesh bounds */
     Vertex min = vertices[0], max = vertices[0];
     for(const auto& v: vertices) {
@@ -102,53 +202,55 @@ template<class Vertex, std::size_t vertexSize> void RemoveDuplicates<Vertex, ver
 
     /* Make epsilon so large that std::size_t can index all vertices inside
        mesh bounds. */
-    epsilon = Math::max(epsilon, static_cast<typename Vertex::Type>((max-min).max()/std::numeric_limits<std::size_t>::max()));
-
-    /* First go with original vertex coordinates, then move them by
-       epsilon/2 in each direction. */
-    Vertex moved;
-    for(std::size_t moving = 0; moving <= vertexSize; ++moving) {
-
-        /* Under each index is pointer to face which contains given vertex
-           and index of vertex in the face. */
-        std::unordered_map<Math::Vector<vertexSize, std::size_t>, HashedVertex, IndexHash> table;
-
-        /* Reserve space for all vertices */
-        table.reserve(vertices.size());
-
-        /* Go through all faces' vertices */
-        for(auto it = indices.begin(); it != indices.end(); ++it) {
-            /* Index of a vertex in vertexSize-dimensional table */
-            std::size_t index[vertexSize];
-            for(std::size_t ii = 0; ii != vertexSize; ++ii)
-                index[ii] = std::size_t((vertices[*it][ii]+moved[ii]-min[ii])/epsilon);
-
-            /* Try inserting the vertex into table, if it already
-               exists, change vertex pointer of the face to already
-               existing vertex */
-            HashedVertex v(*it, table.size());
-            #ifndef CORRADE_GCC46_COMPATIBILITY
-            auto result = table.emplace(Math::Vector<vertexSize, std::size_t>::from(index), v);
-            #else
-            auto result = table.insert({Math::Vector<vertexSize, std::size_t>::from(index), v});
-            #endif
-            *it = result.first->second.newIndex;
+    epsilon = Math::max(epsilon, static_cast<Type>((max-min).max()/std::numeric_limits<std::size_t>::max()));
+    return min;
+}
+
+template<class Vertex, std::size_t vertexSize> void RemoveDuplicates<Vertex, vertexSize>::removeFuzzy(Type epsilon) {
+    const Vertex min = bounds(epsilon);
+    const Double cellScale = 1.0/(2*Double(epsilon));
+
+    /* Table contains first unique vertex in each cell, other unique vertices
+       in the same cell are linked using next */
+    HashTable table(vertices.size());
+    std::vector<UnsignedInt> next;
+
+    remove([&](const Vertex& v, std::vector<Vertex>& uniqueVertices) {
+        Cell neighbor;
+        const Cell own = cell(v, min, cellScale, &neighbor);
+
+        /* Search own cell and all combinations of neighbor cells for the
+           first vertex near enough */
+        UnsignedInt found = empty();
+        UnsignedInt* ownSlot = nullptr;
+        for(std::size_t combination = 0; combination != (1 << vertexSize); ++combination) {
+            Cell c = own;
+            bool exists = true;
+            for(std::size_t i = 0; i != vertexSize && exists; ++i) if(combination & (1 << i)) {
+                exists = neighbor[i] != own[i];
+                c[i] = neighbor[i];
+            }
+            if(!exists) continue;
+
+            UnsignedInt& slot = table.find(hash(c), [&](UnsignedInt i) {
+                return cell(uniqueVertices[i], min, cellScale) == c;
+            });
+            if(!combination) ownSlot = &slot;
+
+            for(UnsignedInt i = slot; i != empty(); i = next[i])
+                if(i < found && near(uniqueVertices[i], v, epsilon)) found = i;
         }
 
-        /* Shrink vertices array */
-        std::vector<Vertex> newVertices(table.size());
-        for(auto it = table.cbegin(); it != table.cend(); ++it)
-            newVertices[it->second.newIndex] = vertices[it->second.oldIndex];
-        std::swap(newVertices, vertices);
+        if(found != empty()) return found;
 
-        /* Move vertex coordinates by epsilon/2 in next direction */
-        if(moving != Vertex::Size) {
-            moved = Vertex();
-            moved[moving] = epsilon/2;
-        }
-    }
+        /* Not found, add new unique vertex to the cell */
+        found = uniqueVertices.size();
+        uniqueVertices.push_back(v);
+        next.push_back(*ownSlot);
+        *ownSlot = found;
+        return found;
+    });
 }
-
 }
 
 }}
@@ -0,0 +1,327 @@
+#ifndef Magnum_MeshTools_RemoveDuplicatesParallel_h
+#define Magnum_MeshTools_RemoveDuplicatesParallel_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::MeshTools::removeDuplicatesParallel()
+ */
+
+#include <functional>
+#include <queue>
+#include <thread>
+
+#include "MeshTools/RemoveDuplicates.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
+
+template<class Vertex, std::size_t vertexSize = Vertex::Size> class RemoveDuplicatesParallel: public RemoveDuplicates<Vertex, vertexSize> {
+    public:
+        typedef typename RemoveDuplicates<Vertex, vertexSize>::Type Type;
+        typedef typename RemoveDuplicates<Vertex, vertexSize>::Cell Cell;
+
+        RemoveDuplicatesParallel(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices): RemoveDuplicates<Vertex, vertexSize>(indices, vertices) {}
+
+        void operator()(Type epsilon, UnsignedInt threadCount);
+
+    private:
+        typedef typename RemoveDuplicates<Vertex, vertexSize>::HashTable HashTable;
+
+        using RemoveDuplicates<Vertex, vertexSize>::empty;
+        using RemoveDuplicates<Vertex, vertexSize>::hash;
+        using RemoveDuplicates<Vertex, vertexSize>::near;
+        using RemoveDuplicates<Vertex, vertexSize>::cell;
+        using RemoveDuplicates<Vertex, vertexSize>::removeExact;
+        using RemoveDuplicates<Vertex, vertexSize>::bounds;
+        using RemoveDuplicates<Vertex, vertexSize>::removeFuzzy;
+        using RemoveDuplicates<Vertex, vertexSize>::indices;
+        using RemoveDuplicates<Vertex, vertexSize>::vertices;
+
+        /* Vertices of one spatial partition with
+           grid cells containing chains of unique vertices and chains of all
+           vertices. Vertices are identified by their rank, i.e. order of
+           first occurence in index array. */
+        struct Slab {
+            explicit Slab(std::size_t size): table(size) {}
+
+            HashTable table;
+            std::vector<UnsignedInt> ranks, uniqueHead, allHead, seams;
+        };
+
+        /* Calls `function(begin, end)` for at most `threadCount` consecutive
+           chunks of range [0, count), each in separate thread */
+        template<class Function> static void parallelFor(UnsignedInt threadCount, std::size_t count, Function function) {
+            const std::size_t chunkSize = (count + threadCount - 1)/threadCount;
+            std::vector<std::thread> threads;
+            for(std::size_t begin = chunkSize; begin < count; begin += chunkSize)
+                threads.emplace_back(function, begin, std::min(begin + chunkSize, count));
+            if(count) function(0, std::min(chunkSize, count));
+            for(std::thread& t: threads) t.join();
+        }
+
+        void removeFuzzyParallel(Type epsilon, UnsignedInt threadCount);
+};
+
+}
+
+/**
+@brief %Remove duplicate vertices from the mesh using multiple threads
+@tparam Vertex          Vertex data type
+@tparam vertexSize      How many initial vertex fields are important
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param[in] epsilon      Epsilon value, vertices nearer than this distance will
+    be melt together.
+@param[in] threadCount  Count of threads used for melting vertices with
+    nonzero epsilon
+
+Produces exactly the same result as @ref removeDuplicates(), see its
+documentation for more information. The vertices are partitioned into spatial
+slabs along first vertex field, which are processed in parallel. Vertices near
+slab boundaries are then resolved in order of first occurence, so the result
+doesn't depend on the thread count. As threads are created on every call,
+it's worth only for very large meshes. Exact melting of integral vertices is
+always done on single thread.
+
+Unlike the rest of the library this function uses `std::thread`, thus the
+application must link to the system thread library (e.g.
+`${CMAKE_THREAD_LIBS_INIT}` from CMake `Threads` package) when using it.
+*/
+template<class Vertex, std::size_t vertexSize = Vertex::Size> inline void removeDuplicatesParallel(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, typename Vertex::Type epsilon, UnsignedInt threadCount) {
+    Implementation::RemoveDuplicatesParallel<Vertex, vertexSize>(indices, vertices)(epsilon, threadCount);
+}
+
+namespace Implementation {
+
+template<class Vertex, std::size_t vertexSize> void RemoveDuplicatesParallel<Vertex, vertexSize>::operator()(Type epsilon, const UnsignedInt threadCount) {
+    if(indices.empty()) return;
+
+    if(std::is_integral<Type>::value && epsilon <= Type(1))
+        removeExact();
+    else if(threadCount > 1)
+        removeFuzzyParallel(epsilon, threadCount);
+    else removeFuzzy(epsilon);
+}
+
+template<class Vertex, std::size_t vertexSize> void RemoveDuplicatesParallel<Vertex, vertexSize>::removeFuzzyParallel(Type epsilon, const UnsignedInt threadCount) {
+    const Vertex min = bounds(epsilon);
+    const Double cellScale = 1.0/(2*Double(epsilon));
+
+    /* Order referenced vertices by first occurence, which is the order in
+       which they are processed in the serial variant */
+    std::vector<UnsignedInt> rankOf(vertices.size(), empty());
+    std::vector<UnsignedInt> order;
+    for(UnsignedInt index: indices) if(rankOf[index] == empty()) {
+        rankOf[index] = order.size();
+        order.push_back(index);
+    }
+    const auto vertex = [&](UnsignedInt rank) -> const Vertex& {
+        return vertices[order[rank]];
+    };
+
+    /* Split the cells along first vertex field to slabs with roughly the
+       same vertex count. Slab i contains cells from boundaries[i-1] to
+       boundaries[i]. */
+    std::vector<std::size_t> column(order.size());
+    parallelFor(threadCount, order.size(), [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            column[i] = std::size_t(Double(vertex(i)[0] - min[0])*cellScale);
+    });
+    std::vector<std::size_t> boundaries;
+    {
+        std::vector<std::size_t> sorted(column);
+        for(std::size_t i = 1; i != threadCount; ++i) {
+            auto nth = sorted.begin() + i*sorted.size()/threadCount;
+            std::nth_element(sorted.begin(), nth, sorted.end());
+            boundaries.push_back(*nth);
+        }
+        std::sort(boundaries.begin(), boundaries.end());
+    }
+    const auto slabOf = [&boundaries](std::size_t column) -> std::size_t {
+        return std::upper_bound(boundaries.begin(), boundaries.end(), column) - boundaries.begin();
+    };
+
+    /* Distribute the vertices to slabs, keeping them in order */
+    std::vector<Slab> slabs;
+    {
+        std::vector<std::size_t> slabSizes(threadCount);
+        for(std::size_t c: column) ++slabSizes[slabOf(c)];
+        for(std::size_t size: slabSizes) {
+            slabs.emplace_back(size);
+            slabs.back().ranks.reserve(size);
+        }
+        for(std::size_t i = 0; i != column.size(); ++i)
+            slabs[slabOf(column[i])].ranks.push_back(i);
+    }
+
+    /* Rank of unique vertex to which each vertex is melt, chains of unique
+       and all vertices in the same cell */
+    std::vector<UnsignedInt> target(order.size()), nextUnique(order.size(), empty()), nextAll(order.size());
+
+    /* Returns slot with index of cell record in given slab */
+    const auto cellSlot = [&](Slab& slab, const Cell& c) -> UnsignedInt& {
+        return slab.table.find(hash(c), [&](UnsignedInt i) {
+            return cell(vertex(slab.allHead[i]), min, cellScale) == c;
+        });
+    };
+
+    /* Process each slab separately, ignoring all cells in other slabs. Each
+       thread accesses only ranks in its own slab. */
+    parallelFor(threadCount, slabs.size(), [&](std::size_t begin, std::size_t end) {
+        for(std::size_t s = begin; s != end; ++s) {
+            Slab& slab = slabs[s];
+            for(UnsignedInt rank: slab.ranks) {
+                Cell neighbor;
+                const Cell own = cell(vertex(rank), min, cellScale, &neighbor);
+
+                /* Add the vertex to chain of all vertices in the cell */
+                UnsignedInt& ownSlot = cellSlot(slab, own);
+                if(ownSlot == empty()) {
+                    ownSlot = slab.allHead.size();
+                    slab.allHead.push_back(empty());
+                    slab.uniqueHead.push_back(empty());
+                }
+                nextAll[rank] = slab.allHead[ownSlot];
+                slab.allHead[ownSlot] = rank;
+
+                /* Search only cells in this slab, vertices which have any
+                   other cell to search are resolved afterwards */
+                if(neighbor[0] != own[0] && slabOf(neighbor[0]) != s)
+                    slab.seams.push_back(rank);
+
+                UnsignedInt found = empty();
+                for(std::size_t combination = 0; combination != (1 << vertexSize); ++combination) {
+                    Cell c = own;
+                    bool exists = true;
+                    for(std::size_t i = 0; i != vertexSize && exists; ++i) if(combination & (1 << i)) {
+                        exists = neighbor[i] != own[i];
+                        c[i] = neighbor[i];
+                    }
+                    if(!exists || (c[0] != own[0] && slabOf(c[0]) != s)) continue;
+
+                    const UnsignedInt slot = cellSlot(slab, c);
+                    if(slot == empty()) continue;
+                    for(UnsignedInt i = slab.uniqueHead[slot]; i != empty(); i = nextUnique[i])
+                        if(i < found && near(vertex(i), vertex(rank), epsilon)) found = i;
+                }
+
+                if(found == empty()) {
+                    found = rank;
+                    nextUnique[rank] = slab.uniqueHead[ownSlot];
+                    slab.uniqueHead[ownSlot] = rank;
+                }
+                target[rank] = found;
+            }
+        }
+    });
+
+    /* Calls `function(rank, slab, slot)` for all cells near given vertex,
+       including cells in other slabs */
+    const auto forNearCells = [&](UnsignedInt rank, const std::function<void(Slab&, UnsignedInt)>& function) {
+        Cell neighbor;
+        const Cell own = cell(vertex(rank), min, cellScale, &neighbor);
+        for(std::size_t combination = 0; combination != (1 << vertexSize); ++combination) {
+            Cell c = own;
+            bool exists = true;
+            for(std::size_t i = 0; i != vertexSize && exists; ++i) if(combination & (1 << i)) {
+                exists = neighbor[i] != own[i];
+                c[i] = neighbor[i];
+            }
+            if(!exists) continue;
+
+            Slab& slab = slabs[slabOf(c[0])];
+            const UnsignedInt slot = cellSlot(slab, c);
+            if(slot != empty()) function(slab, slot);
+        }
+    };
+
+    /* Resolve vertices near slab boundaries in order of first occurence.
+       Whether a vertex is unique depends only on vertices with lower rank,
+       thus when a vertex is taken from the queue, all vertices it depends on
+       are already final. If a vertex changes uniqueness, all nearby vertices
+       with higher rank are queued for resolving too. */
+    std::priority_queue<UnsignedInt, std::vector<UnsignedInt>, std::greater<UnsignedInt>> queue;
+    for(const Slab& slab: slabs)
+        for(UnsignedInt rank: slab.seams) queue.push(rank);
+    UnsignedInt previous = empty();
+    while(!queue.empty()) {
+        const UnsignedInt rank = queue.top();
+        queue.pop();
+        if(rank == previous) continue;
+        previous = rank;
+
+        UnsignedInt found = empty();
+        forNearCells(rank, [&](Slab& slab, UnsignedInt slot) {
+            for(UnsignedInt i = slab.uniqueHead[slot]; i != empty(); i = nextUnique[i])
+                if(i < found && i < rank && near(vertex(i), vertex(rank), epsilon)) found = i;
+        });
+        if(found == empty()) found = rank;
+
+        const bool wasUnique = target[rank] == rank;
+        target[rank] = found;
+        if(wasUnique == (found == rank)) continue;
+
+        /* Update chain of unique vertices in the cell */
+        Slab& slab = slabs[slabOf(column[rank])];
+        UnsignedInt& head = slab.uniqueHead[cellSlot(slab, cell(vertex(rank), min, cellScale))];
+        if(!wasUnique) {
+            nextUnique[rank] = head;
+            head = rank;
+        } else {
+            UnsignedInt* i = &head;
+            while(*i != rank) i = &nextUnique[*i];
+            *i = nextUnique[rank];
+        }
+
+        forNearCells(rank, [&](Slab& slab, UnsignedInt slot) {
+            for(UnsignedInt i = slab.allHead[slot]; i != empty(); i = nextAll[i])
+                if(i > rank && near(vertex(i), vertex(rank), epsilon)) queue.push(i);
+        });
+    }
+
+    /* Unique vertices are ordered by rank, melt vertices always have unique
+       vertex with lower rank */
+    std::vector<Vertex> uniqueVertices;
+    for(UnsignedInt rank = 0; rank != order.size(); ++rank) {
+        if(target[rank] == rank) {
+            target[rank] = uniqueVertices.size();
+            uniqueVertices.push_back(vertex(rank));
+        } else target[rank] = target[target[rank]];
+    }
+
+    parallelFor(threadCount, indices.size(), [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            indices[i] = target[rankOf[indices[i]]];
+    });
+
+    std::swap(uniqueVertices, vertices);
+}
+
+}
+
+}}
+
+#endif
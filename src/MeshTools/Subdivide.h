@@ -25,23 +25,78 @@
 */
 
 /** @file
- * @brief Function Magnum::MeshTools::subdivide()
+ * @brief Function Magnum::MeshTools::subdivide(), enum Magnum::MeshTools::SubdivideMode
  */
 
+#include <utility>
 #include <vector>
 #include <Utility/Debug.h>
 
+#include "Magnum.h"
+
 namespace Magnum { namespace MeshTools {
 
+/**
+@brief Subdivision mode
+
+@see subdivide()
+*/
+enum class SubdivideMode: UnsignedByte {
+    /**
+     * New vertices are created for each face separately, thus vertices on
+     * edges shared by two faces are duplicated and need to be removed using
+     * removeDuplicates() afterwards.
+     */
+    Separate,
+
+    /**
+     * Vertex for each edge is created only once and shared by all faces
+     * having given edge in common.
+     */
+    SharedEdges
+};
+
 namespace Implementation {
 
 template<class Vertex, class Interpolator> class Subdivide {
     public:
         Subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices): indices(indices), vertices(vertices) {}
 
-        void operator()(Interpolator interpolator);
+        void operator()(Interpolator interpolator, SubdivideMode mode, UnsignedInt levels);
 
     private:
+        /* Open-addressing hash table mapping edges to their vertices */
+        class EdgeTable {
+            public:
+                explicit EdgeTable(std::size_t size) {
+                    std::size_t capacity = 16;
+                    while(capacity < 2*size) capacity <<= 1;
+                    keys.assign(capacity, ~UnsignedLong(0));
+                    values.resize(capacity);
+                }
+
+                /* Returns reference to vertex index for given edge and
+                   `true`, if the edge was not in the table yet */
+                std::pair<UnsignedInt*, bool> insert(UnsignedInt a, UnsignedInt b) {
+                    const UnsignedLong key = a < b ? (UnsignedLong(a) << 32)|b : (UnsignedLong(b) << 32)|a;
+                    const std::size_t mask = keys.size()-1;
+                    UnsignedLong hash = key*0x9e3779b97f4a7c15ull;
+                    for(std::size_t i = std::size_t(hash ^ (hash >> 32)) & mask; ; i = (i + 1) & mask) {
+                        if(keys[i] == key) return {&values[i], false};
+                        if(keys[i] == ~UnsignedLong(0)) {
+                            keys[i] = key;
+                            return {&values[i], true};
+                        }
+                    }
+                }
+
+            private:
+                std::vector<UnsignedLong> keys;
+                std::vector<UnsignedInt> values;
+        };
+
+        void subdivide(Interpolator interpolator, SubdivideMode mode);
+
         std::vector<UnsignedInt>& indices;
         std::vector<Vertex>& vertices;
 
@@ -67,28 +122,60 @@ template<class Vertex, class Interpolator> class Subdivide {
 @param[in,out] vertices Vertex array to operate on
 @param interpolator     Functor or function pointer which interpolates
     two adjacent vertices: `Vertex interpolator(Vertex a, Vertex b)`
-
-Goes through all triangle faces and subdivides them into four new. Removing
-duplicate vertices in the mesh is up to user.
+@param mode             Subdivision mode
+@param levels           Count of subdivision levels
+
+Goes through all triangle faces and subdivides them into four new, repeated
+@p levels times. Space for resulting indices and vertices is reserved up
+front for all levels. With @ref SubdivideMode::Separate removing duplicate
+vertices in the mesh is up to user, with @ref SubdivideMode::SharedEdges new
+vertex for each edge is created only once, so for mesh without duplicate
+vertices the result doesn't contain any duplicates either. In that case the
+interpolator is called only for the first face containing given edge, thus
+it should not depend on order of its parameters.
 */
-template<class Vertex, class Interpolator> inline void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
-    Implementation::Subdivide<Vertex, Interpolator>(indices, vertices)(interpolator);
+template<class Vertex, class Interpolator> inline void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator, SubdivideMode mode = SubdivideMode::Separate, UnsignedInt levels = 1) {
+    Implementation::Subdivide<Vertex, Interpolator>(indices, vertices)(interpolator, mode, levels);
 }
 
 namespace Implementation {
 
-template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::operator()(Interpolator interpolator) {
+template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::operator()(Interpolator interpolator, const SubdivideMode mode, const UnsignedInt levels) {
     CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivide(): index count is not divisible by 3!", );
 
+    /* Each level makes four faces from one. Separate mode adds three
+       vertices per face, shared mode one vertex per edge, i.e. 3/2 vertices
+       per face in closed mesh. */
+    std::size_t multiplier = 1;
+    for(UnsignedInt i = 0; i != levels; ++i) multiplier *= 4;
+    const std::size_t faceCount = indices.size()/3;
+    indices.reserve(indices.size()*multiplier);
+    vertices.reserve(vertices.size() + (mode == SubdivideMode::Separate ?
+        faceCount*(multiplier - 1) : faceCount*(multiplier - 1)/2));
+
+    for(UnsignedInt i = 0; i != levels; ++i)
+        subdivide(interpolator, mode);
+}
+
+template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::subdivide(Interpolator interpolator, const SubdivideMode mode) {
     std::size_t indexCount = indices.size();
-    indices.reserve(indices.size()*4);
+
+    /* Table of already subdivided edges, there is at most one edge for each
+       index */
+    EdgeTable edges(mode == SubdivideMode::SharedEdges ? indexCount : 0);
 
     /* Subdivide each face to four new */
     for(std::size_t i = 0; i != indexCount; i += 3) {
         /* Interpolate each side */
         UnsignedInt newVertices[3];
-        for(int j = 0; j != 3; ++j)
-            newVertices[j] = addVertex(interpolator(vertices[indices[i+j]], vertices[indices[i+(j+1)%3]]));
+        for(int j = 0; j != 3; ++j) {
+            const UnsignedInt a = indices[i+j], b = indices[i+(j+1)%3];
+            if(mode == SubdivideMode::SharedEdges) {
+                const std::pair<UnsignedInt*, bool> edge = edges.insert(a, b);
+                if(edge.second) *edge.first = addVertex(interpolator(vertices[a], vertices[b]));
+                newVertices[j] = *edge.first;
+            } else newVertices[j] = addVertex(interpolator(vertices[a], vertices[b]));
+        }
 
         /*
             * Add three new faces (0, 1, 3) and update original (2)
@@ -0,0 +1,161 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "MeshTools/Forsyth.h"
+#include "MeshTools/VertexCacheStatistics.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class ForsythTest: public TestSuite::Tester {
+    public:
+        ForsythTest();
+
+        void forsyth();
+        void grid();
+        void empty();
+
+    private:
+        std::vector<UnsignedInt> indices;
+        std::size_t vertexCount;
+};
+
+/* Same mesh as in TipsifyTest */
+ForsythTest::ForsythTest(): indices{
+    4, 1, 0,
+    10, 9, 13,
+    6, 3, 2,
+    9, 5, 4,
+    12, 9, 8,
+    11, 7, 6,
+
+    14, 15, 11,
+    2, 1, 5,
+    10, 6, 5,
+    10, 5, 9,
+    13, 14, 10,
+    1, 4, 5,
+
+    7, 3, 6,
+    6, 2, 5,
+    9, 4, 8,
+    6, 10, 11,
+    13, 9, 12,
+    14, 11, 10,
+
+    16, 17, 18
+}, vertexCount(19) {
+    addTests({&ForsythTest::forsyth,
+              &ForsythTest::grid,
+              &ForsythTest::empty});
+}
+
+namespace {
+
+/* Rotate each triangle so it starts with the smallest index and sort them,
+   so two index arrays can be compared regardless of triangle order */
+std::vector<UnsignedInt> canonical(const std::vector<UnsignedInt>& indices) {
+    std::vector<std::array<UnsignedInt, 3>> triangles;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        std::array<UnsignedInt, 3> t{{indices[i], indices[i+1], indices[i+2]}};
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+
+    std::vector<UnsignedInt> out;
+    for(const auto& t: triangles) out.insert(out.end(), t.begin(), t.end());
+    return out;
+}
+
+}
+
+void ForsythTest::forsyth() {
+    const std::vector<UnsignedInt> original = indices;
+    MeshTools::forsyth(indices, vertexCount, 3);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        16, 17, 18, /* isolated triangle has highest valence score */
+        4, 1, 0,
+        1, 4, 5,
+        2, 1, 5,
+        6, 2, 5,
+        6, 3, 2,
+        7, 3, 6,
+        11, 7, 6,
+        14, 15, 11,
+        14, 11, 10,
+        6, 10, 11,
+        10, 6, 5,
+        13, 14, 10,
+        10, 9, 13,
+        10, 5, 9,
+        9, 5, 4,
+        9, 4, 8,
+        12, 9, 8,
+        13, 9, 12
+    }));
+    CORRADE_COMPARE(canonical(indices), canonical(original));
+}
+
+void ForsythTest::grid() {
+    /* 32x32 quad grid with shuffled triangles */
+    constexpr UnsignedInt Size = 32;
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != Size; ++y) for(UnsignedInt x = 0; x != Size; ++x) {
+        const UnsignedInt i = y*(Size+1) + x;
+        indices.insert(indices.end(), {i, i+1, i+Size+2,
+                                       i, i+Size+2, i+Size+1});
+    }
+    UnsignedInt seed = 1;
+    for(std::size_t i = indices.size()/3; i > 1; --i) {
+        seed = seed*1103515245u + 12345u;
+        const std::size_t j = (seed >> 8) % i;
+        std::swap_ranges(indices.begin() + (i-1)*3, indices.begin() + i*3, indices.begin() + j*3);
+    }
+
+    const std::vector<UnsignedInt> original = indices;
+    const VertexCacheStatistics before = vertexCacheStatistics(indices, (Size+1)*(Size+1), 16);
+    MeshTools::forsyth(indices, (Size+1)*(Size+1), 16);
+    const VertexCacheStatistics after = vertexCacheStatistics(indices, (Size+1)*(Size+1), 16);
+
+    CORRADE_COMPARE(canonical(indices), canonical(original));
+    CORRADE_VERIFY(before.acmr() > 2.5f);
+    CORRADE_VERIFY(after.acmr() < 0.9f);
+    CORRADE_COMPARE(before.vertexCount(), after.vertexCount());
+}
+
+void ForsythTest::empty() {
+    std::vector<UnsignedInt> indices;
+    MeshTools::forsyth(indices, 0, 16);
+    CORRADE_VERIFY(indices.empty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::ForsythTest)
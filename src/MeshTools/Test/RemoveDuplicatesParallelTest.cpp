@@ -0,0 +1,130 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <TestSuite/Tester.h>
+
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
+#include "MeshTools/RemoveDuplicatesParallel.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class RemoveDuplicatesParallelTest: public TestSuite::Tester {
+    public:
+        RemoveDuplicatesParallelTest();
+
+        void parallel();
+        void parallelChain();
+        void parallelIntegral();
+};
+
+typedef Math::Vector<1, int> Vector1;
+
+RemoveDuplicatesParallelTest::RemoveDuplicatesParallelTest() {
+    addTests({&RemoveDuplicatesParallelTest::parallel,
+              &RemoveDuplicatesParallelTest::parallelChain,
+              &RemoveDuplicatesParallelTest::parallelIntegral});
+}
+
+void RemoveDuplicatesParallelTest::parallel() {
+    /* Pseudorandom points in a small volume, with many of them near to each
+       other and to slab boundaries */
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+    UnsignedInt state = 1;
+    for(std::size_t i = 0; i != 20000; ++i) {
+        Vector3 position;
+        for(std::size_t j = 0; j != 3; ++j) {
+            state = state*1103515245u + 12345u;
+            position[j] = Float((state >> 8) % 1000)*0.004f;
+        }
+        positions.push_back(position);
+        indices.push_back((i*7919) % 20000);
+        indices.push_back(i);
+    }
+
+    std::vector<Vector3> expectedPositions(positions);
+    std::vector<UnsignedInt> expectedIndices(indices);
+    MeshTools::removeDuplicates(expectedIndices, expectedPositions, 0.05f);
+    CORRADE_VERIFY(expectedPositions.size() < 20000);
+
+    for(UnsignedInt threadCount: {1, 2, 3, 4, 7}) {
+        std::vector<Vector3> actualPositions(positions);
+        std::vector<UnsignedInt> actualIndices(indices);
+        MeshTools::removeDuplicatesParallel(actualIndices, actualPositions, 0.05f, threadCount);
+
+        CORRADE_COMPARE(actualIndices, expectedIndices);
+        CORRADE_VERIFY(actualPositions == expectedPositions);
+    }
+}
+
+void RemoveDuplicatesParallelTest::parallelChain() {
+    /* Points 0.75 epsilon apart, processed from one end, so uniqueness of
+       each point depends on all previous */
+    std::vector<Vector2> positions;
+    std::vector<UnsignedInt> indices;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        positions.push_back({Float(i)*0.075f, 0.0f});
+        indices.push_back(i);
+    }
+
+    std::vector<Vector2> expectedPositions(positions);
+    std::vector<UnsignedInt> expectedIndices(indices);
+    MeshTools::removeDuplicates(expectedIndices, expectedPositions, 0.1f);
+    CORRADE_COMPARE(expectedPositions.size(), 500);
+
+    /* Processed from the other end */
+    std::vector<UnsignedInt> reversedIndices(indices.rbegin(), indices.rend());
+    std::vector<Vector2> expectedReversedPositions(positions);
+    std::vector<UnsignedInt> expectedReversedIndices(reversedIndices);
+    MeshTools::removeDuplicates(expectedReversedIndices, expectedReversedPositions, 0.1f);
+
+    for(UnsignedInt threadCount: {2, 5, 16}) {
+        std::vector<Vector2> actualPositions(positions);
+        std::vector<UnsignedInt> actualIndices(indices);
+        MeshTools::removeDuplicatesParallel(actualIndices, actualPositions, 0.1f, threadCount);
+        CORRADE_COMPARE(actualIndices, expectedIndices);
+        CORRADE_VERIFY(actualPositions == expectedPositions);
+
+        std::vector<Vector2> actualReversedPositions(positions);
+        std::vector<UnsignedInt> actualReversedIndices(reversedIndices);
+        MeshTools::removeDuplicatesParallel(actualReversedIndices, actualReversedPositions, 0.1f, threadCount);
+        CORRADE_COMPARE(actualReversedIndices, expectedReversedIndices);
+        CORRADE_VERIFY(actualReversedPositions == expectedReversedPositions);
+    }
+}
+
+void RemoveDuplicatesParallelTest::parallelIntegral() {
+    /* Done on single thread */
+    std::vector<Vector1> positions{1, 2, 1, 4};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::removeDuplicatesParallel(indices, positions, 1, 4);
+
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{1, 2, 4}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 1, 0, 2}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesParallelTest)
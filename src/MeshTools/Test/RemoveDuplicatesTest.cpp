@@ -24,6 +24,8 @@
 
 #include <TestSuite/Tester.h>
 
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
 #include "MeshTools/RemoveDuplicates.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -33,12 +35,26 @@ class RemoveDuplicatesTest: public TestSuite::Tester {
         RemoveDuplicatesTest();
 
         void cleanMesh();
+        void empty();
+        void unreferenced();
+        void exactLargeEpsilon();
+        void fuzzy();
+        void fuzzyCellBoundary();
+        void fuzzyFirstUnique();
+        void fuzzyVertexSize();
 };
 
 typedef Math::Vector<1, int> Vector1;
 
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
-    addTests({&RemoveDuplicatesTest::cleanMesh});
+    addTests({&RemoveDuplicatesTest::cleanMesh,
+              &RemoveDuplicatesTest::empty,
+              &RemoveDuplicatesTest::unreferenced,
+              &RemoveDuplicatesTest::exactLargeEpsilon,
+              &RemoveDuplicatesTest::fuzzy,
+              &RemoveDuplicatesTest::fuzzyCellBoundary,
+              &RemoveDuplicatesTest::fuzzyFirstUnique,
+              &RemoveDuplicatesTest::fuzzyVertexSize});
 }
 
 void RemoveDuplicatesTest::cleanMesh() {
@@ -51,6 +67,102 @@ void RemoveDuplicatesTest::cleanMesh() {
     CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 1, 0, 2}));
 }
 
+void RemoveDuplicatesTest::empty() {
+    std::vector<Vector3> positions{{1.0f, 2.0f, 3.0f}};
+    std::vector<UnsignedInt> indices;
+    MeshTools::removeDuplicates(indices, positions);
+
+    /* Nothing done */
+    CORRADE_COMPARE(positions.size(), 1);
+    CORRADE_VERIFY(indices.empty());
+}
+
+void RemoveDuplicatesTest::unreferenced() {
+    std::vector<Vector1> positions{7, 1, 2, 1, 3};
+    std::vector<UnsignedInt> indices{3, 2, 1, 2};
+    MeshTools::removeDuplicates(indices, positions);
+
+    /* Ordered by first occurence */
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{1, 2}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 1}));
+}
+
+void RemoveDuplicatesTest::exactLargeEpsilon() {
+    std::vector<Vector1> positions{1, 2, 4, 9, 10, 3};
+    std::vector<UnsignedInt> indices{0, 1, 2, 3, 4, 5};
+    MeshTools::removeDuplicates(indices, positions, 3);
+
+    /* Differing by less than 3 */
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{1, 4, 9}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 0, 1, 2, 2, 0}));
+}
+
+void RemoveDuplicatesTest::fuzzy() {
+    std::vector<Vector3> positions{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {1.05f, 1.95f, 3.0f},
+        {1.0f, 2.0f, 3.2f},
+        {4.0f, 5.0f, 6.0f}
+    };
+    std::vector<UnsignedInt> indices{0, 1, 2, 3, 4, 2};
+    MeshTools::removeDuplicates(indices, positions, 0.1f);
+
+    CORRADE_COMPARE(positions.size(), 3);
+    CORRADE_COMPARE(positions[0], Vector3(1.0f, 2.0f, 3.0f));
+    CORRADE_COMPARE(positions[1], Vector3(4.0f, 5.0f, 6.0f));
+    CORRADE_COMPARE(positions[2], Vector3(1.0f, 2.0f, 3.2f));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 2, 1, 0}));
+}
+
+void RemoveDuplicatesTest::fuzzyCellBoundary() {
+    /* Grid cells start at the minimum with size 0.2, the vertices are on
+       both sides of cell boundary in all three dimensions */
+    std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f},
+        {0.199f, 0.199f, 0.199f},
+        {0.201f, 0.201f, 0.201f},
+        {1.0f, 1.0f, 1.0f}
+    };
+    std::vector<UnsignedInt> indices{1, 2, 0, 3};
+    MeshTools::removeDuplicates(indices, positions, 0.1f);
+
+    CORRADE_COMPARE(positions.size(), 3);
+    CORRADE_COMPARE(positions[0], Vector3(0.199f));
+    CORRADE_COMPARE(positions[1], Vector3(0.0f));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 0, 1, 2}));
+}
+
+void RemoveDuplicatesTest::fuzzyFirstUnique() {
+    /* Third vertex is near to both first two, melt to the first */
+    std::vector<Vector2> positions{
+        {0.0f, 0.0f},
+        {0.15f, 0.0f},
+        {0.075f, 0.0f},
+        {0.14f, 0.0f}
+    };
+    std::vector<UnsignedInt> indices{0, 1, 2, 3};
+    MeshTools::removeDuplicates(indices, positions, 0.1f);
+
+    CORRADE_COMPARE(positions.size(), 2);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 1}));
+}
+
+void RemoveDuplicatesTest::fuzzyVertexSize() {
+    /* Only first two components are important */
+    std::vector<Vector3> positions{
+        {1.0f, 2.0f, 3.0f},
+        {1.0f, 2.0f, -3.0f},
+        {1.0f, 2.5f, 3.0f}
+    };
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    MeshTools::removeDuplicates<Vector3, 2>(indices, positions, 0.1f);
+
+    CORRADE_COMPARE(positions.size(), 2);
+    CORRADE_COMPARE(positions[1], Vector3(1.0f, 2.5f, 3.0f));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 0, 1}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
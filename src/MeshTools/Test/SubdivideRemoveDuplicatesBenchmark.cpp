@@ -22,62 +22,258 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include "SubdivideRemoveDuplicatesBenchmark.h"
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <Utility/MurmurHash2.h>
 
-#include <QtTest/QTest>
-
-#include "Primitives/Icosphere.h"
+#include "Test/AbstractBenchmarkTester.h"
+#include "Math/Vector3.h"
 #include "MeshTools/RemoveDuplicates.h"
+#include "MeshTools/RemoveDuplicatesParallel.h"
 #include "MeshTools/Subdivide.h"
-
-QTEST_APPLESS_MAIN(Magnum::MeshTools::Test::SubdivideRemoveDuplicatesBenchmark)
+#include "Primitives/Icosphere.h"
+#include "Trade/MeshData3D.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
 
-void SubdivideRemoveDuplicatesBenchmark::subdivide() {
-    QBENCHMARK {
-        Primitives::Icosphere<0> icosphere;
-
-        /* Subdivide 5 times */
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
+class SubdivideRemoveDuplicatesBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        SubdivideRemoveDuplicatesBenchmark();
+
+        void subdivide();
+        void subdivideAndRemoveDuplicatesMeshAfter();
+        void subdivideAndRemoveDuplicatesMeshBetween();
+        void subdivideSharedEdges();
+        void removeDuplicatesLarge();
+        void removeDuplicatesIntegral();
+};
+
+namespace {
+
+Vector3 interpolator(const Vector3& a, const Vector3& b) {
+    return (a+b).normalized();
+}
+
+/* Previous multi-pass implementation of removeDuplicates(), for comparison */
+template<class Vertex, std::size_t vertexSize = Vertex::Size> void removeDuplicatesMultiPass(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, typename Vertex::Type epsilon = Math::TypeTraits<typename Vertex::Type>::epsilon()) {
+    struct IndexHash {
+        std::size_t operator()(const Math::Vector<vertexSize, std::size_t>& data) const {
+            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
+        }
+    };
+
+    struct HashedVertex {
+        UnsignedInt oldIndex, newIndex;
+
+        HashedVertex(UnsignedInt oldIndex, UnsignedInt newIndex): oldIndex(oldIndex), newIndex(newIndex) {}
+    };
+
+    if(indices.empty()) return;
+
+    Vertex min = vertices[0], max = vertices[0];
+    for(const auto& v: vertices) {
+        min = Math::min(v, min);
+        max = Math::max(v, max);
+    }
+
+    epsilon = Math::max(epsilon, static_cast<typename Vertex::Type>((max-min).max()/std::numeric_limits<std::size_t>::max()));
+
+    Vertex moved;
+    for(std::size_t moving = 0; moving <= vertexSize; ++moving) {
+        std::unordered_map<Math::Vector<vertexSize, std::size_t>, HashedVertex, IndexHash> table;
+        table.reserve(vertices.size());
+
+        for(auto it = indices.begin(); it != indices.end(); ++it) {
+            std::size_t index[vertexSize];
+            for(std::size_t ii = 0; ii != vertexSize; ++ii)
+                index[ii] = std::size_t((vertices[*it][ii]+moved[ii]-min[ii])/epsilon);
+
+            HashedVertex v(*it, table.size());
+            auto result = table.insert({Math::Vector<vertexSize, std::size_t>::from(index), v});
+            *it = result.first->second.newIndex;
+        }
+
+        std::vector<Vertex> newVertices(table.size());
+        for(auto it = table.cbegin(); it != table.cend(); ++it)
+            newVertices[it->second.newIndex] = vertices[it->second.oldIndex];
+        std::swap(newVertices, vertices);
+
+        if(moving != Vertex::Size) {
+            moved = Vertex();
+            moved[moving] = epsilon/2;
+        }
+    }
+}
+
+/* Grid of 500x500 quads with each triangle having its own vertices, as
+   in scanned or triangle soup meshes */
+void triangleSoup(std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions) {
+    constexpr std::size_t size = 500;
+    indices.clear();
+    positions.clear();
+    positions.reserve(size*size*6);
+    for(std::size_t y = 0; y != size; ++y) for(std::size_t x = 0; x != size; ++x) {
+        const Vector3 a(Float(x), Float(y), 0.0f);
+        for(const Vector3& v: {a, a + Vector3::xAxis(), a + Vector3(1.0f, 1.0f, 0.0f),
+                               a, a + Vector3(1.0f, 1.0f, 0.0f), a + Vector3::yAxis()}) {
+            /* Small deterministic noise */
+            indices.push_back(positions.size());
+            positions.push_back(v + Vector3(Float(indices.size()%7)*1.0e-6f));
+        }
     }
 }
 
+}
+
+SubdivideRemoveDuplicatesBenchmark::SubdivideRemoveDuplicatesBenchmark() {
+    addTests({&SubdivideRemoveDuplicatesBenchmark::subdivide,
+              &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshAfter,
+              &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshBetween,
+              &SubdivideRemoveDuplicatesBenchmark::subdivideSharedEdges,
+              &SubdivideRemoveDuplicatesBenchmark::removeDuplicatesLarge,
+              &SubdivideRemoveDuplicatesBenchmark::removeDuplicatesIntegral});
+}
+
+void SubdivideRemoveDuplicatesBenchmark::subdivide() {
+    std::size_t vertexCount = 0;
+    benchmark("subdividing icosphere 5 times", 10, [&]() {
+        Trade::MeshData3D icosphere = Primitives::Icosphere::solid(0);
+
+        for(std::size_t i = 0; i != 5; ++i)
+            MeshTools::subdivide(icosphere.indices(), icosphere.positions(0), interpolator);
+
+        vertexCount = icosphere.positions(0).size();
+    });
+
+    CORRADE_COMPARE(vertexCount, 20472);
+}
+
 void SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshAfter() {
-    QBENCHMARK {
-        Primitives::Icosphere<0> icosphere;
+    std::size_t vertexCount = 0;
+    benchmark("subdividing icosphere 5 times, removing duplicates after, previous implementation", 10, [&]() {
+        Trade::MeshData3D icosphere = Primitives::Icosphere::solid(0);
 
-        /* Subdivide 5 times */
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
+        for(std::size_t i = 0; i != 5; ++i)
+            MeshTools::subdivide(icosphere.indices(), icosphere.positions(0), interpolator);
 
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-    }
+        removeDuplicatesMultiPass(icosphere.indices(), icosphere.positions(0));
+        vertexCount = icosphere.positions(0).size();
+    });
+
+    CORRADE_COMPARE(vertexCount, 10242);
+
+    benchmark("subdividing icosphere 5 times, removing duplicates after", 10, [&]() {
+        Trade::MeshData3D icosphere = Primitives::Icosphere::solid(0);
+
+        for(std::size_t i = 0; i != 5; ++i)
+            MeshTools::subdivide(icosphere.indices(), icosphere.positions(0), interpolator);
+
+        MeshTools::removeDuplicates(icosphere.indices(), icosphere.positions(0));
+        vertexCount = icosphere.positions(0).size();
+    });
+
+    CORRADE_COMPARE(vertexCount, 10242);
 }
 
 void SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesMeshBetween() {
-    QBENCHMARK {
-        Primitives::Icosphere<0> icosphere;
-
-        /* Subdivide 5 times */
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
-        MeshTools::subdivide(*icosphere.indices(), *icosphere.positions(0), interpolator);
-        MeshTools::removeDuplicates(*icosphere.indices(), *icosphere.positions(0));
+    std::size_t vertexCount = 0;
+    benchmark("subdividing icosphere 5 times, removing duplicates between, previous implementation", 10, [&]() {
+        Trade::MeshData3D icosphere = Primitives::Icosphere::solid(0);
+
+        for(std::size_t i = 0; i != 5; ++i) {
+            MeshTools::subdivide(icosphere.indices(), icosphere.positions(0), interpolator);
+            removeDuplicatesMultiPass(icosphere.indices(), icosphere.positions(0));
+        }
+
+        vertexCount = icosphere.positions(0).size();
+    });
+
+    CORRADE_COMPARE(vertexCount, 10242);
+
+    benchmark("subdividing icosphere 5 times, removing duplicates between", 10, [&]() {
+        Trade::MeshData3D icosphere = Primitives::Icosphere::solid(0);
+
+        for(std::size_t i = 0; i != 5; ++i) {
+            MeshTools::subdivide(icosphere.indices(), icosphere.positions(0), interpolator);
+            MeshTools::removeDuplicates(icosphere.indices(), icosphere.positions(0));
+        }
+
+        vertexCount = icosphere.positions(0).size();
+    });
+
+    CORRADE_COMPARE(vertexCount, 10242);
+}
+
+void SubdivideRemoveDuplicatesBenchmark::subdivideSharedEdges() {
+    std::size_t vertexCount = 0;
+    benchmark("subdividing icosphere 5 times with shared edges", 10, [&]() {
+        Trade::MeshData3D icosphere = Primitives::Icosphere::solid(0);
+
+        MeshTools::subdivide(icosphere.indices(), icosphere.positions(0), interpolator, SubdivideMode::SharedEdges, 5);
+        vertexCount = icosphere.positions(0).size();
+    });
+
+    CORRADE_COMPARE(vertexCount, 10242);
+}
+
+void SubdivideRemoveDuplicatesBenchmark::removeDuplicatesLarge() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+
+    benchmark("removing duplicates from 1.5M vertices, previous implementation", 3, [&]() {
+        triangleSoup(indices, positions);
+        removeDuplicatesMultiPass(indices, positions, 1.0e-3f);
+    });
+
+    benchmark("removing duplicates from 1.5M vertices", 3, [&]() {
+        triangleSoup(indices, positions);
+        MeshTools::removeDuplicates(indices, positions, 1.0e-3f);
+    });
+
+    CORRADE_COMPARE(positions.size(), 501*501);
+    CORRADE_COMPARE(indices.size(), 500*500*6);
+
+    const std::vector<UnsignedInt> expectedIndices(indices);
+    for(UnsignedInt threadCount: {2, 4, 8}) {
+        std::ostringstream name;
+        name << "removing duplicates from 1.5M vertices on " << threadCount << " threads";
+        benchmark(name.str(), 3, [&]() {
+            triangleSoup(indices, positions);
+            MeshTools::removeDuplicatesParallel(indices, positions, 1.0e-3f, threadCount);
+        });
+
+        CORRADE_COMPARE(positions.size(), 501*501);
+        CORRADE_VERIFY(indices == expectedIndices);
     }
 }
 
+void SubdivideRemoveDuplicatesBenchmark::removeDuplicatesIntegral() {
+    /* Index combinations as in combineIndexedArrays() */
+    std::vector<UnsignedInt> indices;
+    std::vector<Math::Vector<3, UnsignedInt>> combinations;
+    auto setup = [&]() {
+        indices.resize(1000000);
+        combinations.resize(indices.size());
+        for(UnsignedInt i = 0; i != indices.size(); ++i) {
+            indices[i] = i;
+            combinations[i] = {i%100000, i%1000, i%50000};
+        }
+    };
+
+    benchmark("removing duplicates from 1M integral vertices, previous implementation", 3, [&]() {
+        setup();
+        removeDuplicatesMultiPass(indices, combinations);
+    });
+
+    benchmark("removing duplicates from 1M integral vertices", 3, [&]() {
+        setup();
+        MeshTools::removeDuplicates(indices, combinations);
+    });
+
+    CORRADE_COMPARE(combinations.size(), 100000);
+}
+
 }}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideRemoveDuplicatesBenchmark)
@@ -25,6 +25,7 @@
 #include <sstream>
 #include <TestSuite/Tester.h>
 
+#include "Math/Vector3.h"
 #include "MeshTools/RemoveDuplicates.h"
 #include "MeshTools/Subdivide.h"
 
@@ -36,6 +37,8 @@ class SubdivideTest: public TestSuite::Tester {
 
         void wrongIndexCount();
         void subdivide();
+        void subdivideSharedEdges();
+        void subdivideLevels();
 };
 
 namespace {
@@ -48,7 +51,9 @@ inline Vector1 interpolator(Vector1 a, Vector1 b) { return (a[0]+b[0])/2; }
 
 SubdivideTest::SubdivideTest() {
     addTests({&SubdivideTest::wrongIndexCount,
-              &SubdivideTest::subdivide});
+              &SubdivideTest::subdivide,
+              &SubdivideTest::subdivideSharedEdges,
+              &SubdivideTest::subdivideLevels});
 }
 
 void SubdivideTest::wrongIndexCount() {
@@ -77,6 +82,54 @@ void SubdivideTest::subdivide() {
     CORRADE_COMPARE(positions.size(), 9);
 }
 
+void SubdivideTest::subdivideSharedEdges() {
+    std::vector<Vector1> positions{0, 2, 6, 8};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivide(indices, positions, interpolator, SubdivideMode::SharedEdges);
+
+    /* Vertex for edge 1-2 is created only once */
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{0, 2, 6, 8, 1, 4, 3, 7, 5}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}));
+}
+
+void SubdivideTest::subdivideLevels() {
+    /* Closed mesh -- tetrahedron, vertices projected onto sphere, so no two
+       edges have the same midpoint */
+    const std::vector<Vector3> positions{{1.0f, 1.0f, 1.0f}, {1.0f, -1.0f, -1.0f}, {-1.0f, 1.0f, -1.0f}, {-1.0f, -1.0f, 1.0f}};
+    const std::vector<UnsignedInt> indices{0, 1, 2, 0, 3, 1, 1, 3, 2, 2, 3, 0};
+    auto sphereInterpolator = [](const Vector3& a, const Vector3& b) {
+        return (a+b).normalized()*Constants::sqrt3();
+    };
+
+    std::vector<Vector3> expectedPositions(positions);
+    std::vector<UnsignedInt> expectedIndices(indices);
+    for(std::size_t i = 0; i != 3; ++i) {
+        MeshTools::subdivide(expectedIndices, expectedPositions, sphereInterpolator);
+        MeshTools::removeDuplicates(expectedIndices, expectedPositions);
+    }
+
+    std::vector<Vector3> actualPositions(positions);
+    std::vector<UnsignedInt> actualIndices(indices);
+    MeshTools::subdivide(actualIndices, actualPositions, sphereInterpolator, SubdivideMode::SharedEdges, 3);
+
+    /* 4*4^3 faces, 4 + 6*(1 + 4 + 16) vertices, all reserved up front */
+    CORRADE_COMPARE(actualIndices.size(), 768);
+    CORRADE_COMPARE(actualPositions.size(), 130);
+    CORRADE_COMPARE(actualPositions.capacity(), 130);
+
+    /* Same mesh as when removing duplicates after each level */
+    CORRADE_COMPARE(expectedPositions.size(), actualPositions.size());
+    for(std::size_t i = 0; i != actualIndices.size(); ++i)
+        CORRADE_COMPARE(actualPositions[actualIndices[i]], expectedPositions[expectedIndices[i]]);
+
+    /* Separate mode with multiple levels */
+    std::vector<Vector3> separatePositions(positions);
+    std::vector<UnsignedInt> separateIndices(indices);
+    MeshTools::subdivide(separateIndices, separatePositions, sphereInterpolator, SubdivideMode::Separate, 3);
+    CORRADE_COMPARE(separateIndices.size(), 768);
+    CORRADE_COMPARE(separatePositions.size(), 4 + 3*(4 + 16 + 64));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
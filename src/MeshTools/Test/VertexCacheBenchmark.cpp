@@ -0,0 +1,137 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Utility/Debug.h>
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "Math/Vector3.h"
+#include "MeshTools/Forsyth.h"
+#include "MeshTools/Subdivide.h"
+#include "MeshTools/Tipsify.h"
+#include "MeshTools/VertexCacheStatistics.h"
+#include "Primitives/Icosphere.h"
+#include "Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class VertexCacheBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        VertexCacheBenchmark();
+
+        void grid();
+        void icosphere();
+
+    private:
+        void optimize(const std::string& name, const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount);
+};
+
+namespace {
+
+constexpr std::size_t CacheSize = 16;
+
+Vector3 interpolator(const Vector3& a, const Vector3& b) {
+    return (a+b).normalized();
+}
+
+/* Shuffle triangles to simulate badly ordered input, e.g. from exporter
+   sorting them by material or from previous removeDuplicates() */
+void shuffle(std::vector<UnsignedInt>& indices) {
+    UnsignedInt seed = 1;
+    for(std::size_t i = indices.size()/3; i > 1; --i) {
+        seed = seed*1103515245u + 12345u;
+        const std::size_t j = (seed >> 8) % i;
+        std::swap_ranges(indices.begin() + (i-1)*3, indices.begin() + i*3, indices.begin() + j*3);
+    }
+}
+
+void printStatistics(const std::string& name, const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount) {
+    const VertexCacheStatistics fifo = vertexCacheStatistics(indices, vertexCount, CacheSize, VertexCacheType::Fifo);
+    const VertexCacheStatistics lru = vertexCacheStatistics(indices, vertexCount, CacheSize, VertexCacheType::Lru);
+    Debug() << "  STATS:" << name << "FIFO ACMR" << fifo.acmr() << "ATVR" << fifo.atvr()
+            << "LRU ACMR" << lru.acmr() << "ATVR" << lru.atvr();
+}
+
+}
+
+VertexCacheBenchmark::VertexCacheBenchmark() {
+    addTests({&VertexCacheBenchmark::grid,
+              &VertexCacheBenchmark::icosphere});
+}
+
+void VertexCacheBenchmark::optimize(const std::string& name, const std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    printStatistics(name + ", unoptimized", indices, vertexCount);
+
+    std::vector<UnsignedInt> tipsified;
+    benchmark(name + ", tipsify", 3, [&]() {
+        tipsified = indices;
+        MeshTools::tipsify(tipsified, vertexCount, CacheSize);
+    });
+    printStatistics(name + ", tipsify", tipsified, vertexCount);
+
+    std::vector<UnsignedInt> forsythed;
+    benchmark(name + ", forsyth", 3, [&]() {
+        forsythed = indices;
+        MeshTools::forsyth(forsythed, vertexCount, CacheSize);
+    });
+    printStatistics(name + ", forsyth", forsythed, vertexCount);
+
+    CORRADE_COMPARE(tipsified.size(), indices.size());
+    CORRADE_COMPARE(forsythed.size(), indices.size());
+
+    /* Both should be well below 1 miss per triangle on regular meshes */
+    const VertexCacheStatistics unoptimized = vertexCacheStatistics(indices, vertexCount, CacheSize);
+    CORRADE_VERIFY(vertexCacheStatistics(tipsified, vertexCount, CacheSize).acmr() < unoptimized.acmr());
+    CORRADE_VERIFY(vertexCacheStatistics(forsythed, vertexCount, CacheSize).acmr() < 1.0f);
+}
+
+void VertexCacheBenchmark::grid() {
+    /* Grid of 512x512 quads, 512k triangles */
+    constexpr UnsignedInt Size = 512;
+    std::vector<UnsignedInt> indices;
+    indices.reserve(Size*Size*6);
+    for(UnsignedInt y = 0; y != Size; ++y) for(UnsignedInt x = 0; x != Size; ++x) {
+        const UnsignedInt i = y*(Size+1) + x;
+        indices.insert(indices.end(), {i, i+1, i+Size+2,
+                                       i, i+Size+2, i+Size+1});
+    }
+
+    optimize("grid with 512k triangles", indices, (Size+1)*(Size+1));
+    shuffle(indices);
+    optimize("shuffled grid with 512k triangles", indices, (Size+1)*(Size+1));
+}
+
+void VertexCacheBenchmark::icosphere() {
+    /* Icosphere subdivided 7 times, 320k triangles */
+    Trade::MeshData3D icosphere = Primitives::Icosphere::solid(0);
+    MeshTools::subdivide(icosphere.indices(), icosphere.positions(0), interpolator, SubdivideMode::SharedEdges, 7);
+    CORRADE_COMPARE(icosphere.indices().size(), 20*16384*3);
+
+    optimize("icosphere with 320k triangles", icosphere.indices(), icosphere.positions(0).size());
+    shuffle(icosphere.indices());
+    optimize("shuffled icosphere with 320k triangles", icosphere.indices(), icosphere.positions(0).size());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::VertexCacheBenchmark)
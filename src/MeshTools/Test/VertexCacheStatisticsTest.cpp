@@ -0,0 +1,77 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "MeshTools/VertexCacheStatistics.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class VertexCacheStatisticsTest: public TestSuite::Tester {
+    public:
+        VertexCacheStatisticsTest();
+
+        void fifo();
+        void lru();
+        void empty();
+};
+
+VertexCacheStatisticsTest::VertexCacheStatisticsTest() {
+    addTests({&VertexCacheStatisticsTest::fifo,
+              &VertexCacheStatisticsTest::lru,
+              &VertexCacheStatisticsTest::empty});
+}
+
+void VertexCacheStatisticsTest::fifo() {
+    /* Vertex 0 is pushed out by 1 and 2 before being used again, in FIFO
+       the hit on 0 in first triangle doesn't refresh it */
+    const VertexCacheStatistics statistics = vertexCacheStatistics({0, 1, 0, 2, 0, 1}, 3, 2, VertexCacheType::Fifo);
+    CORRADE_COMPARE(statistics.missCount(), 5);
+    CORRADE_COMPARE(statistics.triangleCount(), 2);
+    CORRADE_COMPARE(statistics.vertexCount(), 3);
+    CORRADE_COMPARE(statistics.acmr(), 2.5f);
+    CORRADE_COMPARE(statistics.atvr(), 5.0f/3.0f);
+}
+
+void VertexCacheStatisticsTest::lru() {
+    /* In LRU the hit on 0 moves it to front, so it survives adding 2 */
+    const VertexCacheStatistics statistics = vertexCacheStatistics({0, 1, 0, 2, 0, 1}, 3, 2, VertexCacheType::Lru);
+    CORRADE_COMPARE(statistics.missCount(), 4);
+    CORRADE_COMPARE(statistics.triangleCount(), 2);
+    CORRADE_COMPARE(statistics.vertexCount(), 3);
+    CORRADE_COMPARE(statistics.acmr(), 2.0f);
+    CORRADE_COMPARE(statistics.atvr(), 4.0f/3.0f);
+}
+
+void VertexCacheStatisticsTest::empty() {
+    const VertexCacheStatistics statistics = vertexCacheStatistics({}, 0, 16);
+    CORRADE_COMPARE(statistics.missCount(), 0);
+    CORRADE_COMPARE(statistics.acmr(), 0.0f);
+    CORRADE_COMPARE(statistics.atvr(), 0.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::VertexCacheStatisticsTest)
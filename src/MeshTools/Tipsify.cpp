@@ -24,8 +24,6 @@
 
 #include "Tipsify.h"
 
-#include <stack>
-
 namespace Magnum { namespace MeshTools { namespace Implementation {
 
 void Tipsify::operator()(std::size_t cacheSize) {
@@ -36,10 +34,14 @@ void Tipsify::operator()(std::size_t cacheSize) {
     /* Global time, per-vertex caching timestamps, per-triangle emmited flag */
     UnsignedInt time = cacheSize+1;
     std::vector<UnsignedInt> timestamp(vertexCount);
-    std::vector<bool> emitted(indices.size()/3);
+    std::vector<UnsignedByte> emitted(indices.size()/3);
 
     /* Dead-end vertex stack */
-    std::stack<UnsignedInt> deadEndStack;
+    std::vector<UnsignedInt> deadEndStack;
+
+    /* Array with candidates for next fanning vertex (in 1-ring around
+       fanning vertex), reused for all fanning steps */
+    std::vector<UnsignedInt> candidates;
 
     /* Output index buffer */
     std::vector<UnsignedInt> outputIndices;
@@ -49,9 +51,7 @@ void Tipsify::operator()(std::size_t cacheSize) {
     UnsignedInt fanningVertex = 0;
     UnsignedInt i = 0;
     while(fanningVertex != 0xFFFFFFFFu) {
-        /* Array with candidates for next fanning vertex (in 1-ring around
-           fanning vertex) */
-        std::vector<UnsignedInt> candidates;
+        candidates.clear();
 
         /* For all neighbors of fanning vertex */
         for(UnsignedInt ti = neighborPosition[fanningVertex], t = neighbors[ti]; ti != neighborPosition[fanningVertex+1]; t = neighbors[++ti]) {
@@ -65,7 +65,7 @@ void Tipsify::operator()(std::size_t cacheSize) {
 
                 /* Add to dead end stack and candidates array */
                 /** @todo Limit size of dead end stack to cache size */
-                deadEndStack.push(v);
+                deadEndStack.push_back(v);
                 candidates.push_back(v);
 
                 /* Decrease live triangle count */
@@ -102,8 +102,8 @@ void Tipsify::operator()(std::size_t cacheSize) {
         if(fanningVertex == 0xFFFFFFFFu) {
             /* Find vertex with live triangles in dead-end stack */
             while(!deadEndStack.empty()) {
-                unsigned int d = deadEndStack.top();
-                deadEndStack.pop();
+                const UnsignedInt d = deadEndStack.back();
+                deadEndStack.pop_back();
 
                 if(!liveTriangleCount[d]) continue;
                 fanningVertex = d;
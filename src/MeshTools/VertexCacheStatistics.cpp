@@ -0,0 +1,73 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VertexCacheStatistics.h"
+
+#include <algorithm>
+
+namespace Magnum { namespace MeshTools {
+
+VertexCacheStatistics vertexCacheStatistics(const std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheType type) {
+    UnsignedInt missCount = 0, referencedCount = 0;
+    std::vector<UnsignedByte> referenced(vertexCount);
+
+    /* FIFO cache contains last cacheSize missed vertices, so it's enough to
+       remember time of the miss for each vertex */
+    if(type == VertexCacheType::Fifo) {
+        UnsignedInt time = cacheSize+1;
+        std::vector<UnsignedInt> timestamp(vertexCount);
+        for(UnsignedInt v: indices) {
+            if(time-timestamp[v] <= cacheSize) continue;
+
+            timestamp[v] = time++;
+            ++missCount;
+            if(!referenced[v]) {
+                referenced[v] = true;
+                ++referencedCount;
+            }
+        }
+
+    /* LRU cache as array ordered by time of last access */
+    } else {
+        std::vector<UnsignedInt> cache;
+        cache.reserve(cacheSize+1);
+        for(UnsignedInt v: indices) {
+            auto found = std::find(cache.begin(), cache.end(), v);
+            if(found == cache.end()) {
+                ++missCount;
+                if(!referenced[v]) {
+                    referenced[v] = true;
+                    ++referencedCount;
+                }
+
+                cache.insert(cache.begin(), v);
+                if(cache.size() > cacheSize) cache.pop_back();
+            } else std::rotate(cache.begin(), found, found+1);
+        }
+    }
+
+    return VertexCacheStatistics(missCount, indices.size()/3, referencedCount);
+}
+
+}}
@@ -0,0 +1,121 @@
+#ifndef Magnum_MeshTools_VertexCacheStatistics_h
+#define Magnum_MeshTools_VertexCacheStatistics_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::MeshTools::VertexCacheStatistics, enum Magnum::MeshTools::VertexCacheType, function Magnum::MeshTools::vertexCacheStatistics()
+ */
+
+#include <vector>
+
+#include "Types.h"
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simulated vertex cache type
+
+@see vertexCacheStatistics()
+*/
+enum class VertexCacheType: UnsignedByte {
+    /**
+     * First-in first-out cache. Vertex is added to the cache only on cache
+     * miss, cache hit doesn't change the order. This is how most hardware
+     * post-transform caches behave.
+     */
+    Fifo,
+
+    /**
+     * Least-recently used cache. Every access moves the vertex to the front
+     * of the cache.
+     */
+    Lru
+};
+
+/**
+@brief Vertex cache statistics
+
+@see vertexCacheStatistics()
+*/
+class VertexCacheStatistics {
+    public:
+        /**
+         * @brief Constructor
+         * @param missCount         Count of cache misses
+         * @param triangleCount     Count of triangles
+         * @param vertexCount       Count of referenced vertices
+         */
+        constexpr explicit VertexCacheStatistics(UnsignedInt missCount, UnsignedInt triangleCount, UnsignedInt vertexCount): _missCount(missCount), _triangleCount(triangleCount), _vertexCount(vertexCount) {}
+
+        /** @brief Count of cache misses */
+        constexpr UnsignedInt missCount() const { return _missCount; }
+
+        /** @brief Count of triangles */
+        constexpr UnsignedInt triangleCount() const { return _triangleCount; }
+
+        /** @brief Count of referenced vertices */
+        constexpr UnsignedInt vertexCount() const { return _vertexCount; }
+
+        /**
+         * @brief Average cache miss ratio
+         *
+         * Cache misses per triangle. The value is in range `[0.5, 3]` for
+         * usual meshes, the lower the better.
+         */
+        Float acmr() const {
+            return _triangleCount ? Float(_missCount)/_triangleCount : 0.0f;
+        }
+
+        /**
+         * @brief Average transformed vertex ratio
+         *
+         * Cache misses per referenced vertex. The value is `1` for ideal
+         * ordering, where each vertex is transformed only once.
+         */
+        Float atvr() const {
+            return _vertexCount ? Float(_missCount)/_vertexCount : 0.0f;
+        }
+
+    private:
+        UnsignedInt _missCount, _triangleCount, _vertexCount;
+};
+
+/**
+@brief Compute vertex cache statistics
+@param indices      Index array
+@param vertexCount  Vertex count
+@param cacheSize    Post-transform vertex cache size
+@param type         Simulated cache type
+
+Simulates post-transform vertex cache of given size and type on given
+triangle index array and counts cache misses, so ordering produced by
+different optimizers (e.g. tipsify() or forsyth()) can be compared.
+*/
+VertexCacheStatistics MAGNUM_MESHTOOLS_EXPORT vertexCacheStatistics(const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize, VertexCacheType type = VertexCacheType::Fifo);
+
+}}
+
+#endif
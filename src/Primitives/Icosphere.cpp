@@ -27,7 +27,6 @@
 #include "Math/Vector3.h"
 #include "Mesh.h"
 #include "MeshTools/Subdivide.h"
-#include "MeshTools/RemoveDuplicates.h"
 #include "Trade/MeshData3D.h"
 
 namespace Magnum { namespace Primitives {
@@ -71,12 +70,9 @@ Trade::MeshData3D Icosphere::solid(const UnsignedInt subdivisions) {
         {0.0f, 0.525731f, 0.850651f}
     };
 
-    for(std::size_t i = 0; i != subdivisions; ++i)
-        MeshTools::subdivide(indices, positions, [](const Vector3& a, const Vector3& b) {
-            return (a+b).normalized();
-        });
-
-    MeshTools::removeDuplicates(indices, positions);
+    MeshTools::subdivide(indices, positions, [](const Vector3& a, const Vector3& b) {
+        return (a+b).normalized();
+    }, MeshTools::SubdivideMode::SharedEdges, subdivisions);
 
     std::vector<Vector3> normals(positions);
     return Trade::MeshData3D(MeshPrimitive::Triangles, std::move(indices), {std::move(positions)}, {std::move(normals)}, std::vector<std::vector<Vector2>>{});
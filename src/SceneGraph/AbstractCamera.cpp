@@ -1,5 +1,3 @@
-#ifndef Magnum_MeshTools_Test_SubdivideRemoveDuplicatesBenchmark_h
-#define Magnum_MeshTools_Test_SubdivideRemoveDuplicatesBenchmark_h
 /*
     This file is part of Magnum.
 
@@ -24,26 +22,22 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include <QtCore/QObject>
+#include "AbstractCamera.h"
 
-#include "Magnum.h"
+#include <Utility/Debug.h>
 
-namespace Magnum { namespace MeshTools { namespace Test {
+namespace Magnum { namespace SceneGraph {
 
-class SubdivideRemoveDuplicatesBenchmark: public QObject {
-    Q_OBJECT
+Debug operator<<(Debug debug, DrawOrder value) {
+    switch(value) {
+        #define _c(value) case DrawOrder::value: return debug << "SceneGraph::DrawOrder::" #value;
+        _c(Unsorted)
+        _c(SortKeyFrontToBack)
+        _c(BackToFront)
+        #undef _c
+    }
 
-    private slots:
-        void subdivide();
-        void subdivideAndRemoveDuplicatesMeshAfter();
-        void subdivideAndRemoveDuplicatesMeshBetween();
+    return debug << "SceneGraph::DrawOrder::(invalid)";
+}
 
-    private:
-        static Magnum::Vector4 interpolator(const Magnum::Vector4& a, const Magnum::Vector4& b) {
-            return (a+b).xyz().normalized();
-        }
-};
-
-}}}
-
-#endif
+}}
@@ -25,9 +25,12 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::SceneGraph::AbstractCamera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, alias @ref Magnum::SceneGraph::AbstractBasicCamera2D, @ref Magnum::SceneGraph::AbstractBasicCamera3D, typedef @ref Magnum::SceneGraph::AbstractCamera2D, @ref Magnum::SceneGraph::AbstractCamera3D
+ * @brief Class @ref Magnum::SceneGraph::AbstractCamera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, @ref Magnum::SceneGraph::DrawOrder, alias @ref Magnum::SceneGraph::AbstractBasicCamera2D, @ref Magnum::SceneGraph::AbstractBasicCamera3D, typedef @ref Magnum::SceneGraph::AbstractCamera2D, @ref Magnum::SceneGraph::AbstractCamera3D
  */
 
+#include <functional>
+#include <vector>
+
 #include "Math/Matrix3.h"
 #include "Math/Matrix4.h"
 #include "AbstractFeature.h"
@@ -47,6 +50,40 @@ enum class AspectRatioPolicy: UnsignedByte {
     Clip            /**< Clip on smaller side of view */
 };
 
+/**
+@brief Camera draw order
+
+@see @ref AbstractCamera::setDrawOrder(), @ref Drawable::setSortKey()
+*/
+enum class DrawOrder: UnsignedByte {
+    /**
+     * Drawables are drawn in the order in which they are in the group
+     * (default). Removing a drawable from the group moves the last one to its
+     * place, so the order is insertion order only until first removal and
+     * unspecified after that. If the order matters, e.g. for painter's
+     * algorithm in 2D, set @ref Drawable::setSortKey() "sort key" to the
+     * layer and use @ref DrawOrder::SortKeyFrontToBack instead.
+     */
+    Unsorted,
+
+    /**
+     * Drawables are sorted by @ref Drawable::sortKey() "sort key" and
+     * drawables with the same key are drawn front to back. Useful for opaque
+     * objects to minimize state changes and overdraw.
+     */
+    SortKeyFrontToBack,
+
+    /**
+     * Drawables are drawn back to front, drawables at the same depth are
+     * sorted by @ref Drawable::sortKey() "sort key". Useful for transparent
+     * objects.
+     */
+    BackToFront
+};
+
+/** @debugoperator{Magnum::SceneGraph::AbstractCamera} */
+Debug MAGNUM_SCENEGRAPH_EXPORT operator<<(Debug debug, DrawOrder value);
+
 namespace Implementation {
     template<UnsignedInt dimensions, class T> typename DimensionTraits<dimensions, T>::MatrixType aspectRatioFix(AspectRatioPolicy aspectRatioPolicy, const Math::Vector2<T>& projectionScale, const Vector2i& viewport);
 }
@@ -126,13 +163,144 @@ template<UnsignedInt dimensions, class T> class AbstractCamera: public AbstractF
          */
         virtual void setViewport(const Vector2i& size);
 
+        /** @brief Count of threads used for computing transformations */
+        UnsignedInt transformationThreadCount() const { return _transformationThreadCount; }
+
+        /**
+         * @brief Set count of threads used for computing transformations
+         * @return Reference to self (for method chaining)
+         *
+         * If set to value larger than `1`, transformations of drawables in
+         * @ref draw() are composed with camera matrix in parallel on given
+         * count of threads (including the calling one). Transformations of
+         * drawables which don't cache them are computed in parallel too, see
+         * @ref Object::transformations() for more information. The drawing
+         * itself is always done on the calling thread. Default is `1`.
+         */
+        AbstractCamera<dimensions, T>& setTransformationThreadCount(UnsignedInt count);
+
+        /** @brief Whether frustum culling is enabled */
+        bool isFrustumCullingEnabled() const { return _frustumCulling; }
+
+        /**
+         * @brief Enable or disable frustum culling
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref draw() tests bounding box of each drawable which
+         * has it against the projection frustum and skips drawables which are
+         * completely outside. Drawables without bounding box are always
+         * drawn. Enabled by default.
+         * @see @ref Drawable::setBoundingBox(), @ref testedDrawableCount(),
+         *      @ref culledDrawableCount()
+         */
+        AbstractCamera<dimensions, T>& setFrustumCulling(bool enabled);
+
+        /**
+         * @brief Count of drawables tested for culling in last draw
+         *
+         * Count of drawables with bounding box in last @ref draw() call, if
+         * frustum culling was enabled, `0` otherwise.
+         * @see @ref culledDrawableCount()
+         */
+        UnsignedInt testedDrawableCount() const { return _testedDrawableCount; }
+
+        /**
+         * @brief Count of drawables culled in last draw
+         *
+         * Count of drawables which were not drawn in last @ref draw() call
+         * because they were outside of the frustum.
+         * @see @ref testedDrawableCount()
+         */
+        UnsignedInt culledDrawableCount() const { return _culledDrawableCount; }
+
+        /** @brief Draw order */
+        DrawOrder drawOrder() const { return _drawOrder; }
+
+        /**
+         * @brief Set draw order
+         * @return Reference to self (for method chaining)
+         *
+         * Depth of each drawable is its distance from camera along the view
+         * direction. In 2D all drawables have the same depth, thus they are
+         * sorted only by sort key. Default is @ref DrawOrder::Unsorted.
+         * @see @ref Drawable::setSortKey()
+         */
+        AbstractCamera<dimensions, T>& setDrawOrder(DrawOrder order);
+
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables in order specified by
+         * @ref setDrawOrder(). Drawables outside of the frustum are skipped,
+         * see @ref setFrustumCulling(). Only transformations of objects
+         * changed since last draw are recomputed, see
+         * @ref Drawable-caching "Drawable documentation" for more
+         * information.
          */
         virtual void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw drawables culled using bounding volume hierarchy
+         *
+         * Queries @p hierarchy for volumes intersecting the frustum using
+         * @ref BoundingVolumeHierarchy::intersectingFrustum() and draws only
+         * drawables from @p group attached to objects of these volumes, thus
+         * whole parts of the scene outside of the frustum are rejected at
+         * once without touching their drawables. Drawables on objects
+         * without volume in the hierarchy are not drawn. The rest is done
+         * the same as in @ref draw(DrawableGroup<dimensions, T>&), including
+         * culling of each drawable against its bounding box. With
+         * @ref DrawOrder::Unsorted the drawables are drawn in unspecified
+         * order.
+         */
+        void draw(DrawableGroup<dimensions, T>& group, BoundingVolumeHierarchy<dimensions, T>& hierarchy);
+
+        /**
+         * @brief Draw from multiple cameras
+         * @param cameras       Cameras to draw with
+         * @param group         Group of drawables
+         * @param beforeDraw    Function called before drawing with each
+         *      camera, e.g. for binding a framebuffer or a cube map face.
+         *      Can be empty.
+         *
+         * Useful for shadow cascades, stereo rendering or cube map
+         * captures, where the same group is drawn from multiple views. Dirty
+         * objects of the drawables and all cameras are cleaned and
+         * transformations of drawables which don't cache them are computed
+         * only once for all cameras. Each camera then only composes the
+         * transformations with its camera matrix, culls and sorts the
+         * drawables according to its own settings, calls @p beforeDraw and
+         * draws the visible ones, same as @ref draw(DrawableGroup<dimensions, T>&).
+         * Transformation thread count of the first camera is used for
+         * computing the shared transformations. All cameras must be part of
+         * the same scene.
+         */
+        static void draw(const std::vector<AbstractCamera<dimensions, T>*>& cameras, DrawableGroup<dimensions, T>& group, const std::function<void(AbstractCamera<dimensions, T>&)>& beforeDraw = nullptr);
+
+        /**
+         * @brief Draw instanced drawables
+         *
+         * Computes transformations of the drawables, culls and sorts them
+         * the same way as @ref draw(DrawableGroup<dimensions, T>&), but
+         * instead of drawing each drawable separately, transformations of
+         * all visible drawables are collected into contiguous array in draw
+         * order and passed to @ref InstancedDrawableGroup::draw() at once.
+         * See @ref InstancedDrawableGroup for more information.
+         */
+        virtual void draw(InstancedDrawableGroup<dimensions, T>& group);
+
+        /**
+         * @brief Create snapshot of drawables for later drawing
+         *
+         * Computes transformations of the drawables, culls and sorts them
+         * the same way as @ref draw(DrawableGroup<dimensions, T>&), but
+         * instead of drawing stores projection and camera matrix, visible
+         * drawables and their transformations into given packet. Memory
+         * already allocated by the packet is reused. See
+         * @ref FramePacketBuffer for more information.
+         */
+        void snapshot(DrawableGroup<dimensions, T>& group, FramePacket<dimensions, T>& packet);
+
     protected:
         /**
          * @brief Constructor
@@ -157,10 +325,30 @@ template<UnsignedInt dimensions, class T> class AbstractCamera: public AbstractF
         #endif
 
     private:
+        /* All drawables in given group */
+        static std::vector<Drawable<dimensions, T>*> allDrawables(DrawableGroup<dimensions, T>& group);
+
+        /* Cleans given camera objects and dirty objects of the drawables,
+           computes absolute transformations of drawables which don't cache
+           them */
+        static void prepareDrawables(const std::vector<Drawable<dimensions, T>*>& drawables, std::vector<AbstractObject<dimensions, T>*> objects, UnsignedInt threadCount, std::vector<UnsignedInt>& uncached, std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& uncachedTransformations);
+
+        /* Computes transformations of all prepared drawables relative to
+           camera and returns indices of visible ones in draw order */
+        std::vector<UnsignedInt> visibleDrawables(const std::vector<Drawable<dimensions, T>*>& drawables, const std::vector<UnsignedInt>& uncached, const std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& uncachedTransformations, std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& transformations);
+
+        /* Prepares the drawables for this camera only and returns the visible
+           ones */
+        std::vector<UnsignedInt> visibleDrawables(const std::vector<Drawable<dimensions, T>*>& drawables, std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& transformations);
+
         typename DimensionTraits<dimensions, T>::MatrixType _projectionMatrix;
         typename DimensionTraits<dimensions, T>::MatrixType _cameraMatrix;
 
         Vector2i _viewport;
+        UnsignedInt _transformationThreadCount;
+        bool _frustumCulling;
+        DrawOrder _drawOrder;
+        UnsignedInt _testedDrawableCount, _culledDrawableCount;
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
@@ -30,7 +30,15 @@
 
 #include "AbstractCamera.h"
 
+#include <algorithm>
+
+#include "BoundingVolume.h"
+#include "BoundingVolumeHierarchy.h"
 #include "Drawable.h"
+#include "FramePacket.h"
+#include "InstancedDrawable.h"
+#include "parallelImplementation.h"
+#include "sortImplementation.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -43,12 +51,19 @@ template<class T> class Camera<2, T> {
         constexpr static Math::Matrix3<T> aspectRatioScale(const Math::Vector2<T>& scale) {
             return Math::Matrix3<T>::scaling({scale.x(), scale.y()});
         }
+
+        constexpr static T depth(const Math::Matrix3<T>&) { return T(0); }
 };
 template<class T> class Camera<3, T> {
     public:
         constexpr static Math::Matrix4<T> aspectRatioScale(const Math::Vector2<T>& scale) {
             return Math::Matrix4<T>::scaling({scale.x(), scale.y(), 1.0f});
         }
+
+        /* Camera looks in direction of -Z */
+        static T depth(const Math::Matrix4<T>& transformation) {
+            return -transformation.translation().z();
+        }
 };
 
 template<UnsignedInt dimensions, class T> typename DimensionTraits<dimensions, T>::MatrixType aspectRatioFix(AspectRatioPolicy aspectRatioPolicy, const Math::Vector2<T>& projectionScale, const Vector2i& viewport) {
@@ -66,9 +81,36 @@ template<UnsignedInt dimensions, class T> typename DimensionTraits<dimensions, T
         Vector2(T(1.0), relativeAspectRatio.x()/relativeAspectRatio.y()));
 }
 
+/* Whether the box transformed with given matrix is at least partially in
+   clip volume. The box is rejected only if all its corners are outside of the
+   same clip plane, thus the test is conservative. */
+template<UnsignedInt dimensions, class T> bool isInClipVolume(const typename DimensionTraits<dimensions, T>::MatrixType& matrix, const Math::Range<dimensions, T>& box) {
+    /* Bits 2*i and 2*i + 1 are set if all corners are outside of negative
+       and positive clip plane on axis i */
+    UnsignedInt outside = (1 << 2*dimensions) - 1;
+    for(UnsignedInt corner = 0; corner != 1 << dimensions; ++corner) {
+        Math::Vector<dimensions + 1, T> point;
+        for(UnsignedInt i = 0; i != dimensions; ++i)
+            point[i] = corner & (1 << i) ? box.max()[i] : box.min()[i];
+        point[dimensions] = T(1);
+
+        const Math::Vector<dimensions + 1, T> clip = matrix*point;
+        UnsignedInt cornerOutside = 0;
+        for(UnsignedInt i = 0; i != dimensions; ++i) {
+            if(clip[i] < -clip[dimensions]) cornerOutside |= 1 << 2*i;
+            if(clip[i] > clip[dimensions]) cornerOutside |= 1 << (2*i + 1);
+        }
+
+        /* At least one corner is inside of each plane, can't be culled */
+        if(!(outside &= cornerOutside)) return true;
+    }
+
+    return false;
 }
 
-template<UnsignedInt dimensions, class T> AbstractCamera<dimensions, T>::AbstractCamera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
+}
+
+template<UnsignedInt dimensions, class T> AbstractCamera<dimensions, T>::AbstractCamera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved), _transformationThreadCount(1), _frustumCulling(true), _drawOrder(DrawOrder::Unsorted), _testedDrawableCount(0), _culledDrawableCount(0) {
     AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::InvertedAbsolute);
 }
 
@@ -85,23 +127,210 @@ template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::se
     fixAspectRatio();
 }
 
+template<UnsignedInt dimensions, class T> AbstractCamera<dimensions, T>& AbstractCamera<dimensions, T>::setTransformationThreadCount(UnsignedInt count) {
+    CORRADE_ASSERT(count, "SceneGraph::Camera::setTransformationThreadCount(): thread count must be at least one", *this);
+    _transformationThreadCount = count;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> AbstractCamera<dimensions, T>& AbstractCamera<dimensions, T>::setFrustumCulling(bool enabled) {
+    _frustumCulling = enabled;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> AbstractCamera<dimensions, T>& AbstractCamera<dimensions, T>::setDrawOrder(DrawOrder order) {
+    _drawOrder = order;
+    return *this;
+}
+
 template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
-    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
-    CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
+    CORRADE_ASSERT(this->object().scene(), "Camera::draw(): cannot draw when camera is not part of any scene", );
 
-    /* Compute camera matrix */
-    AbstractFeature<dimensions, T>::object().setClean();
+    const std::vector<Drawable<dimensions, T>*> drawables = allDrawables(group);
+    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> transformations;
+    const std::vector<UnsignedInt> visible = visibleDrawables(drawables, transformations);
 
-    /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<AbstractObject<dimensions, T>*> objects(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        objects[i] = &group[i].object();
-    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+    /* Perform the drawing */
+    for(UnsignedInt i: visible)
+        drawables[i]->draw(transformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group, BoundingVolumeHierarchy<dimensions, T>& hierarchy) {
+    CORRADE_ASSERT(this->object().scene(), "Camera::draw(): cannot draw when camera is not part of any scene", );
+
+    /* Drawables from given group on objects with volume in the frustum */
+    std::vector<Drawable<dimensions, T>*> drawables;
+    for(BoundingVolume<dimensions, T>* volume: hierarchy.intersectingFrustum(*this)) {
+        for(AbstractFeature<dimensions, T>* feature = volume->object().firstFeature(); feature; feature = feature->nextFeature()) {
+            Drawable<dimensions, T>* drawable = dynamic_cast<Drawable<dimensions, T>*>(feature);
+            if(drawable && drawable->drawables() == &group)
+                drawables.push_back(drawable);
+        }
+    }
+
+    /* Remove duplicates, if the object has more than one volume */
+    std::sort(drawables.begin(), drawables.end());
+    drawables.erase(std::unique(drawables.begin(), drawables.end()), drawables.end());
+
+    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> transformations;
+    const std::vector<UnsignedInt> visible = visibleDrawables(drawables, transformations);
 
     /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+    for(UnsignedInt i: visible)
+        drawables[i]->draw(transformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::draw(InstancedDrawableGroup<dimensions, T>& group) {
+    CORRADE_ASSERT(this->object().scene(), "Camera::draw(): cannot draw when camera is not part of any scene", );
+
+    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> transformations;
+    const std::vector<UnsignedInt> visible = visibleDrawables(allDrawables(group), transformations);
+    if(visible.empty()) return;
+
+    /* Put transformations of visible drawables into contiguous array in draw
+       order and draw them all at once */
+    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> instances(visible.size());
+    for(std::size_t i = 0; i != visible.size(); ++i)
+        instances[i] = transformations[visible[i]];
+    group.draw(instances, *this);
+}
+
+template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::snapshot(DrawableGroup<dimensions, T>& group, FramePacket<dimensions, T>& packet) {
+    CORRADE_ASSERT(this->object().scene(), "Camera::snapshot(): cannot create snapshot when camera is not part of any scene", );
+
+    const std::vector<Drawable<dimensions, T>*> drawables = allDrawables(group);
+    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> transformations;
+    const std::vector<UnsignedInt> visible = visibleDrawables(drawables, transformations);
+
+    packet._camera = this;
+    packet._projectionMatrix = _projectionMatrix;
+    packet._cameraMatrix = _cameraMatrix;
+    packet._drawables.resize(visible.size());
+    packet._transformationMatrices.resize(visible.size());
+    for(std::size_t i = 0; i != visible.size(); ++i) {
+        packet._drawables[i] = drawables[visible[i]];
+        packet._transformationMatrices[i] = transformations[visible[i]];
+    }
+}
+
+template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::draw(const std::vector<AbstractCamera<dimensions, T>*>& cameras, DrawableGroup<dimensions, T>& group, const std::function<void(AbstractCamera<dimensions, T>&)>& beforeDraw) {
+    if(cameras.empty()) return;
+
+    /* Clean all cameras together with the drawables */
+    std::vector<AbstractObject<dimensions, T>*> objects(cameras.size());
+    for(std::size_t i = 0; i != cameras.size(); ++i) {
+        objects[i] = &cameras[i]->object();
+        CORRADE_ASSERT(objects[i]->scene() && objects[i]->scene() == objects[0]->scene(), "Camera::draw(): all cameras must be part of the same scene", );
+    }
+
+    const std::vector<Drawable<dimensions, T>*> drawables = allDrawables(group);
+    std::vector<UnsignedInt> uncached;
+    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> uncachedTransformations;
+    prepareDrawables(drawables, std::move(objects), cameras[0]->_transformationThreadCount, uncached, uncachedTransformations);
+
+    /* Draw from each camera, reusing the transformation array */
+    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> transformations;
+    for(AbstractCamera<dimensions, T>* camera: cameras) {
+        const std::vector<UnsignedInt> visible = camera->visibleDrawables(drawables, uncached, uncachedTransformations, transformations);
+
+        if(beforeDraw) beforeDraw(*camera);
+        for(UnsignedInt i: visible)
+            drawables[i]->draw(transformations[i], *camera);
+    }
+}
+
+template<UnsignedInt dimensions, class T> std::vector<Drawable<dimensions, T>*> AbstractCamera<dimensions, T>::allDrawables(DrawableGroup<dimensions, T>& group) {
+    std::vector<Drawable<dimensions, T>*> drawables(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        drawables[i] = &group[i];
+    return drawables;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<UnsignedInt> AbstractCamera<dimensions, T>::visibleDrawables(const std::vector<Drawable<dimensions, T>*>& drawables, std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& transformations) {
+    std::vector<UnsignedInt> uncached;
+    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> uncachedTransformations;
+    prepareDrawables(drawables, {&AbstractFeature<dimensions, T>::object()}, _transformationThreadCount, uncached, uncachedTransformations);
+    return visibleDrawables(drawables, uncached, uncachedTransformations, transformations);
+}
+
+template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::prepareDrawables(const std::vector<Drawable<dimensions, T>*>& drawables, std::vector<AbstractObject<dimensions, T>*> objects, const UnsignedInt threadCount, std::vector<UnsignedInt>& uncached, std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& uncachedTransformations) {
+    AbstractObject<dimensions, T>* scene = objects.front()->scene();
+
+    /* Camera objects are cleaned together with the drawables to compute
+       camera matrices */
+    std::vector<AbstractObject<dimensions, T>*> dirtyObjects, uncachedObjects;
+    for(AbstractObject<dimensions, T>* object: objects)
+        if(object->isDirty()) dirtyObjects.push_back(object);
+
+    /* Collect objects changed since last draw. Drawables with disabled
+       caching will have their transformation computed from scratch. */
+    for(std::size_t i = 0; i != drawables.size(); ++i) {
+        Drawable<dimensions, T>& drawable = *drawables[i];
+        if(!(drawable.cachedTransformations() & CachedTransformation::Absolute)) {
+            uncachedObjects.push_back(&drawable.object());
+            uncached.push_back(UnsignedInt(i));
+            continue;
+        }
+
+        /* The drawable was added to already clean object, force cleaning */
+        if(!drawable._hasAbsoluteTransformationMatrix)
+            drawable.object().setDirty();
+
+        if(drawable.object().isDirty())
+            dirtyObjects.push_back(&drawable.object());
+    }
+
+    /* Update cached absolute transformations of changed objects */
+    AbstractObject<dimensions, T>::setClean(dirtyObjects);
+
+    /* Compute absolute transformations of the rest */
+    if(!uncached.empty())
+        uncachedTransformations = scene->transformationMatrices(uncachedObjects, {}, threadCount);
+}
+
+template<UnsignedInt dimensions, class T> std::vector<UnsignedInt> AbstractCamera<dimensions, T>::visibleDrawables(const std::vector<Drawable<dimensions, T>*>& drawables, const std::vector<UnsignedInt>& uncached, const std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& uncachedTransformations, std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& transformations) {
+    /* Compose absolute transformations with camera matrix, drawables which
+       don't cache them have stale matrix, they are done separately below */
+    transformations.resize(drawables.size());
+    Implementation::parallelFor(_transformationThreadCount, drawables.size(), 1024, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            if(!(drawables[i]->cachedTransformations() & CachedTransformation::Absolute)) continue;
+            transformations[i] = _cameraMatrix*drawables[i]->_absoluteTransformationMatrix;
+        }
+    });
+    for(std::size_t i = 0; i != uncached.size(); ++i)
+        transformations[uncached[i]] = _cameraMatrix*uncachedTransformations[i];
+
+    /* Collect drawables which are not outside of the frustum */
+    std::vector<UnsignedInt> visible;
+    visible.reserve(transformations.size());
+    _testedDrawableCount = _culledDrawableCount = 0;
+    for(std::size_t i = 0; i != transformations.size(); ++i) {
+        if(_frustumCulling && drawables[i]->hasBoundingBox()) {
+            ++_testedDrawableCount;
+            if(!Implementation::isInClipVolume<dimensions, T>(_projectionMatrix*transformations[i], drawables[i]->boundingBox())) {
+                ++_culledDrawableCount;
+                continue;
+            }
+        }
+
+        visible.push_back(UnsignedInt(i));
+    }
+
+    /* Sort them, sort key and depth are combined into one 64-bit key */
+    if(_drawOrder != DrawOrder::Unsorted) {
+        std::vector<UnsignedLong> keys(visible.size());
+        for(std::size_t i = 0; i != visible.size(); ++i) {
+            const UnsignedLong sortKey = drawables[visible[i]]->sortKey();
+            const UnsignedLong depth = Implementation::sortableFloat(Float(Implementation::Camera<dimensions, T>::depth(transformations[visible[i]])));
+            keys[i] = _drawOrder == DrawOrder::SortKeyFrontToBack ?
+                sortKey << 32|depth : (~depth & 0xffffffffu) << 32|sortKey;
+        }
+
+        Implementation::radixSort(keys, visible);
+    }
+
+    return visible;
 }
 
 }}
@@ -168,6 +168,7 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
     friend class Containers::LinkedList<AbstractFeature<dimensions, T>>;
     friend class Containers::LinkedListItem<AbstractFeature<dimensions, T>, AbstractObject<dimensions, T>>;
     template<class Transformation> friend class Object;
+    template<class Transformation> friend class FlatObject;
 
     public:
         /**
@@ -104,6 +104,7 @@ template<UnsignedInt dimensions, class Derived, class T> class AbstractGroupedFe
 
     private:
         FeatureGroup<dimensions, Derived, T>* _group;
+        std::size_t _index; /* Position in the group, valid if _group is set */
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
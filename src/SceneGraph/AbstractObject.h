@@ -148,13 +148,14 @@ template<UnsignedInt dimensions, class T> class AbstractObject
          * @brief Transformation matrices of given set of objects relative to this object
          *
          * All transformations are premultiplied with @p initialTransformationMatrix,
-         * if specified.
+         * if specified. The computation is done on @p threadCount threads,
+         * if the implementation supports it.
          * @warning This function cannot check if all objects are of the same
          *      Object type, use typesafe Object::transformationMatrices() when
          *      possible.
          */
-        std::vector<MatrixType> transformationMatrices(const std::vector<AbstractObject<dimensions, T>*>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const {
-            return doTransformationMatrices(objects, initialTransformationMatrix);
+        std::vector<MatrixType> transformationMatrices(const std::vector<AbstractObject<dimensions, T>*>& objects, const MatrixType& initialTransformationMatrix = MatrixType(), UnsignedInt threadCount = 1) const {
+            return doTransformationMatrices(objects, initialTransformationMatrix, threadCount);
         }
 
         /*@}*/
@@ -193,9 +194,8 @@ template<UnsignedInt dimensions, class T> class AbstractObject
          * @brief Set object absolute transformation as dirty
          *
          * Calls AbstractFeature::markDirty() on all object features and
-         * recursively calls setDirty() on every child object which is not
-         * already dirty. If the object is already marked as dirty, the
-         * function does nothing.
+         * marks as dirty every child object which is not already dirty. If
+         * the object is already marked as dirty, the function does nothing.
          * @see @ref scenegraph-caching, setClean(), isDirty()
          */
         void setDirty() { doSetDirty(); }
@@ -223,7 +223,7 @@ template<UnsignedInt dimensions, class T> class AbstractObject
 
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
-        virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<AbstractObject<dimensions, T>*>& objects, const MatrixType& initialTransformationMatrix) const = 0;
+        virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<AbstractObject<dimensions, T>*>& objects, const MatrixType& initialTransformationMatrix, UnsignedInt threadCount) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
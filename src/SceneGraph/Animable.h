@@ -127,6 +127,18 @@ puts itself to rest and waits until some animation changes its state to
 pernamently running to separate group, they will not be always traversed when
 calling @ref AnimableGroup::step(), saving precious frame time.
 
+Only the animables which are running or which had their state changed since
+last call to @ref AnimableGroup::step() are traversed, thus stopped and paused
+animables don't add any overhead to the step.
+
+If you have many animations of the same type, consider using
+@ref AnimableBatch instead. It stores the animation state of all the
+animations in contiguous arrays and advances all running animations with
+single virtual call.
+
+Keyframe animations don't need to implement @ref animationStep() by hand,
+see @ref Track and @ref TrackPlayer.
+
 @section Animable-explicit-specializations Explicit template specializations
 
 The following specialization are explicitly compiled into @ref SceneGraph
@@ -325,6 +337,8 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
         virtual void animationStopped() {}
 
     private:
+        static const std::size_t Inactive = ~std::size_t(0);
+
         Float _duration;
         Float startTime, pauseTime;
         AnimationState previousState;
@@ -332,6 +346,7 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
         bool _repeated;
         UnsignedShort _repeatCount;
         UnsignedShort repeats;
+        std::size_t activeIndex; /* Position in group's active list */
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
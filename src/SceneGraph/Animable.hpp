@@ -25,9 +25,12 @@
 */
 
 /** @file
- * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Animable.h and @ref AnimableGroup.h
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Animable.h, @ref AnimableBatch.h and @ref AnimableGroup.h
  */
 
+#include <algorithm>
+
+#include "AnimableBatch.h"
 #include "AnimableGroup.h"
 #include "Animable.h"
 
@@ -35,9 +38,17 @@
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, group), _duration(0.0f), startTime(std::numeric_limits<Float>::infinity()), pauseTime(-std::numeric_limits<Float>::infinity()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _repeatCount(0), repeats(0) {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object), _duration(0.0f), startTime(std::numeric_limits<Float>::infinity()), pauseTime(-std::numeric_limits<Float>::infinity()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _repeatCount(0), repeats(0), activeIndex(Inactive) {
+    /* Added here and not in base constructor, as the group needs the state
+       to be initialized */
+    if(group) group->add(*this);
+}
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {
+    /* Removed here and not in base destructor, as the group needs the state
+       to be still alive */
+    if(animables()) animables()->remove(*this);
+}
 
 template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dimensions, T>::setState(AnimationState state) {
     if(currentState == state) return *this;
@@ -46,9 +57,9 @@ template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dime
     if(previousState == AnimationState::Stopped && state == AnimationState::Paused)
         return *this;
 
-    /* Wake up the group in case no animations are running */
-    animables()->wakeUp = true;
+    /* Let the group process the state change in next step */
     currentState = state;
+    if(animables()) animables()->activate(*this);
     return *this;
 }
 
@@ -60,12 +71,234 @@ template<UnsignedInt dimensions, class T> const AnimableGroup<dimensions, T>* An
     return static_cast<const AnimableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>::group());
 }
 
-template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
-    if(!_runningCount && !wakeUp) return;
-    wakeUp = false;
+template<UnsignedInt dimensions, class T> const std::size_t AnimableBatch<dimensions, T>::Inactive;
+
+template<UnsignedInt dimensions, class T> AnimableBatch<dimensions, T>::AnimableBatch(AnimableGroup<dimensions, T>* group): _group(group), _runningCount(0) {
+    if(_group) _group->_batches.push_back(this);
+}
+
+template<UnsignedInt dimensions, class T> AnimableBatch<dimensions, T>::~AnimableBatch() {
+    if(_group) _group->_batches.erase(std::find(_group->_batches.begin(), _group->_batches.end(), this));
+}
+
+template<UnsignedInt dimensions, class T> std::size_t AnimableBatch<dimensions, T>::add(const Float duration) {
+    _duration.push_back(duration);
+    _startTime.push_back(std::numeric_limits<Float>::infinity());
+    _pauseTime.push_back(-std::numeric_limits<Float>::infinity());
+    _previousState.push_back(AnimationState::Stopped);
+    _currentState.push_back(AnimationState::Stopped);
+    _repeated.push_back(false);
+    _repeatCount.push_back(0);
+    _repeats.push_back(0);
+    _activeIndex.push_back(Inactive);
+    return _duration.size()-1;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableBatch<dimensions, T>::remove(const std::size_t index) {
+    CORRADE_ASSERT(index < size(),
+        "SceneGraph::AnimableBatch::remove(): index" << index << "out of range for" << size() << "animations", );
+
+    if(_activeIndex[index] != Inactive) deactivate(index);
+    if(_previousState[index] == AnimationState::Running) --_runningCount;
+
+    /* Move the last animation to place of removed one */
+    const std::size_t last = size()-1;
+    if(index != last) {
+        _duration[index] = _duration[last];
+        _startTime[index] = _startTime[last];
+        _pauseTime[index] = _pauseTime[last];
+        _previousState[index] = _previousState[last];
+        _currentState[index] = _currentState[last];
+        _repeated[index] = _repeated[last];
+        _repeatCount[index] = _repeatCount[last];
+        _repeats[index] = _repeats[last];
+        _activeIndex[index] = _activeIndex[last];
+        if(_activeIndex[index] != Inactive) _active[_activeIndex[index]] = index;
+    }
+
+    _duration.pop_back();
+    _startTime.pop_back();
+    _pauseTime.pop_back();
+    _previousState.pop_back();
+    _currentState.pop_back();
+    _repeated.pop_back();
+    _repeatCount.pop_back();
+    _repeats.pop_back();
+    _activeIndex.pop_back();
+}
+
+template<UnsignedInt dimensions, class T> AnimableBatch<dimensions, T>& AnimableBatch<dimensions, T>::setState(const std::size_t index, AnimationState state) {
+    if(_currentState[index] == state) return *this;
+
+    /* Not allowed (for sanity) */
+    if(_previousState[index] == AnimationState::Stopped && state == AnimationState::Paused)
+        return *this;
+
+    _currentState[index] = state;
+    activate(index);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableBatch<dimensions, T>::activate(const std::size_t index) {
+    if(_activeIndex[index] != Inactive) return;
+    _activeIndex[index] = _active.size();
+    _active.push_back(index);
+}
+
+template<UnsignedInt dimensions, class T> void AnimableBatch<dimensions, T>::deactivate(const std::size_t index) {
+    /* Move the last active animation to place of removed one */
+    const std::size_t activeIndex = _activeIndex[index];
+    _active[activeIndex] = _active.back();
+    _activeIndex[_active[activeIndex]] = activeIndex;
+    _active.pop_back();
+    _activeIndex[index] = Inactive;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableBatch<dimensions, T>::step(const Float time, const Float delta) {
+    if(_active.empty()) return;
+
+    _stepIndices.resize(_active.size());
+    _stepTimes.resize(_active.size());
+    std::size_t stepCount = 0;
+
+    for(std::size_t i = 0; i < _active.size(); ) {
+        const std::size_t index = _active[i];
+
+        /* Process state changes, animations which are running since previous
+           step skip this completely */
+        if(_previousState[index] != AnimationState::Running || _currentState[index] != AnimationState::Running) {
+            /* The animation was stopped recently, just decrease count of
+               running animations if the animation was running before */
+            if(_previousState[index] != AnimationState::Stopped && _currentState[index] == AnimationState::Stopped) {
+                if(_previousState[index] == AnimationState::Running)
+                    --_runningCount;
+                _previousState[index] = AnimationState::Stopped;
+                deactivate(index);
+                animationStopped(index);
+                continue;
+
+            /* The animation was paused recently, set pause time to previous
+               frame time */
+            } else if(_previousState[index] == AnimationState::Running && _currentState[index] == AnimationState::Paused) {
+                _previousState[index] = AnimationState::Paused;
+                _pauseTime[index] = time;
+                --_runningCount;
+                deactivate(index);
+                animationPaused(index);
+                continue;
+
+            /* Remove the rest of not running animations from the active list */
+            } else if(_currentState[index] != AnimationState::Running) {
+                CORRADE_INTERNAL_ASSERT(_previousState[index] == _currentState[index]);
+                deactivate(index);
+                continue;
 
-    for(std::size_t i = 0; i != AnimableGroup<dimensions, T>::size(); ++i) {
-        Animable<dimensions, T>& animable = (*this)[i];
+            /* The animation was started recently, set start time to previous
+               frame time, reset repeat count */
+            } else if(_previousState[index] == AnimationState::Stopped) {
+                _previousState[index] = AnimationState::Running;
+                _startTime[index] = time;
+                _repeats[index] = 0;
+                ++_runningCount;
+                animationStarted(index);
+
+            /* The animation was resumed recently, add pause duration to start
+               time */
+            } else {
+                _previousState[index] = AnimationState::Running;
+                _startTime[index] += time - _pauseTime[index];
+                ++_runningCount;
+                animationResumed(index);
+            }
+        }
+
+        /* Animation time exceeded duration */
+        if(_duration[index] != 0.0f && time-_startTime[index] > _duration[index]) {
+            /* Not repeated or repeat count exceeded, stop */
+            if(!_repeated[index] || _repeats[index]+1 == _repeatCount[index]) {
+                _previousState[index] = AnimationState::Stopped;
+                _currentState[index] = AnimationState::Stopped;
+                --_runningCount;
+                deactivate(index);
+                animationStopped(index);
+                continue;
+            }
+
+            /* Increase repeat count and add duration to startTime */
+            ++_repeats[index];
+            _startTime[index] += _duration[index];
+        }
+
+        /* Animation is still running, add it to the list for animation step */
+        CORRADE_ASSERT(time-_startTime[index] >= 0.0f,
+            "SceneGraph::AnimableBatch::step(): animation was started in future - probably wrong time passed", );
+        _stepIndices[stepCount] = index;
+        _stepTimes[stepCount] = time - _startTime[index];
+        ++stepCount;
+        ++i;
+    }
+
+    CORRADE_INTERNAL_ASSERT(_runningCount <= size());
+
+    if(!stepCount) return;
+    CORRADE_ASSERT(delta >= 0.0f,
+        "SceneGraph::AnimableBatch::step(): negative delta passed", );
+    animationStep(_stepIndices.data(), _stepTimes.data(), stepCount, delta);
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>::~AnimableGroup() {
+    for(auto animable: _active) animable->activeIndex = Animable<dimensions, T>::Inactive;
+    for(auto batch: _batches) batch->_group = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>& AnimableGroup<dimensions, T>::add(Animable<dimensions, T>& animable) {
+    FeatureGroup<dimensions, Animable<dimensions, T>, T>::add(animable);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>& AnimableGroup<dimensions, T>::remove(Animable<dimensions, T>& animable) {
+    CORRADE_ASSERT(animable.animables() == this,
+        "SceneGraph::AnimableGroup::remove(): animable is not part of this group", *this);
+
+    FeatureGroup<dimensions, Animable<dimensions, T>, T>::remove(animable);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::doAdd(Animable<dimensions, T>& animable) {
+    /* Continue with the animation in this group */
+    if(animable.previousState == AnimationState::Running) {
+        ++_runningCount;
+        activate(animable);
+    } else if(animable.previousState != animable.currentState)
+        activate(animable);
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::doRemove(Animable<dimensions, T>& animable) {
+    if(animable.activeIndex != Animable<dimensions, T>::Inactive)
+        deactivate(animable);
+    if(animable.previousState == AnimationState::Running)
+        --_runningCount;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::activate(Animable<dimensions, T>& animable) {
+    if(animable.activeIndex != Animable<dimensions, T>::Inactive) return;
+    animable.activeIndex = _active.size();
+    _active.push_back(&animable);
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::deactivate(Animable<dimensions, T>& animable) {
+    /* Move the last active animable to place of removed one */
+    _active[animable.activeIndex] = _active.back();
+    _active[animable.activeIndex]->activeIndex = animable.activeIndex;
+    _active.pop_back();
+    animable.activeIndex = Animable<dimensions, T>::Inactive;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
+    /* Only running animables and animables with changed state are in the
+       active list, the others are not touched at all */
+    for(std::size_t i = 0; i < _active.size(); ) {
+        Animable<dimensions, T>& animable = *_active[i];
 
         /* The animation was stopped recently, just decrease count of running
            animations if the animation was running before */
@@ -73,6 +306,7 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
             if(animable.previousState == AnimationState::Running)
                 --_runningCount;
             animable.previousState = AnimationState::Stopped;
+            deactivate(animable);
             animable.animationStopped();
             continue;
 
@@ -81,12 +315,14 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
             animable.previousState = AnimationState::Paused;
             animable.pauseTime = time;
             --_runningCount;
+            deactivate(animable);
             animable.animationPaused();
             continue;
 
-        /* Skip the rest for not running animations */
+        /* Remove the rest of not running animations from the active list */
         } else if(animable.currentState != AnimationState::Running) {
             CORRADE_INTERNAL_ASSERT(animable.previousState == animable.currentState);
+            deactivate(animable);
             continue;
 
         /* The animation was started recently, set start time to previous frame
@@ -115,6 +351,7 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
                 animable.previousState = AnimationState::Stopped;
                 animable.currentState = AnimationState::Stopped;
                 --_runningCount;
+                deactivate(animable);
                 animable.animationStopped();
                 continue;
             }
@@ -130,9 +367,12 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
         CORRADE_ASSERT(delta >= 0.0f,
             "SceneGraph::AnimableGroup::step(): negative delta passed", );
         animable.animationStep(time - animable.startTime, delta);
+        ++i;
     }
 
     CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+
+    for(auto batch: _batches) batch->step(time, delta);
 }
 
 }}
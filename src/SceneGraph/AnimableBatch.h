@@ -0,0 +1,348 @@
+#ifndef Magnum_SceneGraph_AnimableBatch_h
+#define Magnum_SceneGraph_AnimableBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::AnimableBatch, alias Magnum::SceneGraph::BasicAnimableBatch2D, Magnum::SceneGraph::BasicAnimableBatch3D, typedef Magnum::SceneGraph::AnimableBatch2D, Magnum::SceneGraph::AnimableBatch3D
+ */
+
+#include <vector>
+
+#include "Animable.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Batch of animations
+
+Stores state of many animations of the same type together and advances all
+running animations with single virtual call. Compared to @ref Animable, where
+each animation is a separate feature with its own virtual
+@ref Animable::animationStep() call, the state is stored in contiguous arrays
+(structure of arrays), which is more cache-friendly when thousands of
+animations are running at once.
+
+@section AnimableBatch-usage Usage
+
+Subclass the batch and implement @ref animationStep(). The function is called
+with list of indices of running animations and their animation times. Each
+animation is identified by index returned from @ref add(), you can use the
+index to access additional data stored in the subclass:
+@code
+class Rotations: public SceneGraph::AnimableBatch3D {
+    public:
+        explicit Rotations(SceneGraph::AnimableGroup3D* group): SceneGraph::AnimableBatch3D(group) {}
+
+        std::size_t add(Object3D* object) {
+            objects.push_back(object);
+            return SceneGraph::AnimableBatch3D::add(10.0f);
+        }
+
+        void remove(std::size_t index) {
+            objects[index] = objects.back();
+            objects.pop_back();
+            SceneGraph::AnimableBatch3D::remove(index);
+        }
+
+    protected:
+        void animationStep(const std::size_t* indices, const Float*, std::size_t count, Float delta) override {
+            for(std::size_t i = 0; i != count; ++i)
+                objects[indices[i]]->rotateX(15.0_degf*delta);
+        }
+
+    private:
+        std::vector<Object3D*> objects;
+};
+
+Rotations rotations(&animables);
+rotations.setState(rotations.add(object), SceneGraph::AnimationState::Running);
+@endcode
+
+The batch is stepped from @ref AnimableGroup::step() of the group it belongs
+to. Semantics of animation state, duration and repeating are the same as for
+@ref Animable.
+
+@section AnimableBatch-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Double type) you have to
+use @ref Animable.hpp implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref AnimableBatch2D
+-   @ref AnimableBatch3D
+
+@see @ref scenegraph, @ref BasicAnimableBatch2D, @ref BasicAnimableBatch3D,
+    @ref AnimableBatch2D, @ref AnimableBatch3D, @ref AnimableGroup
+*/
+template<UnsignedInt dimensions, class T> class AnimableBatch {
+    friend class AnimableGroup<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param group     Group this batch belongs to
+         *
+         * Creates empty batch and adds it to the group, if specified.
+         */
+        explicit AnimableBatch(AnimableGroup<dimensions, T>* group = nullptr);
+
+        /** @brief Copying is not allowed */
+        AnimableBatch(const AnimableBatch<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        AnimableBatch(AnimableBatch<dimensions, T>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the batch from the group, if it belongs to some.
+         */
+        virtual ~AnimableBatch();
+
+        /** @brief Copying is not allowed */
+        AnimableBatch<dimensions, T>& operator=(const AnimableBatch<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        AnimableBatch<dimensions, T>& operator=(AnimableBatch<dimensions, T>&&) = delete;
+
+        /**
+         * @brief Group containing this batch
+         *
+         * If the batch doesn't belong to any group, returns `nullptr`.
+         */
+        AnimableGroup<dimensions, T>* animables() { return _group; }
+        const AnimableGroup<dimensions, T>* animables() const { return _group; } /**< @overload */
+
+        /** @brief Count of animations in the batch */
+        std::size_t size() const { return _duration.size(); }
+
+        /** @brief Count of running animations in the batch */
+        std::size_t runningCount() const { return _runningCount; }
+
+        /**
+         * @brief Add animation
+         * @param duration  Animation duration
+         * @return Index of the animation
+         *
+         * Creates stopped non-repeating animation. See
+         * @ref setDuration() for more information about the duration.
+         */
+        std::size_t add(Float duration = 0.0f);
+
+        /**
+         * @brief Remove animation
+         *
+         * The last animation in the batch is moved to place of the removed
+         * one, thus the removal is done in constant time, but the last
+         * animation changes its index. Must not be called from
+         * @ref animationStep() or any other animation callback.
+         */
+        void remove(std::size_t index);
+
+        /** @brief Animation duration */
+        Float duration(std::size_t index) const { return _duration[index]; }
+
+        /**
+         * @brief Set animation duration
+         * @return Reference to self (for method chaining)
+         *
+         * Sets duration of the animation cycle in seconds. Set to `0.0f` for
+         * infinite non-repeating animation.
+         */
+        AnimableBatch<dimensions, T>& setDuration(std::size_t index, Float duration) {
+            _duration[index] = duration;
+            return *this;
+        }
+
+        /** @brief Animation state */
+        AnimationState state(std::size_t index) const { return _currentState[index]; }
+
+        /**
+         * @brief Set animation state
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Animable::setState() for more information.
+         */
+        AnimableBatch<dimensions, T>& setState(std::size_t index, AnimationState state);
+
+        /** @brief Whether the animation is repeated */
+        bool isRepeated(std::size_t index) const { return _repeated[index]; }
+
+        /**
+         * @brief Enable/disable repeated animation
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `false`.
+         * @see setRepeatCount()
+         */
+        AnimableBatch<dimensions, T>& setRepeated(std::size_t index, bool repeated) {
+            _repeated[index] = repeated;
+            return *this;
+        }
+
+        /** @brief Repeat count */
+        UnsignedShort repeatCount(std::size_t index) const { return _repeatCount[index]; }
+
+        /**
+         * @brief Set repeat count
+         * @return Reference to self (for method chaining)
+         *
+         * Has effect only if repeated animation is enabled. `0` means
+         * infinitely repeated animation. Default is `0`.
+         * @see setRepeated()
+         */
+        AnimableBatch<dimensions, T>& setRepeatCount(std::size_t index, UnsignedShort count) {
+            _repeatCount[index] = count;
+            return *this;
+        }
+
+    protected:
+        /**
+         * @brief Perform animation step
+         * @param indices   Indices of running animations
+         * @param times     Time from start of each running animation
+         * @param count     Count of running animations
+         * @param delta     Time delta for current frame
+         *
+         * Called once from @ref AnimableGroup::step() with all animations in
+         * the batch which are in @ref AnimationState::Running state. Not
+         * called if no animation in the batch is running. See
+         * @ref Animable::animationStep() for more information.
+         */
+        virtual void animationStep(const std::size_t* indices, const Float* times, std::size_t count, Float delta) = 0;
+
+        /**
+         * @brief Action on animation start
+         *
+         * See @ref Animable::animationStarted() for more information.
+         * Default implementation does nothing.
+         */
+        virtual void animationStarted(std::size_t) {}
+
+        /**
+         * @brief Action on animation pause
+         *
+         * See @ref Animable::animationPaused() for more information.
+         * Default implementation does nothing.
+         */
+        virtual void animationPaused(std::size_t) {}
+
+        /**
+         * @brief Action on animation resume
+         *
+         * See @ref Animable::animationResumed() for more information.
+         * Default implementation does nothing.
+         */
+        virtual void animationResumed(std::size_t) {}
+
+        /**
+         * @brief Action on animation stop
+         *
+         * See @ref Animable::animationStopped() for more information.
+         * Default implementation does nothing.
+         */
+        virtual void animationStopped(std::size_t) {}
+
+    private:
+        static const std::size_t Inactive = ~std::size_t(0);
+
+        void step(Float time, Float delta);
+        void activate(std::size_t index);
+        void deactivate(std::size_t index);
+
+        AnimableGroup<dimensions, T>* _group;
+        std::size_t _runningCount;
+
+        std::vector<Float> _duration, _startTime, _pauseTime;
+        std::vector<AnimationState> _previousState, _currentState;
+        std::vector<UnsignedByte> _repeated;
+        std::vector<UnsignedShort> _repeatCount, _repeats;
+
+        /* List of animations which are running or changed their state, and
+           position of each animation in it */
+        std::vector<std::size_t> _active, _activeIndex;
+
+        /* Storage for animationStep() parameters */
+        std::vector<std::size_t> _stepIndices;
+        std::vector<Float> _stepTimes;
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief %Animable batch for two-dimensional scenes
+
+Convenience alternative to <tt>%AnimableBatch<2, T></tt>. See AnimableBatch
+for more information.
+@note Not available on GCC < 4.7. Use <tt>%AnimableBatch<2, T></tt> instead.
+@see @ref AnimableBatch2D, @ref BasicAnimableBatch3D
+*/
+template<class T> using BasicAnimableBatch2D = AnimableBatch<2, T>;
+#endif
+
+/**
+@brief %Animable batch for two-dimensional float scenes
+
+@see @ref AnimableBatch3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicAnimableBatch2D<Float> AnimableBatch2D;
+#else
+typedef AnimableBatch<2, Float> AnimableBatch2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief %Animable batch for three-dimensional scenes
+
+Convenience alternative to <tt>%AnimableBatch<3, T></tt>. See AnimableBatch
+for more information.
+@note Not available on GCC < 4.7. Use <tt>%AnimableBatch<3, T></tt> instead.
+@see @ref AnimableBatch3D, @ref BasicAnimableBatch2D
+*/
+template<class T> using BasicAnimableBatch3D = AnimableBatch<3, T>;
+#endif
+
+/**
+@brief %Animable batch for three-dimensional float scenes
+
+@see @ref AnimableBatch2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicAnimableBatch3D<Float> AnimableBatch3D;
+#else
+typedef AnimableBatch<3, Float> AnimableBatch3D;
+#endif
+
+#ifdef CORRADE_TARGET_WINDOWS
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimableBatch<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimableBatch<3, Float>;
+#endif
+
+}}
+
+#endif
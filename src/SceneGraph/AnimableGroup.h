@@ -43,33 +43,75 @@ See Animable for more information.
 */
 template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGroup<dimensions, Animable<dimensions, T>, T> {
     friend class Animable<dimensions, T>;
+    friend class AnimableBatch<dimensions, T>;
 
     public:
         /**
          * @brief Constructor
          */
-        explicit AnimableGroup(): _runningCount(0), wakeUp(false) {}
+        explicit AnimableGroup(): _runningCount(0) {}
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all animables and batches belonging to this group, but
+         * doesn't delete them.
+         */
+        ~AnimableGroup();
 
         /**
          * @brief Count of running animations
          *
+         * Animations in @ref AnimableBatch "batches" are not counted, see
+         * @ref AnimableBatch::runningCount().
          * @see step()
          */
         std::size_t runningCount() const { return _runningCount; }
 
+        /**
+         * @brief Add animable to the group
+         * @return Reference to self (for method chaining)
+         *
+         * If the animable is part of another group, it is removed from it.
+         * Done in constant time. Running animation continues in this group.
+         * The same is done if the animable is added through reference to
+         * the base @ref FeatureGroup.
+         * @see remove()
+         */
+        AnimableGroup<dimensions, T>& add(Animable<dimensions, T>& animable);
+
+        /**
+         * @brief Remove animable from the group
+         * @return Reference to self (for method chaining)
+         *
+         * The animable must be part of the group. Done in constant time.
+         * @see add()
+         */
+        AnimableGroup<dimensions, T>& remove(Animable<dimensions, T>& animable);
+
         /**
          * @brief Perform animation step
          * @param time      Absolute time (e.g. Timeline::previousFrameTime())
          * @param delta     Time delta for current frame (e.g. Timeline::previousFrameDuration())
          *
-         * If there are no running animations the function does nothing.
+         * Only animables which are running or which changed their state
+         * since last call are traversed, after that all
+         * @ref AnimableBatch "batches" in the group are stepped. If there are
+         * no running animations the function does nothing.
          * @see runningCount()
          */
         void step(const Float time, const Float delta);
 
     private:
+        void doAdd(Animable<dimensions, T>& animable) override;
+        void doRemove(Animable<dimensions, T>& animable) override;
+
+        void activate(Animable<dimensions, T>& animable);
+        void deactivate(Animable<dimensions, T>& animable);
+
         std::size_t _runningCount;
-        bool wakeUp;
+        std::vector<Animable<dimensions, T>*> _active;
+        std::vector<AnimableBatch<dimensions, T>*> _batches;
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
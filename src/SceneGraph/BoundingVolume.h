@@ -0,0 +1,196 @@
+#ifndef Magnum_SceneGraph_BoundingVolume_h
+#define Magnum_SceneGraph_BoundingVolume_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::BoundingVolume, alias Magnum::SceneGraph::BasicBoundingVolume2D, Magnum::SceneGraph::BasicBoundingVolume3D, typedef Magnum::SceneGraph::BoundingVolume2D, Magnum::SceneGraph::BoundingVolume3D
+ */
+
+#include "Math/Range.h"
+#include "DimensionTraits.h"
+#include "AbstractGroupedFeature.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume
+
+Axis-aligned bounding box of an object, which is part of
+@ref BoundingVolumeHierarchy. The box is specified in object local
+coordinates, the hierarchy then keeps the box transformed to world
+coordinates. Example:
+@code
+SceneGraph::BoundingVolumeHierarchy3D hierarchy;
+
+Object3D* o;
+new SceneGraph::BoundingVolume3D(*o, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}, &hierarchy);
+@endcode
+
+See @ref BoundingVolumeHierarchy for more information.
+
+@section BoundingVolume-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Double type) you have to
+use @ref BoundingVolumeHierarchy.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref BoundingVolume2D
+-   @ref BoundingVolume3D
+
+@see @ref scenegraph, @ref BasicBoundingVolume2D, @ref BasicBoundingVolume3D,
+    @ref BoundingVolume2D, @ref BoundingVolume3D
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolume: public AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T> {
+    friend class BoundingVolumeHierarchy<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    %Object this bounding volume belongs to
+         * @param box       Bounding box in object local coordinates
+         * @param hierarchy Hierarchy this bounding volume belongs to
+         *
+         * Adds the feature to the object and also to the hierarchy, if
+         * specified. Otherwise you can use
+         * @ref BoundingVolumeHierarchy::add().
+         */
+        explicit BoundingVolume(AbstractObject<dimensions, T>& object, const Math::Range<dimensions, T>& box, BoundingVolumeHierarchy<dimensions, T>* hierarchy = nullptr);
+
+        ~BoundingVolume();
+
+        /**
+         * @brief Hierarchy containing this bounding volume
+         *
+         * If the volume doesn't belong to any hierarchy, returns `nullptr`.
+         */
+        BoundingVolumeHierarchy<dimensions, T>* hierarchy();
+        const BoundingVolumeHierarchy<dimensions, T>* hierarchy() const; /**< @overload */
+
+        /** @brief Bounding box in object local coordinates */
+        Math::Range<dimensions, T> box() const { return _box; }
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The box is in object local coordinates. The hierarchy is updated
+         * on next @ref BoundingVolumeHierarchy::update().
+         */
+        BoundingVolume<dimensions, T>& setBox(const Math::Range<dimensions, T>& box);
+
+        /**
+         * @brief Bounding box in world coordinates
+         *
+         * Axis-aligned box enclosing the local box transformed with absolute
+         * object transformation. Up-to-date only after
+         * @ref BoundingVolumeHierarchy::update() was called.
+         */
+        Math::Range<dimensions, T> absoluteBox() const { return _absoluteBox; }
+
+    protected:
+        /**
+         * @brief Mark the volume for update
+         *
+         * Schedules the volume for refit in next
+         * @ref BoundingVolumeHierarchy::update(). If you reimplement this
+         * function, call this implementation too.
+         */
+        void markDirty() override;
+
+        /**
+         * @brief Compute bounding box in world coordinates
+         *
+         * If you reimplement this function, call this implementation too.
+         */
+        void clean(const typename DimensionTraits<dimensions, T>::MatrixType& absoluteTransformationMatrix) override;
+
+    private:
+        static const std::size_t Inactive = ~std::size_t(0);
+
+        Math::Range<dimensions, T> _box, _absoluteBox;
+        UnsignedInt _node; /* Leaf node in the hierarchy */
+        std::size_t _dirtyIndex; /* Position in hierarchy's dirty list */
+        bool _hasAbsoluteBox;
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Bounding volume for two-dimensional scenes
+
+Convenience alternative to <tt>%BoundingVolume<2, T></tt>. See
+BoundingVolume for more information.
+@note Not available on GCC < 4.7. Use <tt>%BoundingVolume<2, T></tt>
+    instead.
+@see @ref BoundingVolume2D, @ref BasicBoundingVolume3D
+*/
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+#endif
+
+/**
+@brief Bounding volume for two-dimensional float scenes
+
+@see @ref BoundingVolume3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+#else
+typedef BoundingVolume<2, Float> BoundingVolume2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Bounding volume for three-dimensional scenes
+
+Convenience alternative to <tt>%BoundingVolume<3, T></tt>. See
+BoundingVolume for more information.
+@note Not available on GCC < 4.7. Use <tt>%BoundingVolume<3, T></tt>
+    instead.
+@see @ref BoundingVolume3D, @ref BasicBoundingVolume2D
+*/
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+#endif
+
+/**
+@brief Bounding volume for three-dimensional float scenes
+
+@see @ref BoundingVolume2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+#else
+typedef BoundingVolume<3, Float> BoundingVolume3D;
+#endif
+
+#ifdef CORRADE_TARGET_WINDOWS
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume<3, Float>;
+#endif
+
+}}
+
+#endif
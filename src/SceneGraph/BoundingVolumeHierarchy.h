@@ -0,0 +1,297 @@
+#ifndef Magnum_SceneGraph_BoundingVolumeHierarchy_h
+#define Magnum_SceneGraph_BoundingVolumeHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::BoundingVolumeHierarchy, alias Magnum::SceneGraph::BasicBoundingVolumeHierarchy2D, Magnum::SceneGraph::BasicBoundingVolumeHierarchy3D, typedef Magnum::SceneGraph::BoundingVolumeHierarchy2D, Magnum::SceneGraph::BoundingVolumeHierarchy3D
+ */
+
+#include <vector>
+
+#include "Math/Range.h"
+#include "DimensionTraits.h"
+#include "FeatureGroup.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume hierarchy
+
+Spatial index over objects with @ref BoundingVolume features. The volumes are
+organized in binary tree of axis-aligned bounding boxes, which allows finding
+objects in given region, nearest to given point or hit by given ray in
+logarithmic time instead of testing each object separately.
+
+@section BoundingVolumeHierarchy-usage Usage
+
+Add @ref BoundingVolume features to your objects and then query the
+hierarchy:
+@code
+SceneGraph::BoundingVolumeHierarchy3D hierarchy;
+for(Object3D* o: objects)
+    new SceneGraph::BoundingVolume3D(*o, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}, &hierarchy);
+
+// Objects near the player
+for(SceneGraph::BoundingVolume3D* volume: hierarchy.intersectingSphere(player->absoluteTransformation().translation(), 10.0f))
+    damage(volume->object());
+
+// Picking
+std::vector<SceneGraph::BoundingVolume3D*> hits = hierarchy.intersectingRay(origin, direction);
+@endcode
+
+The hierarchy can be used to cull whole groups of objects outside of camera
+frustum at once, which scales better than culling each drawable separately,
+see @ref AbstractCamera::draw(DrawableGroup<dimensions, T>&, BoundingVolumeHierarchy<dimensions, T>&).
+
+@section BoundingVolumeHierarchy-update Updating the hierarchy
+
+When an object with bounding volume is marked as dirty, the volume is
+scheduled for update. The objects are cleaned and the tree is refit in
+@ref update(), which is called automatically before each query. Only
+bounding boxes of the changed volumes and their ancestors are recomputed,
+the tree structure is kept. Adding or removing volumes causes the tree to be
+rebuilt. The refit tree can get less efficient when the objects move a lot,
+call @ref rebuild() from time to time in that case.
+
+@section BoundingVolumeHierarchy-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Double type) you have to
+use @ref BoundingVolumeHierarchy.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref BoundingVolumeHierarchy2D
+-   @ref BoundingVolumeHierarchy3D
+
+@see @ref scenegraph, @ref BasicBoundingVolumeHierarchy2D,
+    @ref BasicBoundingVolumeHierarchy3D, @ref BoundingVolumeHierarchy2D,
+    @ref BoundingVolumeHierarchy3D, @ref BoundingVolume
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolumeHierarchy: public FeatureGroup<dimensions, BoundingVolume<dimensions, T>, T> {
+    friend class BoundingVolume<dimensions, T>;
+
+    public:
+        /** @brief Vector type */
+        typedef typename DimensionTraits<dimensions, T>::VectorType VectorType;
+
+        /** @brief Matrix type */
+        typedef typename DimensionTraits<dimensions, T>::MatrixType MatrixType;
+
+        /**
+         * @brief Constructor
+         *
+         * Creates empty hierarchy.
+         */
+        explicit BoundingVolumeHierarchy();
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all volumes belonging to this hierarchy, but doesn't
+         * delete them.
+         */
+        ~BoundingVolumeHierarchy();
+
+        /**
+         * @brief Add volume to the hierarchy
+         * @return Reference to self (for method chaining)
+         *
+         * If the volume is part of another hierarchy, it is removed from it.
+         * The tree is rebuilt on next @ref update().
+         * @see remove()
+         */
+        BoundingVolumeHierarchy<dimensions, T>& add(BoundingVolume<dimensions, T>& volume);
+
+        /**
+         * @brief Remove volume from the hierarchy
+         * @return Reference to self (for method chaining)
+         *
+         * The volume must be part of the hierarchy. The tree is rebuilt on
+         * next @ref update().
+         * @see add()
+         */
+        BoundingVolumeHierarchy<dimensions, T>& remove(BoundingVolume<dimensions, T>& volume);
+
+        /**
+         * @brief Bounds of the whole hierarchy
+         *
+         * Calls @ref update() and returns box enclosing all volumes. If the
+         * hierarchy is empty, returns zero range.
+         */
+        Math::Range<dimensions, T> bounds();
+
+        /**
+         * @brief Update the hierarchy
+         *
+         * Cleans objects of all volumes which changed since last update and
+         * refits the tree. If any volumes were added or removed, the tree is
+         * rebuilt from scratch. Called automatically from all queries.
+         * @see @ref rebuild()
+         */
+        void update();
+
+        /**
+         * @brief Rebuild the hierarchy
+         *
+         * Updates changed volumes and builds the tree from scratch. Use to
+         * restore efficiency of the tree after the objects moved a lot.
+         * @see @ref update()
+         */
+        void rebuild();
+
+        /**
+         * @brief Volumes intersecting given box
+         *
+         * Returns all volumes with world bounding box intersecting given box.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> intersecting(const Math::Range<dimensions, T>& box);
+
+        /**
+         * @brief Volumes intersecting given sphere
+         *
+         * Returns all volumes with world bounding box intersecting given
+         * sphere (or circle in 2D).
+         */
+        std::vector<BoundingVolume<dimensions, T>*> intersectingSphere(const VectorType& center, T radius);
+
+        /**
+         * @brief Volumes intersecting given frustum
+         * @param projectionMatrix  Projection and camera matrix
+         *
+         * Returns all volumes with world bounding box at least partially
+         * inside the clip volume of given matrix. Similarly to culling in
+         * @ref AbstractCamera::draw(), the test is conservative, some volumes
+         * outside of the frustum may be returned too.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> intersectingFrustum(const MatrixType& projectionMatrix);
+
+        /**
+         * @brief Volumes in camera frustum
+         *
+         * Same as above with projection and camera matrix taken from given
+         * camera.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> intersectingFrustum(AbstractCamera<dimensions, T>& camera);
+
+        /**
+         * @brief Volumes hit by given ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction
+         *
+         * Returns all volumes with world bounding box hit by the ray, sorted
+         * by distance of the hit from ray origin. Volumes containing the ray
+         * origin are at the beginning.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> intersectingRay(const VectorType& origin, const VectorType& direction);
+
+        /**
+         * @brief Volume nearest to given point
+         *
+         * Returns volume with world bounding box nearest to given point or
+         * `nullptr`, if the hierarchy is empty. If the point is inside more
+         * boxes, any of them is returned.
+         */
+        BoundingVolume<dimensions, T>* nearest(const VectorType& point);
+
+    private:
+        struct Node {
+            Math::Range<dimensions, T> box;
+            UnsignedInt parent;
+            UnsignedInt secondChild; /* First child is next to parent */
+            BoundingVolume<dimensions, T>* volume; /* Set only for leaves */
+        };
+
+        void doAdd(BoundingVolume<dimensions, T>& volume) override;
+        void doRemove(BoundingVolume<dimensions, T>& volume) override;
+        void enqueue(BoundingVolume<dimensions, T>& volume);
+        void cleanDirty();
+        void refit();
+        UnsignedInt build(std::size_t begin, std::size_t end, UnsignedInt parent);
+        template<class Predicate> std::vector<BoundingVolume<dimensions, T>*> query(Predicate predicate);
+
+        std::vector<Node> _nodes;
+        std::vector<BoundingVolume<dimensions, T>*> _dirty;
+        std::vector<BoundingVolume<dimensions, T>*> _leaves; /* Scratch space for building the tree */
+        bool _rebuild;
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Bounding volume hierarchy for two-dimensional scenes
+
+Convenience alternative to <tt>%BoundingVolumeHierarchy<2, T></tt>. See
+BoundingVolumeHierarchy for more information.
+@note Not available on GCC < 4.7. Use <tt>%BoundingVolumeHierarchy<2, T></tt>
+    instead.
+@see @ref BoundingVolumeHierarchy2D, @ref BasicBoundingVolumeHierarchy3D
+*/
+template<class T> using BasicBoundingVolumeHierarchy2D = BoundingVolumeHierarchy<2, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy for two-dimensional float scenes
+
+@see @ref BoundingVolumeHierarchy3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicBoundingVolumeHierarchy2D<Float> BoundingVolumeHierarchy2D;
+#else
+typedef BoundingVolumeHierarchy<2, Float> BoundingVolumeHierarchy2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Bounding volume hierarchy for three-dimensional scenes
+
+Convenience alternative to <tt>%BoundingVolumeHierarchy<3, T></tt>. See
+BoundingVolumeHierarchy for more information.
+@note Not available on GCC < 4.7. Use <tt>%BoundingVolumeHierarchy<3, T></tt>
+    instead.
+@see @ref BoundingVolumeHierarchy3D, @ref BasicBoundingVolumeHierarchy2D
+*/
+template<class T> using BasicBoundingVolumeHierarchy3D = BoundingVolumeHierarchy<3, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy for three-dimensional float scenes
+
+@see @ref BoundingVolumeHierarchy2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicBoundingVolumeHierarchy3D<Float> BoundingVolumeHierarchy3D;
+#else
+typedef BoundingVolumeHierarchy<3, Float> BoundingVolumeHierarchy3D;
+#endif
+
+#ifdef CORRADE_TARGET_WINDOWS
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolumeHierarchy<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolumeHierarchy<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,383 @@
+#ifndef Magnum_SceneGraph_BoundingVolumeHierarchy_hpp
+#define Magnum_SceneGraph_BoundingVolumeHierarchy_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref BoundingVolume.h and @ref BoundingVolumeHierarchy.h
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include "Math/Functions.h"
+#include "AbstractCamera.hpp"
+#include "BoundingVolume.h"
+#include "BoundingVolumeHierarchy.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Axis-aligned box enclosing given box transformed with affine matrix */
+template<UnsignedInt dimensions, class T> Math::Range<dimensions, T> transformedBox(const typename DimensionTraits<dimensions, T>::MatrixType& matrix, const Math::Range<dimensions, T>& box) {
+    const typename DimensionTraits<dimensions, T>::VectorType center = box.center();
+    const typename DimensionTraits<dimensions, T>::VectorType extent = box.size()/T(2);
+    typename DimensionTraits<dimensions, T>::VectorType transformedCenter, transformedExtent;
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        transformedCenter[i] = matrix[dimensions][i];
+        for(UnsignedInt j = 0; j != dimensions; ++j) {
+            transformedCenter[i] += matrix[j][i]*center[j];
+            transformedExtent[i] += std::abs(matrix[j][i])*extent[j];
+        }
+    }
+
+    return {transformedCenter - transformedExtent, transformedCenter + transformedExtent};
+}
+
+template<UnsignedInt dimensions, class T> Math::Range<dimensions, T> joinedBox(const Math::Range<dimensions, T>& a, const Math::Range<dimensions, T>& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+template<UnsignedInt dimensions, class T> bool boxesIntersect(const Math::Range<dimensions, T>& a, const Math::Range<dimensions, T>& b) {
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        if(a.max()[i] < b.min()[i] || b.max()[i] < a.min()[i]) return false;
+    return true;
+}
+
+template<UnsignedInt dimensions, class T> T boxPointDistanceSquared(const Math::Range<dimensions, T>& box, const typename DimensionTraits<dimensions, T>::VectorType& point) {
+    T distanceSquared(0);
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        const T d = point[i] < box.min()[i] ? box.min()[i] - point[i] :
+                    point[i] > box.max()[i] ? point[i] - box.max()[i] : T(0);
+        distanceSquared += d*d;
+    }
+
+    return distanceSquared;
+}
+
+/* Slab test, returns distance of the entry point in units of ray direction
+   length or infinity if the ray doesn't hit the box */
+template<UnsignedInt dimensions, class T> T rayBoxDistance(const Math::Range<dimensions, T>& box, const typename DimensionTraits<dimensions, T>::VectorType& origin, const typename DimensionTraits<dimensions, T>::VectorType& inverseDirection) {
+    T near(0);
+    T far = std::numeric_limits<T>::infinity();
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        T a = (box.min()[i] - origin[i])*inverseDirection[i];
+        T b = (box.max()[i] - origin[i])*inverseDirection[i];
+        if(a > b) std::swap(a, b);
+        near = std::max(near, a);
+        far = std::min(far, b);
+        if(near > far) return std::numeric_limits<T>::infinity();
+    }
+
+    return near;
+}
+
+}
+
+template<UnsignedInt dimensions, class T> const std::size_t BoundingVolume<dimensions, T>::Inactive;
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::BoundingVolume(AbstractObject<dimensions, T>& object, const Math::Range<dimensions, T>& box, BoundingVolumeHierarchy<dimensions, T>* hierarchy): AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>(object), _box(box), _node(0), _dirtyIndex(Inactive), _hasAbsoluteBox(false) {
+    AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>::setCachedTransformations(CachedTransformation::Absolute);
+
+    /* Added here and not in base constructor, as the hierarchy needs the
+       members to be initialized */
+    if(hierarchy) hierarchy->add(*this);
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::~BoundingVolume() {
+    if(hierarchy()) hierarchy()->remove(*this);
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>* BoundingVolume<dimensions, T>::hierarchy() {
+    return static_cast<BoundingVolumeHierarchy<dimensions, T>*>(AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> const BoundingVolumeHierarchy<dimensions, T>* BoundingVolume<dimensions, T>::hierarchy() const {
+    return static_cast<const BoundingVolumeHierarchy<dimensions, T>*>(AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>& BoundingVolume<dimensions, T>::setBox(const Math::Range<dimensions, T>& box) {
+    _box = box;
+    markDirty();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::markDirty() {
+    _hasAbsoluteBox = false;
+    if(hierarchy()) hierarchy()->enqueue(*this);
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::clean(const typename DimensionTraits<dimensions, T>::MatrixType& absoluteTransformationMatrix) {
+    _absoluteBox = Implementation::transformedBox<dimensions, T>(absoluteTransformationMatrix, _box);
+    _hasAbsoluteBox = true;
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>::BoundingVolumeHierarchy(): _rebuild(false) {}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>::~BoundingVolumeHierarchy() {
+    for(BoundingVolume<dimensions, T>* volume: _dirty)
+        volume->_dirtyIndex = BoundingVolume<dimensions, T>::Inactive;
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>& BoundingVolumeHierarchy<dimensions, T>::add(BoundingVolume<dimensions, T>& volume) {
+    FeatureGroup<dimensions, BoundingVolume<dimensions, T>, T>::add(volume);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>& BoundingVolumeHierarchy<dimensions, T>::remove(BoundingVolume<dimensions, T>& volume) {
+    CORRADE_ASSERT(volume.hierarchy() == this,
+        "SceneGraph::BoundingVolumeHierarchy::remove(): volume is not part of this hierarchy", *this);
+
+    FeatureGroup<dimensions, BoundingVolume<dimensions, T>, T>::remove(volume);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::doAdd(BoundingVolume<dimensions, T>& volume) {
+    enqueue(volume);
+    _rebuild = true;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::doRemove(BoundingVolume<dimensions, T>& volume) {
+    /* Move the last dirty volume to place of removed one */
+    if(volume._dirtyIndex != BoundingVolume<dimensions, T>::Inactive) {
+        _dirty[volume._dirtyIndex] = _dirty.back();
+        _dirty[volume._dirtyIndex]->_dirtyIndex = volume._dirtyIndex;
+        _dirty.pop_back();
+        volume._dirtyIndex = BoundingVolume<dimensions, T>::Inactive;
+    }
+
+    _rebuild = true;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::enqueue(BoundingVolume<dimensions, T>& volume) {
+    if(volume._dirtyIndex != BoundingVolume<dimensions, T>::Inactive) return;
+    volume._dirtyIndex = _dirty.size();
+    _dirty.push_back(&volume);
+}
+
+template<UnsignedInt dimensions, class T> Math::Range<dimensions, T> BoundingVolumeHierarchy<dimensions, T>::bounds() {
+    update();
+    return _nodes.empty() ? Math::Range<dimensions, T>() : _nodes.front().box;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::cleanDirty() {
+    /* Force cleaning of volumes which were added to already clean objects or
+       which had their box changed. Marking the objects as dirty can enqueue
+       more volumes from the subtree. */
+    for(std::size_t i = 0; i != _dirty.size(); ++i)
+        if(!_dirty[i]->_hasAbsoluteBox && !_dirty[i]->object().isDirty())
+            _dirty[i]->object().setDirty();
+
+    /* Clean all objects at once */
+    std::vector<AbstractObject<dimensions, T>*> objects;
+    objects.reserve(_dirty.size());
+    for(BoundingVolume<dimensions, T>* volume: _dirty)
+        if(!volume->_hasAbsoluteBox) objects.push_back(&volume->object());
+    AbstractObject<dimensions, T>::setClean(objects);
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::update() {
+    if(_dirty.empty() && !_rebuild) return;
+
+    if(_rebuild) {
+        rebuild();
+        return;
+    }
+
+    cleanDirty();
+    refit();
+    for(BoundingVolume<dimensions, T>* volume: _dirty)
+        volume->_dirtyIndex = BoundingVolume<dimensions, T>::Inactive;
+    _dirty.clear();
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::refit() {
+    /* Update leaf boxes and collect their ancestors, the first already
+       collected ancestor means the rest of the path is collected too */
+    std::vector<UnsignedInt> nodes;
+    std::vector<bool> collected(_nodes.size());
+    for(BoundingVolume<dimensions, T>* volume: _dirty) {
+        _nodes[volume->_node].box = volume->_absoluteBox;
+        for(UnsignedInt node = _nodes[volume->_node].parent; node != ~UnsignedInt(0) && !collected[node]; node = _nodes[node].parent) {
+            collected[node] = true;
+            nodes.push_back(node);
+        }
+    }
+
+    /* Children are always after their parents, thus processing the nodes in
+       reverse order updates the children first */
+    std::sort(nodes.begin(), nodes.end(), std::greater<UnsignedInt>());
+    for(UnsignedInt node: nodes)
+        _nodes[node].box = Implementation::joinedBox(_nodes[node + 1].box, _nodes[_nodes[node].secondChild].box);
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::rebuild() {
+    cleanDirty();
+    for(BoundingVolume<dimensions, T>* volume: _dirty)
+        volume->_dirtyIndex = BoundingVolume<dimensions, T>::Inactive;
+    _dirty.clear();
+    _rebuild = false;
+
+    _nodes.clear();
+    if(this->isEmpty()) return;
+
+    _nodes.reserve(2*this->size() - 1);
+    _leaves.resize(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i)
+        _leaves[i] = &(*this)[i];
+    build(0, _leaves.size(), ~UnsignedInt(0));
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt BoundingVolumeHierarchy<dimensions, T>::build(const std::size_t begin, const std::size_t end, const UnsignedInt parent) {
+    const UnsignedInt node = _nodes.size();
+    _nodes.push_back({{}, parent, 0, nullptr});
+
+    /* Leaf */
+    if(end - begin == 1) {
+        _nodes[node].box = _leaves[begin]->_absoluteBox;
+        _nodes[node].volume = _leaves[begin];
+        _leaves[begin]->_node = node;
+        return node;
+    }
+
+    /* Split along the longest axis of box enclosing centers of the volumes,
+       in the median to have balanced tree */
+    Math::Range<dimensions, T> centers(_leaves[begin]->_absoluteBox.center(), _leaves[begin]->_absoluteBox.center());
+    for(std::size_t i = begin + 1; i != end; ++i) {
+        const typename DimensionTraits<dimensions, T>::VectorType center = _leaves[i]->_absoluteBox.center();
+        centers = Implementation::joinedBox(centers, Math::Range<dimensions, T>(center, center));
+    }
+    const typename DimensionTraits<dimensions, T>::VectorType size = centers.size();
+    UnsignedInt axis = 0;
+    for(UnsignedInt i = 1; i != dimensions; ++i)
+        if(size[i] > size[axis]) axis = i;
+
+    const std::size_t middle = begin + (end - begin)/2;
+    std::nth_element(_leaves.begin() + begin, _leaves.begin() + middle, _leaves.begin() + end,
+        [axis](const BoundingVolume<dimensions, T>* a, const BoundingVolume<dimensions, T>* b) {
+            return a->_absoluteBox.min()[axis] + a->_absoluteBox.max()[axis] < b->_absoluteBox.min()[axis] + b->_absoluteBox.max()[axis];
+        });
+
+    /* First child is right after the parent */
+    build(begin, middle, node);
+    const UnsignedInt secondChild = build(middle, end, node);
+    _nodes[node].secondChild = secondChild;
+    _nodes[node].box = Implementation::joinedBox(_nodes[node + 1].box, _nodes[secondChild].box);
+    return node;
+}
+
+template<UnsignedInt dimensions, class T> template<class Predicate> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::query(Predicate predicate) {
+    update();
+
+    std::vector<BoundingVolume<dimensions, T>*> volumes;
+    if(_nodes.empty()) return volumes;
+
+    std::vector<UnsignedInt> stack{0};
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        const UnsignedInt index = stack.back();
+        stack.pop_back();
+
+        if(!predicate(node.box)) continue;
+
+        if(node.volume) volumes.push_back(node.volume);
+        else {
+            stack.push_back(node.secondChild);
+            stack.push_back(index + 1);
+        }
+    }
+
+    return volumes;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::intersecting(const Math::Range<dimensions, T>& box) {
+    return query([&box](const Math::Range<dimensions, T>& nodeBox) {
+        return Implementation::boxesIntersect(nodeBox, box);
+    });
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::intersectingSphere(const VectorType& center, const T radius) {
+    const T radiusSquared = radius*radius;
+    return query([&center, radiusSquared](const Math::Range<dimensions, T>& nodeBox) {
+        return Implementation::boxPointDistanceSquared<dimensions, T>(nodeBox, center) <= radiusSquared;
+    });
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::intersectingFrustum(const MatrixType& projectionMatrix) {
+    return query([&projectionMatrix](const Math::Range<dimensions, T>& nodeBox) {
+        return Implementation::isInClipVolume<dimensions, T>(projectionMatrix, nodeBox);
+    });
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::intersectingFrustum(AbstractCamera<dimensions, T>& camera) {
+    return intersectingFrustum(camera.projectionMatrix()*camera.cameraMatrix());
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::intersectingRay(const VectorType& origin, const VectorType& direction) {
+    const VectorType inverseDirection = VectorType(T(1))/direction;
+    std::vector<BoundingVolume<dimensions, T>*> volumes = query([&origin, &inverseDirection](const Math::Range<dimensions, T>& nodeBox) {
+        return Implementation::rayBoxDistance<dimensions, T>(nodeBox, origin, inverseDirection) != std::numeric_limits<T>::infinity();
+    });
+
+    /* Sort by distance */
+    std::vector<std::pair<T, BoundingVolume<dimensions, T>*>> hits;
+    hits.reserve(volumes.size());
+    for(BoundingVolume<dimensions, T>* volume: volumes)
+        hits.emplace_back(Implementation::rayBoxDistance<dimensions, T>(volume->_absoluteBox, origin, inverseDirection), volume);
+    std::stable_sort(hits.begin(), hits.end(), [](const std::pair<T, BoundingVolume<dimensions, T>*>& a, const std::pair<T, BoundingVolume<dimensions, T>*>& b) {
+        return a.first < b.first;
+    });
+
+    for(std::size_t i = 0; i != hits.size(); ++i)
+        volumes[i] = hits[i].second;
+    return volumes;
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>* BoundingVolumeHierarchy<dimensions, T>::nearest(const VectorType& point) {
+    update();
+    if(_nodes.empty()) return nullptr;
+
+    /* Best-first search, distance to node box is lower bound of distances
+       to all volumes in it, thus the first leaf found is the nearest one */
+    typedef std::pair<T, UnsignedInt> Candidate;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+    candidates.emplace(T(0), 0);
+    for(;;) {
+        const UnsignedInt index = candidates.top().second;
+        candidates.pop();
+
+        const Node& node = _nodes[index];
+        if(node.volume) return node.volume;
+
+        candidates.emplace(Implementation::boxPointDistanceSquared<dimensions, T>(_nodes[index + 1].box, point), index + 1);
+        candidates.emplace(Implementation::boxPointDistanceSquared<dimensions, T>(_nodes[node.secondChild].box, point), node.secondChild);
+    }
+}
+
+}}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef Magnum_SceneGraph_BuildHierarchy_h
+#define Magnum_SceneGraph_BuildHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneGraph::buildHierarchy()
+ */
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <Utility/Assert.h>
+
+#include "Trade/ObjectData3D.h"
+#include "Trade/SceneData.h"
+#include "SceneGraph/Object.h"
+#include "SceneGraph/ObjectPool.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+template<class ObjectType, class Transformation> struct BuiltObject { typedef ObjectType Type; };
+template<class Transformation> struct BuiltObject<void, Transformation> { typedef Object<Transformation> Type; };
+
+template<class ObjectType> ObjectType* createObject(ObjectPool* pool, std::true_type) {
+    return pool ? new(*pool) ObjectType : new ObjectType;
+}
+template<class ObjectType> ObjectType* createObject(ObjectPool*, std::false_type) {
+    return new ObjectType;
+}
+
+template<class Transformation> struct HierarchyBuilder {
+    static_assert(Transformation::Dimensions == 3, "Hierarchy can be built only from three-dimensional scene data");
+
+    template<class ObjectType> static std::vector<ObjectType*> build(Object<Transformation>& parent, const std::vector<UnsignedInt>& children, const std::vector<std::unique_ptr<Trade::ObjectData3D>>& objects, ObjectPool* pool) {
+        constexpr bool isPoolAllocated = std::is_base_of<PoolAllocated, ObjectType>::value;
+        CORRADE_ASSERT(!pool || isPoolAllocated, "SceneGraph::buildHierarchy(): the object type must be derived from PoolAllocated to use a pool", {});
+
+        /* Order the objects breadth-first, so each parent is created before
+           its children and the children are added in order. Each object can
+           be referenced only once, which also rules out any cycles, thus the
+           objects can be then linked together without any checks. Parents
+           are indices into the order array, 0xFFFFFFFFu for top-level
+           objects. */
+        std::vector<UnsignedInt> order, parents;
+        order.reserve(objects.size());
+        parents.reserve(objects.size());
+        std::vector<bool> used(objects.size());
+        const std::vector<UnsignedInt>* current = &children;
+        UnsignedInt currentParent = 0xFFFFFFFFu;
+        for(std::size_t next = 0; ; ++next) {
+            for(UnsignedInt id: *current) {
+                CORRADE_ASSERT(id < objects.size(), "SceneGraph::buildHierarchy(): object index" << id << "out of range for" << objects.size() << "objects", {});
+                CORRADE_ASSERT(objects[id], "SceneGraph::buildHierarchy(): object" << id << "is not loaded", {});
+                CORRADE_ASSERT(!used[id], "SceneGraph::buildHierarchy(): object" << id << "is referenced more than once", {});
+                used[id] = true;
+                order.push_back(id);
+                parents.push_back(currentParent);
+            }
+
+            /* Continue with children of next object, if any */
+            if(next == order.size()) break;
+            current = &objects[order[next]]->children();
+            currentParent = UnsignedInt(next);
+        }
+
+        /* Create the objects and link them to already created parents */
+        std::vector<ObjectType*> created(objects.size());
+        for(std::size_t i = 0; i != order.size(); ++i) {
+            const UnsignedInt id = order[i];
+            ObjectType* object = createObject<ObjectType>(pool, std::integral_constant<bool, isPoolAllocated>{});
+            object->setTransformation(Implementation::Transformation<Transformation>::fromMatrix(
+                typename DimensionTraits<3, typename Transformation::Type>::MatrixType(objects[id]->transformation())));
+            static_cast<Object<Transformation>*>(object)->setParentUnchecked(parents[i] == 0xFFFFFFFFu ?
+                parent : *created[order[parents[i]]]);
+            created[id] = object;
+        }
+
+        return created;
+    }
+};
+
+}
+
+/**
+@brief Build object hierarchy from scene data
+@param parent   Parent object, usually the scene
+@param scene    %Scene data
+@param objects  All three-dimensional objects of the importer, indexed by
+    their ID
+@param pool     Pool to allocate the objects from, if any
+@return Created objects indexed by their ID, `nullptr` for objects not
+    referenced by the scene
+
+Creates all objects referenced by @p scene and their children in one pass,
+sets their transformations and adds them to @p parent. Compared to creating
+the objects one by one, the hierarchy is validated once in linear time
+instead of checking for cycles each time an object gets its parent, only the
+top-level objects are put into the dirty queue of the scene and the memory
+for bookkeeping is allocated upfront. Useful for loading large scenes:
+@code
+std::optional<Trade::SceneData> sceneData = importer.scene(importer.defaultScene());
+std::vector<std::unique_ptr<Trade::ObjectData3D>> objectData(importer.object3DCount());
+for(UnsignedInt i = 0; i != objectData.size(); ++i)
+    objectData[i] = importer.object3D(i);
+
+std::vector<Object3D*> objects = SceneGraph::buildHierarchy(scene, *sceneData, objectData);
+for(UnsignedInt i = 0; i != objects.size(); ++i) {
+    if(!objects[i] || objectData[i]->instanceType() != Trade::ObjectInstanceType3D::Mesh) continue;
+    new MeshDrawable(*objects[i], meshes[objectData[i]->instance()], &drawables);
+}
+@endcode
+
+By default instances of @ref Object are created, a subclass can be specified
+as the first template parameter. It must be default-constructible, creating
+object without parent. If @p pool is specified, the subclass must be derived
+from @ref PoolAllocated and the objects are allocated from the pool. Create
+the pool with chunk size equal to object count to have all objects allocated
+at once.
+@code
+SceneGraph::ObjectPool pool(objectData.size());
+std::vector<MyObject*> objects = SceneGraph::buildHierarchy<MyObject>(scene, *sceneData, objectData, &pool);
+@endcode
+
+Expects that all object indices are in range, all referenced objects are
+loaded and each object is referenced only once.
+*/
+template<class ObjectType = void, class Transformation> std::vector<typename Implementation::BuiltObject<ObjectType, Transformation>::Type*> buildHierarchy(Object<Transformation>& parent, const Trade::SceneData& scene, const std::vector<std::unique_ptr<Trade::ObjectData3D>>& objects, ObjectPool* pool = nullptr) {
+    return Implementation::HierarchyBuilder<Transformation>::template build<typename Implementation::BuiltObject<ObjectType, Transformation>::Type>(parent, scene.children3D(), objects, pool);
+}
+
+}}
+
+#endif
@@ -95,6 +95,18 @@ template<class T> class BasicCamera2D: public AbstractCamera<2, T> {
             AbstractCamera<2, T>::setAspectRatioPolicy(policy);
             return *this;
         }
+        BasicCamera2D<T>& setTransformationThreadCount(UnsignedInt count) {
+            AbstractCamera<2, T>::setTransformationThreadCount(count);
+            return *this;
+        }
+        BasicCamera2D<T>& setFrustumCulling(bool enabled) {
+            AbstractCamera<2, T>::setFrustumCulling(enabled);
+            return *this;
+        }
+        BasicCamera2D<T>& setDrawOrder(DrawOrder order) {
+            AbstractCamera<2, T>::setDrawOrder(order);
+            return *this;
+        }
         #endif
 };
 
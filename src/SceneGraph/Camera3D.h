@@ -128,6 +128,18 @@ template<class T> class BasicCamera3D: public AbstractCamera<3, T> {
             AbstractCamera<3, T>::setAspectRatioPolicy(policy);
             return *this;
         }
+        BasicCamera3D<T>& setTransformationThreadCount(UnsignedInt count) {
+            AbstractCamera<3, T>::setTransformationThreadCount(count);
+            return *this;
+        }
+        BasicCamera3D<T>& setFrustumCulling(bool enabled) {
+            AbstractCamera<3, T>::setFrustumCulling(enabled);
+            return *this;
+        }
+        BasicCamera3D<T>& setDrawOrder(DrawOrder order) {
+            AbstractCamera<3, T>::setDrawOrder(order);
+            return *this;
+        }
         #endif
 
     private:
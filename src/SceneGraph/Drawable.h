@@ -28,6 +28,7 @@
  * @brief Class Magnum::SceneGraph::Drawable, Magnum::SceneGraph::DrawableGroup, alias Magnum::SceneGraph::BasicDrawable2D, Magnum::SceneGraph::BasicDrawable3D, Magnum::SceneGraph::BasicDrawableGroup2D, Magnum::SceneGraph::BasicDrawableGroup3D, typedef Magnum::SceneGraph::Drawable2D, Magnum::SceneGraph::Drawable3D, Magnum::SceneGraph::DrawableGroup2D, Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include "Math/Range.h"
 #include "AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -88,6 +89,74 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
+@section Drawable-culling Frustum culling
+
+If the drawable has bounding box set using @ref setBoundingBox(), the camera
+tests it against its projection frustum and doesn't call @ref draw() for
+drawables which are completely outside of it. The bounding box is in object
+local coordinates, usually it is the bounding box of the mesh being drawn:
+@code
+auto o = new DrawableObject(&scene, &drawables);
+o->setBoundingBox({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+@endcode
+
+Drawables without bounding box are always drawn. See
+@ref AbstractCamera::setFrustumCulling() for more information. The culling
+tests each drawable separately, for large scenes you can reject whole groups
+of objects at once using @ref BoundingVolumeHierarchy. Add
+@ref BoundingVolume features to objects of the drawables and pass the
+hierarchy to the camera:
+@code
+SceneGraph::BoundingVolumeHierarchy3D hierarchy;
+auto o = new DrawableObject(&scene, &drawables);
+new SceneGraph::BoundingVolume3D(*o, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}, &hierarchy);
+
+camera.draw(drawables, hierarchy);
+@endcode
+
+See @ref AbstractCamera::draw(DrawableGroup<dimensions, T>&, BoundingVolumeHierarchy<dimensions, T>&)
+for more information.
+
+@section Drawable-sorting Sorting drawables by state
+
+To minimize state changes, the camera can draw the drawables sorted by their
+@ref sortKey(). The key is an arbitrary 32-bit number, usually composed of IDs
+of shader, material and mesh, so drawables sharing the same state are drawn
+right after each other. Drawables with the same key are then drawn front to
+back to reduce overdraw. For transparent objects put them to separate group
+and draw them back to front instead:
+@code
+o->setSortKey(shaderId << 24|materialId << 12|meshId);
+
+camera.setDrawOrder(SceneGraph::DrawOrder::SortKeyFrontToBack)
+    .draw(opaqueObjects);
+camera.setDrawOrder(SceneGraph::DrawOrder::BackToFront)
+    .draw(transparentObjects);
+@endcode
+
+In 2D all drawables have the same depth, thus they are sorted only by the key.
+Use it for explicit layering instead of relying on order in the group, which
+is not preserved when any drawable is removed from it:
+@code
+background->setSortKey(0);
+sprite->setSortKey(1);
+hud->setSortKey(2);
+
+camera.setDrawOrder(SceneGraph::DrawOrder::SortKeyFrontToBack)
+    .draw(drawables);
+@endcode
+
+@section Drawable-caching Transformation caching
+
+Each drawable caches absolute transformation of its object (see
+@ref scenegraph-caching). The camera then in @ref AbstractCamera::draw()
+cleans only objects which were changed since the last draw and reuses the
+cached transformation for the rest, thus for mostly static scenes the
+hierarchy is not traversed again each frame. If you reimplement @ref clean(),
+call the %Drawable implementation too. If you disable the caching using
+@ref setCachedTransformations(), the transformation of the drawable is
+computed from scratch in each draw.
+
 @section Drawable-performance Using drawable groups to improve performance
 
 You can organize your drawables to multiple groups to minimize OpenGL state
@@ -114,6 +183,11 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
+If many drawables share the same mesh and shader, use @ref InstancedDrawable
+and @ref InstancedDrawableGroup instead to draw them all in single instanced
+draw call. For drawing less detailed meshes for distant objects see
+@ref LevelOfDetail.
+
 @see @ref scenegraph, @ref BasicDrawable2D, @ref BasicDrawable3D,
     @ref Drawable2D, @ref Drawable3D, @ref DrawableGroup
 */
@@ -127,7 +201,9 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * Adds the feature to the object and also to the group, if specified.
          * Otherwise you can use DrawableGroup::add().
          */
-        explicit Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables = nullptr): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables) {}
+        explicit Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables = nullptr): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables), _sortKey(0), _hasBoundingBox(false), _hasAbsoluteTransformationMatrix(false) {
+            AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::setCachedTransformations(CachedTransformation::Absolute);
+        }
 
         /**
          * @brief Group containing this drawable
@@ -143,6 +219,64 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
             return AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::group();
         }
 
+        /**
+         * @brief Whether the drawable has bounding box
+         *
+         * @see @ref setBoundingBox()
+         */
+        bool hasBoundingBox() const { return _hasBoundingBox; }
+
+        /**
+         * @brief Bounding box
+         *
+         * If the drawable doesn't have bounding box, returns zero range.
+         * @see @ref hasBoundingBox()
+         */
+        Math::Range<dimensions, T> boundingBox() const { return _boundingBox; }
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The box is in object local coordinates and is used for frustum
+         * culling in @ref AbstractCamera::draw(). See
+         * @ref Drawable-culling "class documentation" for more information.
+         * @see @ref resetBoundingBox()
+         */
+        Drawable<dimensions, T>& setBoundingBox(const Math::Range<dimensions, T>& box) {
+            _boundingBox = box;
+            _hasBoundingBox = true;
+            return *this;
+        }
+
+        /**
+         * @brief Reset bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The drawable will be always drawn.
+         */
+        Drawable<dimensions, T>& resetBoundingBox() {
+            _boundingBox = {};
+            _hasBoundingBox = false;
+            return *this;
+        }
+
+        /** @brief Sort key */
+        UnsignedInt sortKey() const { return _sortKey; }
+
+        /**
+         * @brief Set sort key
+         * @return Reference to self (for method chaining)
+         *
+         * Used for sorting the drawables if camera draw order is other than
+         * @ref DrawOrder::Unsorted. See @ref Drawable-sorting "class documentation"
+         * for more information. Default is `0`.
+         */
+        Drawable<dimensions, T>& setSortKey(UnsignedInt key) {
+            _sortKey = key;
+            return *this;
+        }
+
         /**
          * @brief Draw the object using given camera
          * @param transformationMatrix      %Object transformation relative
@@ -152,6 +286,28 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * Projection matrix can be retrieved from AbstractCamera::projectionMatrix().
          */
         virtual void draw(const typename DimensionTraits<dimensions, T>::MatrixType& transformationMatrix, AbstractCamera<dimensions, T>& camera) = 0;
+
+    protected:
+        /**
+         * @brief Cache absolute transformation
+         *
+         * Stores the absolute transformation for use in
+         * @ref AbstractCamera::draw(). If you reimplement this function, call
+         * this implementation too. See @ref Drawable-caching "class documentation"
+         * for more information.
+         */
+        void clean(const typename DimensionTraits<dimensions, T>::MatrixType& absoluteTransformationMatrix) override {
+            _absoluteTransformationMatrix = absoluteTransformationMatrix;
+            _hasAbsoluteTransformationMatrix = true;
+        }
+
+    private:
+        friend class AbstractCamera<dimensions, T>;
+
+        typename DimensionTraits<dimensions, T>::MatrixType _absoluteTransformationMatrix;
+        Math::Range<dimensions, T> _boundingBox;
+        UnsignedInt _sortKey;
+        bool _hasBoundingBox, _hasAbsoluteTransformationMatrix;
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
@@ -48,7 +48,7 @@ template<UnsignedInt dimensions, class T> class AbstractFeatureGroup {
     virtual ~AbstractFeatureGroup();
 
     void add(AbstractFeature<dimensions, T>& feature);
-    void remove(AbstractFeature<dimensions, T>& feature);
+    void remove(std::size_t index);
 
     std::vector<AbstractFeature<dimensions, T>*> features;
 };
@@ -98,6 +98,7 @@ template<UnsignedInt dimensions, class Feature, class T> class FeatureGroup: pub
          * @return Reference to self (for method chaining)
          *
          * If the features is part of another group, it is removed from it.
+         * The feature is added to the end of the group. Done in constant time.
          * @see remove(), AbstractGroupedFeature::AbstractGroupedFeature()
          */
         FeatureGroup<dimensions, Feature, T>& add(Feature& feature);
@@ -106,10 +107,20 @@ template<UnsignedInt dimensions, class Feature, class T> class FeatureGroup: pub
          * @brief Remove feature from the group
          * @return Reference to self (for method chaining)
          *
-         * The feature must be part of the group.
+         * The feature must be part of the group. The last feature in the
+         * group is moved to place of the removed one, thus the removal is
+         * done in constant time, but the order of features is not preserved.
          * @see add()
          */
         FeatureGroup<dimensions, Feature, T>& remove(Feature& feature);
+
+    private:
+        /* Called after the feature is added to the group and before it is
+           removed from it, subclasses can override these to keep their own
+           bookkeeping consistent even if the group is modified through
+           reference to the base */
+        virtual void doAdd(Feature&) {}
+        virtual void doRemove(Feature&) {}
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
@@ -168,8 +179,10 @@ template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions
         feature._group->remove(feature);
 
     /* Crossreference the feature and group together */
+    feature._index = AbstractFeatureGroup<dimensions, T>::features.size();
     AbstractFeatureGroup<dimensions, T>::add(feature);
     feature._group = this;
+    doAdd(feature);
     return *this;
 }
 
@@ -177,7 +190,13 @@ template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions
     CORRADE_ASSERT(feature._group == this,
         "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group", *this);
 
-    AbstractFeatureGroup<dimensions, T>::remove(feature);
+    doRemove(feature);
+
+    /* Update index of the feature which was moved to its place */
+    AbstractFeatureGroup<dimensions, T>::remove(feature._index);
+    if(feature._index != size())
+        (*this)[feature._index]._index = feature._index;
+
     feature._group = nullptr;
     return *this;
 }
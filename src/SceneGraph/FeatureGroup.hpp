@@ -30,8 +30,6 @@
 
 #include "FeatureGroup.h"
 
-#include <algorithm>
-
 namespace Magnum { namespace SceneGraph {
 
 template<UnsignedInt dimensions, class T> AbstractFeatureGroup<dimensions, T>::AbstractFeatureGroup() = default;
@@ -41,8 +39,10 @@ template<UnsignedInt dimensions, class T> void AbstractFeatureGroup<dimensions,
     features.push_back(&feature);
 }
 
-template<UnsignedInt dimensions, class T> void AbstractFeatureGroup<dimensions, T>::remove(AbstractFeature<dimensions, T>& feature) {
-    features.erase(std::find(features.begin(), features.end(), &feature));
+template<UnsignedInt dimensions, class T> void AbstractFeatureGroup<dimensions, T>::remove(const std::size_t index) {
+    /* Move the last feature to place of removed one */
+    features[index] = features.back();
+    features.pop_back();
 }
 
 }}
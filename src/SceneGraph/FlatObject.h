@@ -0,0 +1,328 @@
+#ifndef Magnum_SceneGraph_FlatObject_h
+#define Magnum_SceneGraph_FlatObject_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::FlatObject
+ */
+
+#include "AbstractFeature.h"
+#include "AbstractObject.h"
+#include "AbstractTransformation.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief %Object with flat transformation storage
+
+Alternative to @ref Object for large, mostly static hierarchies. Instead of
+storing the transformation inline and computing absolute transformations by
+walking up the parent chain, all local transformations, parent indices and
+absolute transformations are stored in contiguous arrays owned by
+@ref FlatScene. The arrays are kept ordered so each parent is before its
+children, so updating absolute transformations of the whole hierarchy is one
+linear pass over them, which is done lazily when any absolute transformation
+is requested. New objects are appended at the end, the arrays are sorted
+again only when an object is reparented to an object after it or when
+enough objects were destroyed.
+
+The object is derived from @ref AbstractObject, so all features (such as
+@ref Drawable or @ref Camera3D "Camera") work with it the same way as with
+@ref Object. The transformation interface is reduced to @ref setTransformation()
+and @ref transform(), the @p Transformation template parameter is used only to
+specify underlying data type and the way how the transformations are composed.
+@code
+typedef SceneGraph::FlatScene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::FlatObject<SceneGraph::MatrixTransformation3D> Object3D;
+
+Scene3D scene;
+Object3D* o = new Object3D(scene);
+o->transform(Matrix4::translation(Vector3::yAxis(3.0f)));
+@endcode
+
+Unlike @ref Object, the object must always be part of some scene, i.e. it
+cannot be orphan and it cannot be moved to another scene. The hierarchy takes
+care of memory management the same way as @ref Object, see
+@ref scenegraph-object-construction-order for more information.
+
+@section FlatObject-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations you have to use @ref FlatObject.hpp
+implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref DualComplexTransformation "FlatObject<DualComplexTransformation>"
+-   @ref DualQuaternionTransformation "FlatObject<DualQuaternionTransformation>"
+-   @ref MatrixTransformation2D "FlatObject<MatrixTransformation2D>"
+-   @ref MatrixTransformation3D "FlatObject<MatrixTransformation3D>"
+-   @ref RigidMatrixTransformation2D "FlatObject<RigidMatrixTransformation2D>"
+-   @ref RigidMatrixTransformation3D "FlatObject<RigidMatrixTransformation3D>"
+-   @ref TranslationTransformation2D "FlatObject<TranslationTransformation2D>"
+-   @ref TranslationTransformation3D "FlatObject<TranslationTransformation3D>"
+
+@see @ref FlatScene, @ref Object
+*/
+template<class Transformation> class FlatObject: public AbstractObject<Transformation::Dimensions, typename Transformation::Type>
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , private Containers::LinkedList<FlatObject<Transformation>>, private Containers::LinkedListItem<FlatObject<Transformation>, FlatObject<Transformation>>
+    #endif
+{
+    friend class Containers::LinkedList<FlatObject<Transformation>>;
+    friend class Containers::LinkedListItem<FlatObject<Transformation>, FlatObject<Transformation>>;
+    friend class FlatScene<Transformation>;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    FlatObject(const FlatObject<Transformation>&) = delete;
+    FlatObject(FlatObject<Transformation>&&) = delete;
+    FlatObject<Transformation>& operator=(const FlatObject<Transformation>&) = delete;
+    FlatObject<Transformation>& operator=(FlatObject<Transformation>&&) = delete;
+    #endif
+
+    public:
+        /** @brief Matrix type */
+        typedef typename DimensionTraits<Transformation::Dimensions, typename Transformation::Type>::MatrixType MatrixType;
+
+        /** @brief Underlying transformation type */
+        typedef typename Transformation::DataType DataType;
+
+        /**
+         * @brief Constructor
+         * @param parent    Parent object
+         *
+         * The object is added to the scene of @p parent with identity
+         * transformation.
+         */
+        explicit FlatObject(FlatObject<Transformation>& parent);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes itself from parent's children list and destroys all own
+         * children.
+         */
+        ~FlatObject();
+
+        /**
+         * @{ @name Scene hierarchy
+         *
+         * See @ref scenegraph-hierarchy for more information.
+         */
+
+        /** @brief %Scene containing this object */
+        FlatScene<Transformation>* scene() { return _scene; }
+        const FlatScene<Transformation>* scene() const { return _scene; } /**< @overload */
+
+        /** @brief Parent object or `nullptr`, if this is the scene */
+        FlatObject<Transformation>* parent() {
+            return Containers::LinkedListItem<FlatObject<Transformation>, FlatObject<Transformation>>::list();
+        }
+
+        /** @overload */
+        const FlatObject<Transformation>* parent() const {
+            return Containers::LinkedListItem<FlatObject<Transformation>, FlatObject<Transformation>>::list();
+        }
+
+        /** @brief Previous sibling object or `nullptr`, if this is first object */
+        FlatObject<Transformation>* previousSibling() {
+            return Containers::LinkedListItem<FlatObject<Transformation>, FlatObject<Transformation>>::previous();
+        }
+
+        /** @overload */
+        const FlatObject<Transformation>* previousSibling() const {
+            return Containers::LinkedListItem<FlatObject<Transformation>, FlatObject<Transformation>>::previous();
+        }
+
+        /** @brief Next sibling object or `nullptr`, if this is last object */
+        FlatObject<Transformation>* nextSibling() {
+            return Containers::LinkedListItem<FlatObject<Transformation>, FlatObject<Transformation>>::next();
+        }
+
+        /** @overload */
+        const FlatObject<Transformation>* nextSibling() const {
+            return Containers::LinkedListItem<FlatObject<Transformation>, FlatObject<Transformation>>::next();
+        }
+
+        /** @brief Whether this object has children */
+        bool hasChildren() const {
+            return !Containers::LinkedList<FlatObject<Transformation>>::isEmpty();
+        }
+
+        /** @brief First child object or `nullptr`, if this object has no children */
+        FlatObject<Transformation>* firstChild() {
+            return Containers::LinkedList<FlatObject<Transformation>>::first();
+        }
+
+        /** @overload */
+        const FlatObject<Transformation>* firstChild() const {
+            return Containers::LinkedList<FlatObject<Transformation>>::first();
+        }
+
+        /** @brief Last child object or `nullptr`, if this object has no children */
+        FlatObject<Transformation>* lastChild() {
+            return Containers::LinkedList<FlatObject<Transformation>>::last();
+        }
+
+        /** @overload */
+        const FlatObject<Transformation>* lastChild() const {
+            return Containers::LinkedList<FlatObject<Transformation>>::last();
+        }
+
+        /**
+         * @brief Set parent object
+         * @return Reference to self (for method chaining)
+         *
+         * The parent must be part of the same scene. Setting parent of the
+         * scene or parenting the object to its own child is ignored.
+         */
+        FlatObject<Transformation>& setParent(FlatObject<Transformation>& parent);
+
+        /*@}*/
+
+        /** @{ @name Object transformation */
+
+        /** @brief Object transformation */
+        DataType transformation() const;
+
+        /**
+         * @brief Set transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Setting transformation of the scene is ignored.
+         */
+        FlatObject<Transformation>& setTransformation(const DataType& transformation);
+
+        /**
+         * @brief Reset transformation
+         * @return Reference to self (for method chaining)
+         */
+        FlatObject<Transformation>& resetTransformation() {
+            return setTransformation({});
+        }
+
+        /**
+         * @brief Multiply transformation
+         * @param transformation    Transformation
+         * @param type              Transformation type
+         * @return Reference to self (for method chaining)
+         */
+        FlatObject<Transformation>& transform(const DataType& transformation, TransformationType type = TransformationType::Global);
+
+        /**
+         * @brief Transformation matrix
+         *
+         * @see @ref transformation()
+         */
+        MatrixType transformationMatrix() const;
+
+        /**
+         * @brief Transformation relative to the scene
+         *
+         * Updates absolute transformations in the scene, if needed.
+         * @see @ref absoluteTransformationMatrix(), @ref FlatScene::update()
+         */
+        DataType absoluteTransformation() const;
+
+        /**
+         * @brief Transformation matrix relative to the scene
+         *
+         * @see @ref absoluteTransformation()
+         */
+        MatrixType absoluteTransformationMatrix() const;
+
+        /**
+         * @brief Transformations of given group of objects relative to this object
+         *
+         * All objects must be part of the same scene as this object. All
+         * transformations are premultiplied with @p initialTransformation,
+         * if specified.
+         * @see @ref transformationMatrices()
+         */
+        std::vector<DataType> transformations(const std::vector<FlatObject<Transformation>*>& objects, const DataType& initialTransformation = DataType()) const;
+
+        /**
+         * @brief Transformation matrices of given group of objects relative to this object
+         *
+         * @see @ref transformations()
+         */
+        std::vector<MatrixType> transformationMatrices(const std::vector<FlatObject<Transformation>*>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
+        /*@}*/
+
+        /**
+         * @{ @name Transformation caching
+         *
+         * See @ref scenegraph-caching for more information.
+         */
+
+        /** @copydoc AbstractObject::isDirty() */
+        bool isDirty() const { return _dirty; }
+
+        /** @copydoc AbstractObject::setDirty() */
+        void setDirty();
+
+        /** @copydoc AbstractObject::setClean() */
+        void setClean();
+
+        /*@}*/
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    public:
+        virtual bool isScene() const { return false; }
+    #endif
+
+    private:
+        /* Used by FlatScene */
+        explicit FlatObject(FlatScene<Transformation>* scene);
+
+        AbstractObject<Transformation::Dimensions, typename Transformation::Type>* doScene() override final;
+        const AbstractObject<Transformation::Dimensions, typename Transformation::Type>* doScene() const override final;
+
+        MatrixType MAGNUM_SCENEGRAPH_LOCAL doTransformationMatrix() const override final {
+            return transformationMatrix();
+        }
+        MatrixType MAGNUM_SCENEGRAPH_LOCAL doAbsoluteTransformationMatrix() const override final {
+            return absoluteTransformationMatrix();
+        }
+
+        std::vector<MatrixType> doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix, UnsignedInt) const override final;
+
+        bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
+        void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
+        void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
+        void doSetClean(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects) override final;
+
+        void MAGNUM_SCENEGRAPH_LOCAL setClean(const DataType& absoluteTransformation);
+
+        FlatScene<Transformation>* _scene;
+        UnsignedInt _index;
+        bool _dirty;
+};
+
+}}
+
+#endif
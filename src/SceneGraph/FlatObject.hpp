@@ -0,0 +1,307 @@
+#ifndef Magnum_SceneGraph_FlatObject_hpp
+#define Magnum_SceneGraph_FlatObject_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FlatObject.h and @ref FlatScene.h
+ */
+
+#include "FlatObject.h"
+#include "FlatScene.h"
+
+#include <algorithm>
+
+namespace Magnum { namespace SceneGraph {
+
+template<class Transformation> FlatObject<Transformation>::FlatObject(FlatScene<Transformation>* scene): _scene(scene), _index(0), _dirty(true) {}
+
+template<class Transformation> FlatObject<Transformation>::FlatObject(FlatObject<Transformation>& parent): _scene(parent._scene), _dirty(true) {
+    _index = _scene->_objects.size();
+    _scene->_transformations.push_back({});
+    _scene->_absoluteTransformations.push_back({});
+    _scene->_parents.push_back(parent._index);
+    _scene->_objects.push_back(this);
+
+    /* Appended object is always after its parent, so the order stays valid,
+       only its absolute transformation needs to be computed */
+    _scene->_firstDirty = std::min(_scene->_firstDirty, std::size_t(_index));
+
+    parent.Containers::template LinkedList<FlatObject<Transformation>>::insert(this);
+}
+
+template<class Transformation> FlatObject<Transformation>::~FlatObject() {
+    /* Free the slot in scene storage, it will be removed on next reorder,
+       which is forced only if the freed slots take up too much of the
+       storage. Skipped for the scene itself (which is always at index 0), as
+       its storage is already destroyed at this point. */
+    if(_index == 0) return;
+    _scene->_objects[_index] = nullptr;
+    if(4*++_scene->_freedCount > _scene->_objects.size())
+        _scene->_orderDirty = true;
+}
+
+template<class Transformation> AbstractObject<Transformation::Dimensions, typename Transformation::Type>* FlatObject<Transformation>::doScene() {
+    return _scene;
+}
+
+template<class Transformation> const AbstractObject<Transformation::Dimensions, typename Transformation::Type>* FlatObject<Transformation>::doScene() const {
+    return _scene;
+}
+
+template<class Transformation> FlatObject<Transformation>& FlatObject<Transformation>::setParent(FlatObject<Transformation>& parent) {
+    CORRADE_ASSERT(parent._scene == _scene,
+        "SceneGraph::FlatObject::setParent(): the parent must be in the same scene", *this);
+
+    /* Skip if parent is already parent or this is scene (which cannot have parent) */
+    if(this->parent() == &parent || isScene()) return *this;
+
+    /* Object cannot be parented to its child */
+    for(FlatObject<Transformation>* p = &parent; p; p = p->parent())
+        if(p == this) return *this;
+
+    this->parent()->Containers::template LinkedList<FlatObject<Transformation>>::cut(this);
+    parent.Containers::template LinkedList<FlatObject<Transformation>>::insert(this);
+
+    /* Resort the arrays on next update only if the new parent is after
+       this object in the storage */
+    _scene->_parents[_index] = parent._index;
+    _scene->_firstDirty = std::min(_scene->_firstDirty, std::size_t(_index));
+    if(parent._index > _index) _scene->_orderDirty = true;
+
+    setDirty();
+    return *this;
+}
+
+template<class Transformation> typename Transformation::DataType FlatObject<Transformation>::transformation() const {
+    return _scene->_transformations[_index];
+}
+
+template<class Transformation> FlatObject<Transformation>& FlatObject<Transformation>::setTransformation(const DataType& transformation) {
+    /* Setting transformation is forbidden for the scene */
+    if(isScene()) return *this;
+
+    _scene->_transformations[_index] = transformation;
+    _scene->_firstDirty = std::min(_scene->_firstDirty, std::size_t(_index));
+    setDirty();
+    return *this;
+}
+
+template<class Transformation> FlatObject<Transformation>& FlatObject<Transformation>::transform(const DataType& transformation, TransformationType type) {
+    return setTransformation(type == TransformationType::Global ?
+        Implementation::Transformation<Transformation>::compose(transformation, this->transformation()) :
+        Implementation::Transformation<Transformation>::compose(this->transformation(), transformation));
+}
+
+template<class Transformation> auto FlatObject<Transformation>::transformationMatrix() const -> MatrixType {
+    return Implementation::Transformation<Transformation>::toMatrix(transformation());
+}
+
+template<class Transformation> typename Transformation::DataType FlatObject<Transformation>::absoluteTransformation() const {
+    _scene->update();
+    return _scene->_absoluteTransformations[_index];
+}
+
+template<class Transformation> auto FlatObject<Transformation>::absoluteTransformationMatrix() const -> MatrixType {
+    return Implementation::Transformation<Transformation>::toMatrix(absoluteTransformation());
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> FlatObject<Transformation>::transformations(const std::vector<FlatObject<Transformation>*>& objects, const DataType& initialTransformation) const {
+    _scene->update();
+
+    /* Transformation of this object is the base, unless this is the scene */
+    const DataType base = isScene() ? initialTransformation :
+        Implementation::Transformation<Transformation>::compose(initialTransformation,
+            Implementation::Transformation<Transformation>::inverted(_scene->_absoluteTransformations[_index]));
+
+    std::vector<DataType> transformations(objects.size());
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        CORRADE_ASSERT(objects[i]->_scene == _scene,
+            "SceneGraph::FlatObject::transformations(): the objects are not part of the same scene", {});
+        transformations[i] = Implementation::Transformation<Transformation>::compose(base, _scene->_absoluteTransformations[objects[i]->_index]);
+    }
+
+    return transformations;
+}
+
+template<class Transformation> auto FlatObject<Transformation>::transformationMatrices(const std::vector<FlatObject<Transformation>*>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+    const std::vector<DataType> transformations = this->transformations(objects, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+    std::vector<MatrixType> transformationMatrices(transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+
+    return transformationMatrices;
+}
+
+template<class Transformation> auto FlatObject<Transformation>::doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix, UnsignedInt) const -> std::vector<MatrixType> {
+    std::vector<FlatObject<Transformation>*> castObjects(objects.size());
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        /** @todo Ensure this doesn't crash, somehow */
+        castObjects[i] = static_cast<FlatObject<Transformation>*>(objects[i]);
+
+    return transformationMatrices(castObjects, initialTransformationMatrix);
+}
+
+template<class Transformation> void FlatObject<Transformation>::setDirty() {
+    /* The transformation of this object (and all children) is already dirty,
+       nothing to do */
+    if(_dirty) return;
+
+    /* Iterate instead of recursing, as the hierarchies might be deep */
+    std::vector<FlatObject<Transformation>*> objects{this};
+    while(!objects.empty()) {
+        FlatObject<Transformation>* o = objects.back();
+        objects.pop_back();
+        if(o->_dirty) continue;
+
+        /* Make all features dirty */
+        for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = o->firstFeature(); i; i = i->nextFeature())
+            i->markDirty();
+
+        /* Make all children dirty */
+        for(FlatObject<Transformation>* i = o->firstChild(); i; i = i->nextSibling())
+            objects.push_back(i);
+
+        o->_dirty = true;
+    }
+}
+
+template<class Transformation> void FlatObject<Transformation>::setClean() {
+    /* The object (and all its parents) are already clean, nothing to do */
+    if(!_dirty) return;
+
+    /* Collect all dirty parents */
+    std::vector<FlatObject<Transformation>*> objects;
+    for(FlatObject<Transformation>* p = this; p && p->_dirty; p = p->parent())
+        objects.push_back(p);
+
+    /* Clean them going down from the topmost one, the absolute
+       transformations are already computed */
+    _scene->update();
+    for(auto it = objects.rbegin(); it != objects.rend(); ++it)
+        (*it)->setClean(_scene->_absoluteTransformations[(*it)->_index]);
+}
+
+template<class Transformation> void FlatObject<Transformation>::doSetClean(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects) {
+    /* All absolute transformations are computed in one pass, so there's
+       nothing to gain from processing the objects in bulk */
+    for(auto o: objects) static_cast<FlatObject<Transformation>*>(o)->setClean();
+}
+
+template<class Transformation> void FlatObject<Transformation>::setClean(const DataType& absoluteTransformation) {
+    /* "Lazy storage" for transformation matrix and inverted transformation matrix */
+    CachedTransformations cached;
+    MatrixType matrix, invertedMatrix;
+
+    /* Clean all features */
+    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = this->firstFeature(); i; i = i->nextFeature()) {
+        /* Cached absolute transformation, compute it if it wasn't
+            computed already */
+        if(i->cachedTransformations() & CachedTransformation::Absolute) {
+            if(!(cached & CachedTransformation::Absolute)) {
+                cached |= CachedTransformation::Absolute;
+                matrix = Implementation::Transformation<Transformation>::toMatrix(absoluteTransformation);
+            }
+
+            i->clean(matrix);
+        }
+
+        /* Cached inverse absolute transformation, compute it if it wasn't
+            computed already */
+        if(i->cachedTransformations() & CachedTransformation::InvertedAbsolute) {
+            if(!(cached & CachedTransformation::InvertedAbsolute)) {
+                cached |= CachedTransformation::InvertedAbsolute;
+                invertedMatrix = Implementation::Transformation<Transformation>::toMatrix(
+                    Implementation::Transformation<Transformation>::inverted(absoluteTransformation));
+            }
+
+            i->cleanInverted(invertedMatrix);
+        }
+    }
+
+    /* Mark object as clean */
+    _dirty = false;
+}
+
+template<class Transformation> FlatScene<Transformation>::FlatScene(): FlatObject<Transformation>(this), _transformations(1), _absoluteTransformations(1), _parents(1, 0), _objects(1, this), _firstDirty(1), _freedCount(0), _orderDirty(false) {}
+
+template<class Transformation> FlatScene<Transformation>::~FlatScene() {
+    /* Destroy all children while the storage is still alive */
+    this->Containers::template LinkedList<FlatObject<Transformation>>::clear();
+}
+
+template<class Transformation> std::size_t FlatScene<Transformation>::objectCount() const {
+    return _objects.size() - _freedCount;
+}
+
+template<class Transformation> void FlatScene<Transformation>::update() const {
+    if(_orderDirty) reorder();
+
+    /* Parent is always before its children, so all parent absolute
+       transformations are up-to-date when computing the child. The scene
+       at index 0 has always identity transformation. */
+    for(std::size_t i = std::max(_firstDirty, std::size_t(1)); i < _transformations.size(); ++i)
+        _absoluteTransformations[i] = Implementation::Transformation<Transformation>::compose(_absoluteTransformations[_parents[i]], _transformations[i]);
+
+    _firstDirty = _transformations.size();
+}
+
+template<class Transformation> void FlatScene<Transformation>::reorder() const {
+    /* Gather all live objects in depth-first order */
+    std::vector<FlatObject<Transformation>*> objects;
+    objects.reserve(_objects.size());
+    std::vector<const FlatObject<Transformation>*> stack{this};
+    while(!stack.empty()) {
+        FlatObject<Transformation>* o = const_cast<FlatObject<Transformation>*>(stack.back());
+        stack.pop_back();
+        objects.push_back(o);
+
+        /* Push children in reverse, so the first one is processed first */
+        for(FlatObject<Transformation>* i = o->lastChild(); i; i = i->previousSibling())
+            stack.push_back(i);
+    }
+
+    /* Permute the storage. Parent is always processed before its children,
+       so its index is already updated when processing the child. */
+    std::vector<typename Transformation::DataType> transformations(objects.size());
+    std::vector<UnsignedInt> parents(objects.size());
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        FlatObject<Transformation>* o = objects[i];
+        transformations[i] = _transformations[o->_index];
+        o->_index = i;
+        parents[i] = o->parent() ? o->parent()->_index : 0;
+    }
+
+    std::swap(transformations, _transformations);
+    std::swap(parents, _parents);
+    std::swap(objects, _objects);
+    _absoluteTransformations.resize(_objects.size());
+    _firstDirty = 0;
+    _freedCount = 0;
+    _orderDirty = false;
+}
+
+}}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef Magnum_SceneGraph_FlatScene_h
+#define Magnum_SceneGraph_FlatScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::FlatScene
+ */
+
+#include "FlatObject.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief %Scene with flat transformation storage
+
+Root of @ref FlatObject hierarchy, owning contiguous arrays with local and
+absolute transformations of all objects in the hierarchy. See @ref FlatObject
+for more information.
+*/
+template<class Transformation> class FlatScene: public FlatObject<Transformation> {
+    friend class FlatObject<Transformation>;
+
+    public:
+        explicit FlatScene();
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all objects in the hierarchy.
+         */
+        ~FlatScene();
+
+        /**
+         * @brief Count of objects in the hierarchy
+         *
+         * Includes also the scene itself.
+         */
+        std::size_t objectCount() const;
+
+        /**
+         * @brief Update absolute transformations
+         *
+         * If some object was reparented to an object after it in the arrays
+         * or too many objects were destroyed since last update, the
+         * transformation arrays are first sorted in depth-first order. New
+         * objects are appended after their parents, thus they don't need the
+         * arrays to be sorted. Then absolute
+         * transformations of all objects affected by transformation changes
+         * are recomputed in one linear pass. Called implicitly when any
+         * absolute transformation is requested, so you don't need to call
+         * this function unless you want to control when the update happens.
+         */
+        void update() const;
+
+    private:
+        bool isScene() const override final { return true; }
+
+        void MAGNUM_SCENEGRAPH_LOCAL reorder() const;
+
+        /* Storage indexed with FlatObject::_index, index 0 is the scene
+           itself. Mutable, because the update is done lazily from const
+           getters. */
+        mutable std::vector<typename Transformation::DataType> _transformations;
+        mutable std::vector<typename Transformation::DataType> _absoluteTransformations;
+        mutable std::vector<UnsignedInt> _parents;
+        mutable std::vector<FlatObject<Transformation>*> _objects;
+
+        /* First object which needs to have its absolute transformation
+           recomputed */
+        mutable std::size_t _firstDirty;
+
+        /* Count of slots of destroyed objects, removed on next reorder */
+        mutable std::size_t _freedCount;
+        mutable bool _orderDirty;
+};
+
+}}
+
+#endif
@@ -0,0 +1,366 @@
+#ifndef Magnum_SceneGraph_FramePacket_h
+#define Magnum_SceneGraph_FramePacket_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::FramePacket, Magnum::SceneGraph::FramePacketBuffer, alias Magnum::SceneGraph::BasicFramePacket2D, Magnum::SceneGraph::BasicFramePacket3D, Magnum::SceneGraph::BasicFramePacketBuffer2D, Magnum::SceneGraph::BasicFramePacketBuffer3D, typedef Magnum::SceneGraph::FramePacket2D, Magnum::SceneGraph::FramePacket3D, Magnum::SceneGraph::FramePacketBuffer2D, Magnum::SceneGraph::FramePacketBuffer3D
+ */
+
+#include <atomic>
+#include <vector>
+
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+#include "DimensionTraits.h"
+#include "SceneGraph.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Frame packet
+
+Immutable snapshot of everything needed for drawing one frame with given
+camera -- projection and camera matrix and list of visible drawables in draw
+order together with their transformations relative to the camera. Created by
+@ref AbstractCamera::snapshot(), usually through @ref FramePacketBuffer. See
+its documentation for more information.
+
+@see @ref scenegraph, @ref BasicFramePacket2D, @ref BasicFramePacket3D,
+    @ref FramePacket2D, @ref FramePacket3D
+*/
+template<UnsignedInt dimensions, class T> class FramePacket {
+    friend class AbstractCamera<dimensions, T>;
+    friend class FramePacketBuffer<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates empty packet.
+         */
+        explicit FramePacket(): _camera(nullptr), _frame(0) {}
+
+        /**
+         * @brief Frame number
+         *
+         * Numbered from `1` by @ref FramePacketBuffer, `0` if the packet
+         * wasn't published through any buffer.
+         */
+        UnsignedLong frame() const { return _frame; }
+
+        /**
+         * @brief Camera
+         *
+         * Camera which created the packet or `nullptr` if the packet is
+         * empty.
+         */
+        AbstractCamera<dimensions, T>* camera() const { return _camera; }
+
+        /** @brief Projection matrix at the time of snapshot */
+        typename DimensionTraits<dimensions, T>::MatrixType projectionMatrix() const {
+            return _projectionMatrix;
+        }
+
+        /** @brief Camera matrix at the time of snapshot */
+        typename DimensionTraits<dimensions, T>::MatrixType cameraMatrix() const {
+            return _cameraMatrix;
+        }
+
+        /** @brief Count of drawables in the packet */
+        std::size_t size() const { return _drawables.size(); }
+
+        /** @brief Visible drawables in draw order */
+        const std::vector<Drawable<dimensions, T>*>& drawables() const {
+            return _drawables;
+        }
+
+        /**
+         * @brief Drawable transformations
+         *
+         * Transformations of the drawables relative to camera, in the same
+         * order as @ref drawables().
+         */
+        const std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& transformationMatrices() const {
+            return _transformationMatrices;
+        }
+
+        /**
+         * @brief Draw the packet
+         *
+         * Calls @ref Drawable::draw() on all drawables with transformations
+         * from the packet. The drawables get the live camera as parameter,
+         * use @ref projectionMatrix() of the packet instead of the camera one
+         * if the projection can change while drawing.
+         */
+        void draw() const;
+
+    private:
+        AbstractCamera<dimensions, T>* _camera;
+        UnsignedLong _frame;
+        typename DimensionTraits<dimensions, T>::MatrixType _projectionMatrix, _cameraMatrix;
+        std::vector<Drawable<dimensions, T>*> _drawables;
+        std::vector<typename DimensionTraits<dimensions, T>::MatrixType> _transformationMatrices;
+};
+
+/**
+@brief Triple-buffered frame packets
+
+Allows to simulate next frame on one thread while the previous one is drawn
+on another. The simulation thread modifies the scene and at the end of each
+frame calls @ref publish(), which stores snapshot of the scene as seen by
+given camera. The render thread calls @ref acquire() to get the newest
+published packet and draws it, while the simulation continues with the live
+scene:
+@code
+SceneGraph::FramePacketBuffer3D packets;
+
+// Simulation thread
+for(;;) {
+    updateGameplay();
+    packets.publish(camera, drawables);
+}
+
+// Render thread
+for(;;) {
+    const SceneGraph::FramePacket3D* packet = packets.acquire();
+    if(packet) packet->draw();
+    swapBuffers();
+}
+@endcode
+
+The buffer holds three packets -- one being written by the simulation thread,
+one being read by the render thread and one with the newest complete frame.
+Neither thread waits for the other, if the simulation is faster, some frames
+are never drawn, if the rendering is faster, the same frame is drawn again.
+The memory of the packets is reused, so after a few frames no allocations
+are done.
+
+The buffer is meant for exactly one producer and one consumer thread. The
+packet returned by @ref acquire() is valid until next call to @ref acquire().
+Similarly, the drawables shouldn't change state used in @ref Drawable::draw()
+without synchronization.
+
+@section FramePacketBuffer-deletion Deleting drawables
+
+The packets contain only pointers to drawables and the consumer can hold and
+draw one packet for arbitrary number of published frames, so the simulation
+thread must not delete drawables which can be still referenced by any packet
+not yet released by the consumer. Remove the drawable from the group first
+and remember value of @ref publishedCount() at that time, no packet published
+afterwards references it. The drawable can be safely deleted when
+@ref acquiredFrame() is larger than the remembered value, as the consumer
+then finished drawing all older packets and will never acquire them again:
+@code
+std::deque<std::pair<UnsignedLong, SceneGraph::Drawable3D*>> pending;
+
+// Simulation thread
+drawables.remove(*drawable);
+pending.emplace_back(packets.publishedCount(), drawable);
+// ...
+packets.publish(camera, drawables);
+while(!pending.empty() && packets.acquiredFrame() > pending.front().first) {
+    delete pending.front().second;
+    pending.pop_front();
+}
+@endcode
+
+If the render thread stops acquiring new packets, the drawables are never
+released, delete them only after the render thread finished.
+@see @ref scenegraph, @ref BasicFramePacketBuffer2D,
+    @ref BasicFramePacketBuffer3D, @ref FramePacketBuffer2D,
+    @ref FramePacketBuffer3D
+*/
+template<UnsignedInt dimensions, class T> class FramePacketBuffer {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates buffer with no published packet.
+         */
+        explicit FramePacketBuffer();
+
+        /** @brief Copying is not allowed */
+        FramePacketBuffer(const FramePacketBuffer<dimensions, T>&) = delete;
+
+        /** @brief Copying is not allowed */
+        FramePacketBuffer<dimensions, T>& operator=(const FramePacketBuffer<dimensions, T>&) = delete;
+
+        /**
+         * @brief Count of published frames
+         *
+         * Can be called only from the producer thread.
+         */
+        UnsignedLong publishedCount() const { return _frame; }
+
+        /**
+         * @brief Frame number of last acquired packet
+         *
+         * Number of frame returned by last call to @ref acquire(), `0` if
+         * no packet was acquired yet. All packets with lower frame number
+         * were already released by the consumer. Can be called from any
+         * thread. See @ref FramePacketBuffer-deletion for an example.
+         */
+        UnsignedLong acquiredFrame() const {
+            return _acquiredFrame.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Publish new frame
+         *
+         * Creates snapshot of given group using @ref AbstractCamera::snapshot()
+         * and makes it available to the consumer thread. Must be called from
+         * the producer thread.
+         */
+        void publish(AbstractCamera<dimensions, T>& camera, DrawableGroup<dimensions, T>& group);
+
+        /**
+         * @brief Acquire newest frame
+         *
+         * Returns the newest published packet or `nullptr` if no packet was
+         * published yet. If no new packet was published since last call,
+         * returns the same packet again. The packet is valid until next call
+         * to this function, which also releases it. Must be called from the
+         * consumer thread.
+         * @see @ref acquiredFrame()
+         */
+        const FramePacket<dimensions, T>* acquire();
+
+    private:
+        /* Bit set in _ready when it contains packet not yet acquired */
+        enum: UnsignedInt { Fresh = 4, IndexMask = 3 };
+
+        FramePacket<dimensions, T> _packets[3];
+        std::atomic<UnsignedInt> _ready;
+        std::atomic<UnsignedLong> _acquiredFrame;
+        UnsignedInt _write, _read;
+        UnsignedLong _frame;
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Frame packet for two-dimensional scenes
+
+Convenience alternative to <tt>%FramePacket<2, T></tt>. See FramePacket for
+more information.
+@note Not available on GCC < 4.7. Use <tt>%FramePacket<2, T></tt> instead.
+@see @ref FramePacket2D, @ref BasicFramePacket3D
+*/
+template<class T> using BasicFramePacket2D = FramePacket<2, T>;
+#endif
+
+/**
+@brief Frame packet for two-dimensional float scenes
+
+@see @ref FramePacket3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicFramePacket2D<Float> FramePacket2D;
+#else
+typedef FramePacket<2, Float> FramePacket2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Frame packet for three-dimensional scenes
+
+Convenience alternative to <tt>%FramePacket<3, T></tt>. See FramePacket for
+more information.
+@note Not available on GCC < 4.7. Use <tt>%FramePacket<3, T></tt> instead.
+@see @ref FramePacket3D, @ref BasicFramePacket2D
+*/
+template<class T> using BasicFramePacket3D = FramePacket<3, T>;
+#endif
+
+/**
+@brief Frame packet for three-dimensional float scenes
+
+@see @ref FramePacket2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicFramePacket3D<Float> FramePacket3D;
+#else
+typedef FramePacket<3, Float> FramePacket3D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Frame packet buffer for two-dimensional scenes
+
+Convenience alternative to <tt>%FramePacketBuffer<2, T></tt>. See
+FramePacketBuffer for more information.
+@note Not available on GCC < 4.7. Use <tt>%FramePacketBuffer<2, T></tt>
+    instead.
+@see @ref FramePacketBuffer2D, @ref BasicFramePacketBuffer3D
+*/
+template<class T> using BasicFramePacketBuffer2D = FramePacketBuffer<2, T>;
+#endif
+
+/**
+@brief Frame packet buffer for two-dimensional float scenes
+
+@see @ref FramePacketBuffer3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicFramePacketBuffer2D<Float> FramePacketBuffer2D;
+#else
+typedef FramePacketBuffer<2, Float> FramePacketBuffer2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Frame packet buffer for three-dimensional scenes
+
+Convenience alternative to <tt>%FramePacketBuffer<3, T></tt>. See
+FramePacketBuffer for more information.
+@note Not available on GCC < 4.7. Use <tt>%FramePacketBuffer<3, T></tt>
+    instead.
+@see @ref FramePacketBuffer3D, @ref BasicFramePacketBuffer2D
+*/
+template<class T> using BasicFramePacketBuffer3D = FramePacketBuffer<3, T>;
+#endif
+
+/**
+@brief Frame packet buffer for three-dimensional float scenes
+
+@see @ref FramePacketBuffer2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicFramePacketBuffer3D<Float> FramePacketBuffer3D;
+#else
+typedef FramePacketBuffer<3, Float> FramePacketBuffer3D;
+#endif
+
+#ifdef CORRADE_TARGET_WINDOWS
+extern template class MAGNUM_SCENEGRAPH_EXPORT FramePacket<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FramePacket<3, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FramePacketBuffer<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FramePacketBuffer<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef Magnum_SceneGraph_FramePacket_hpp
+#define Magnum_SceneGraph_FramePacket_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FramePacket.h
+ */
+
+#include "AbstractCamera.hpp"
+#include "FramePacket.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> void FramePacket<dimensions, T>::draw() const {
+    for(std::size_t i = 0; i != _drawables.size(); ++i)
+        _drawables[i]->draw(_transformationMatrices[i], *_camera);
+}
+
+template<UnsignedInt dimensions, class T> FramePacketBuffer<dimensions, T>::FramePacketBuffer(): _ready(1), _acquiredFrame(0), _write(0), _read(2), _frame(0) {}
+
+template<UnsignedInt dimensions, class T> void FramePacketBuffer<dimensions, T>::publish(AbstractCamera<dimensions, T>& camera, DrawableGroup<dimensions, T>& group) {
+    FramePacket<dimensions, T>& packet = _packets[_write];
+    camera.snapshot(group, packet);
+    packet._frame = ++_frame;
+
+    /* Swap the written packet with the ready one, the release makes the
+       packet contents visible to the consumer */
+    _write = _ready.exchange(_write|Fresh, std::memory_order_acq_rel) & IndexMask;
+}
+
+template<UnsignedInt dimensions, class T> const FramePacket<dimensions, T>* FramePacketBuffer<dimensions, T>::acquire() {
+    /* Swap the read packet with the ready one, if there is newer one */
+    if(_ready.load(std::memory_order_relaxed) & Fresh) {
+        _read = _ready.exchange(_read, std::memory_order_acq_rel) & IndexMask;
+
+        /* The previous packet is released, the release makes all reads of
+           it happen before the producer deletes drawables based on this */
+        _acquiredFrame.store(_packets[_read]._frame, std::memory_order_release);
+    }
+
+    return _packets[_read]._frame ? &_packets[_read] : nullptr;
+}
+
+}}
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef Magnum_SceneGraph_InstancedDrawable_h
+#define Magnum_SceneGraph_InstancedDrawable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::InstancedDrawable, Magnum::SceneGraph::InstancedDrawableGroup, alias Magnum::SceneGraph::BasicInstancedDrawable2D, Magnum::SceneGraph::BasicInstancedDrawable3D, Magnum::SceneGraph::BasicInstancedDrawableGroup2D, Magnum::SceneGraph::BasicInstancedDrawableGroup3D, typedef Magnum::SceneGraph::InstancedDrawable2D, Magnum::SceneGraph::InstancedDrawable3D, Magnum::SceneGraph::InstancedDrawableGroup2D, Magnum::SceneGraph::InstancedDrawableGroup3D
+ */
+
+#include <vector>
+
+#include "Drawable.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Instanced drawable
+
+%Drawable which is not drawn separately, but together with all other visible
+drawables from the same @ref InstancedDrawableGroup in single instanced draw
+call. Useful for many objects sharing the same mesh and shader, see
+@ref InstancedDrawableGroup for more information.
+
+Bounding box and sort key work the same as for @ref Drawable, the
+transformation of each visible drawable is then passed to the group at
+position given by the draw order. The drawable has no drawing code on its
+own, thus it can be drawn only as part of @ref InstancedDrawableGroup, drawing
+it as part of @ref DrawableGroup is an error.
+@see @ref scenegraph, @ref BasicInstancedDrawable2D,
+    @ref BasicInstancedDrawable3D, @ref InstancedDrawable2D,
+    @ref InstancedDrawable3D
+*/
+template<UnsignedInt dimensions, class T> class InstancedDrawable: public Drawable<dimensions, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    %Object this drawable belongs to
+         * @param drawables Group this drawable belongs to
+         *
+         * Adds the feature to the object and also to the group, if specified.
+         * Otherwise you can use InstancedDrawableGroup::add().
+         */
+        explicit InstancedDrawable(AbstractObject<dimensions, T>& object, InstancedDrawableGroup<dimensions, T>* drawables = nullptr);
+
+    private:
+        /* Never called for drawables in InstancedDrawableGroup, the whole
+           group is drawn at once */
+        void draw(const typename DimensionTraits<dimensions, T>::MatrixType&, AbstractCamera<dimensions, T>&) override {
+            CORRADE_ASSERT(false, "SceneGraph::InstancedDrawable::draw(): instanced drawable can be drawn only as part of InstancedDrawableGroup", );
+        }
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Instanced drawable for two-dimensional scenes
+
+Convenience alternative to <tt>%InstancedDrawable<2, T></tt>. See
+InstancedDrawable for more information.
+@note Not available on GCC < 4.7. Use <tt>%InstancedDrawable<2, T></tt>
+    instead.
+@see @ref InstancedDrawable2D, @ref BasicInstancedDrawable3D
+*/
+template<class T> using BasicInstancedDrawable2D = InstancedDrawable<2, T>;
+#endif
+
+/**
+@brief Instanced drawable for two-dimensional float scenes
+
+@see @ref InstancedDrawable3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicInstancedDrawable2D<Float> InstancedDrawable2D;
+#else
+typedef InstancedDrawable<2, Float> InstancedDrawable2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Instanced drawable for three-dimensional scenes
+
+Convenience alternative to <tt>%InstancedDrawable<3, T></tt>. See
+InstancedDrawable for more information.
+@note Not available on GCC < 4.7. Use <tt>%InstancedDrawable<3, T></tt>
+    instead.
+@see @ref InstancedDrawable3D, @ref BasicInstancedDrawable2D
+*/
+template<class T> using BasicInstancedDrawable3D = InstancedDrawable<3, T>;
+#endif
+
+/**
+@brief Instanced drawable for three-dimensional float scenes
+
+@see @ref InstancedDrawable2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicInstancedDrawable3D<Float> InstancedDrawable3D;
+#else
+typedef InstancedDrawable<3, Float> InstancedDrawable3D;
+#endif
+
+/**
+@brief Group of instanced drawables
+
+When drawn with @ref AbstractCamera::draw(InstancedDrawableGroup<dimensions, T>&),
+the camera computes transformations of all @ref InstancedDrawable "drawables"
+in the group the same way as for @ref DrawableGroup, culls them and sorts
+them, but instead of drawing each of them separately it collects the
+transformations of visible ones into one contiguous array and passes it to
+@ref draw(). The implementation then uploads it into per-instance buffer and
+issues single instanced draw call:
+@code
+class Trees: public SceneGraph::InstancedDrawableGroup3D {
+    public:
+        Trees() {
+            mesh.addVertexBuffer(vertices, 0, TreeShader::Position())
+                .addInstancedVertexBuffer(instances, 1, 0, TreeShader::TransformationMatrix());
+        }
+
+    private:
+        void draw(const std::vector<Matrix4>& transformationMatrices, SceneGraph::AbstractCamera3D& camera) override {
+            instances.setData(transformationMatrices, BufferUsage::StreamDraw);
+            shader.setProjectionMatrix(camera.projectionMatrix())
+                .use();
+            mesh.setInstanceCount(transformationMatrices.size())
+                .draw();
+        }
+
+        Buffer vertices, instances;
+        Mesh mesh;
+        TreeShader shader;
+};
+
+Trees trees;
+for(Object3D* o: treeObjects)
+    (new SceneGraph::InstancedDrawable3D(*o, &trees))->setBoundingBox(treeBounds);
+
+camera.draw(trees);
+@endcode
+
+If no drawable is visible, @ref draw() is not called.
+
+The group accepts only @ref InstancedDrawable "instanced drawables" and it
+cannot be used in place of @ref DrawableGroup, as plain drawables would never
+get drawn in it and the instanced ones can't be drawn separately.
+@see @ref scenegraph, @ref Mesh-instancing,
+    @ref BasicInstancedDrawableGroup2D, @ref BasicInstancedDrawableGroup3D,
+    @ref InstancedDrawableGroup2D, @ref InstancedDrawableGroup3D
+*/
+template<UnsignedInt dimensions, class T> class InstancedDrawableGroup: private DrawableGroup<dimensions, T> {
+    friend class AbstractCamera<dimensions, T>;
+
+    public:
+        explicit InstancedDrawableGroup() = default;
+
+        using DrawableGroup<dimensions, T>::isEmpty;
+        using DrawableGroup<dimensions, T>::size;
+
+        /** @brief Drawable at given index */
+        InstancedDrawable<dimensions, T>& operator[](std::size_t index) {
+            return static_cast<InstancedDrawable<dimensions, T>&>(DrawableGroup<dimensions, T>::operator[](index));
+        }
+
+        /** @overload */
+        const InstancedDrawable<dimensions, T>& operator[](std::size_t index) const {
+            return static_cast<const InstancedDrawable<dimensions, T>&>(DrawableGroup<dimensions, T>::operator[](index));
+        }
+
+        /**
+         * @brief Add drawable to the group
+         * @return Reference to self (for method chaining)
+         *
+         * See FeatureGroup::add() for more information.
+         */
+        InstancedDrawableGroup<dimensions, T>& add(InstancedDrawable<dimensions, T>& drawable) {
+            DrawableGroup<dimensions, T>::add(drawable);
+            return *this;
+        }
+
+        /**
+         * @brief Remove drawable from the group
+         * @return Reference to self (for method chaining)
+         *
+         * See FeatureGroup::remove() for more information.
+         */
+        InstancedDrawableGroup<dimensions, T>& remove(InstancedDrawable<dimensions, T>& drawable) {
+            DrawableGroup<dimensions, T>::remove(drawable);
+            return *this;
+        }
+
+    protected:
+        /**
+         * @brief Draw all instances using given camera
+         * @param transformationMatrices    Transformations of all visible
+         *      drawables relative to camera, in draw order
+         * @param camera                    Camera
+         *
+         * Projection matrix can be retrieved from AbstractCamera::projectionMatrix().
+         */
+        virtual void draw(const std::vector<typename DimensionTraits<dimensions, T>::MatrixType>& transformationMatrices, AbstractCamera<dimensions, T>& camera) = 0;
+
+    private:
+        /* Plain drawable can still get here through Drawable::drawables() */
+        void doAdd(Drawable<dimensions, T>& drawable) override {
+            static_cast<void>(drawable);
+            CORRADE_ASSERT((dynamic_cast<InstancedDrawable<dimensions, T>*>(&drawable)),
+                "SceneGraph::InstancedDrawableGroup::add(): only instanced drawables can be added", );
+        }
+};
+
+/* Added to the group only after it is fully constructed, so the group can
+   check its type */
+template<UnsignedInt dimensions, class T> InstancedDrawable<dimensions, T>::InstancedDrawable(AbstractObject<dimensions, T>& object, InstancedDrawableGroup<dimensions, T>* drawables): Drawable<dimensions, T>(object) {
+    if(drawables) drawables->add(*this);
+}
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Group of instanced drawables for two-dimensional scenes
+
+Convenience alternative to <tt>%InstancedDrawableGroup<2, T></tt>. See
+InstancedDrawableGroup for more information.
+@note Not available on GCC < 4.7. Use <tt>%InstancedDrawableGroup<2, T></tt>
+    instead.
+@see @ref InstancedDrawableGroup2D, @ref BasicInstancedDrawableGroup3D
+*/
+template<class T> using BasicInstancedDrawableGroup2D = InstancedDrawableGroup<2, T>;
+#endif
+
+/**
+@brief Group of instanced drawables for two-dimensional float scenes
+
+@see @ref InstancedDrawableGroup3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicInstancedDrawableGroup2D<Float> InstancedDrawableGroup2D;
+#else
+typedef InstancedDrawableGroup<2, Float> InstancedDrawableGroup2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Group of instanced drawables for three-dimensional scenes
+
+Convenience alternative to <tt>%InstancedDrawableGroup<3, T></tt>. See
+InstancedDrawableGroup for more information.
+@note Not available on GCC < 4.7. Use <tt>%InstancedDrawableGroup<3, T></tt>
+    instead.
+@see @ref InstancedDrawableGroup3D, @ref BasicInstancedDrawableGroup2D
+*/
+template<class T> using BasicInstancedDrawableGroup3D = InstancedDrawableGroup<3, T>;
+#endif
+
+/**
+@brief Group of instanced drawables for three-dimensional float scenes
+
+@see @ref InstancedDrawableGroup2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicInstancedDrawableGroup3D<Float> InstancedDrawableGroup3D;
+#else
+typedef InstancedDrawableGroup<3, Float> InstancedDrawableGroup3D;
+#endif
+
+}}
+
+#endif
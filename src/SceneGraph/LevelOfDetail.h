@@ -0,0 +1,323 @@
+#ifndef Magnum_SceneGraph_LevelOfDetail_h
+#define Magnum_SceneGraph_LevelOfDetail_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::LevelOfDetail, @ref Magnum::SceneGraph::LevelOfDetailStatistics, enum @ref Magnum::SceneGraph::LevelOfDetailMetric, alias @ref Magnum::SceneGraph::BasicLevelOfDetail2D, @ref Magnum::SceneGraph::BasicLevelOfDetail3D, typedef @ref Magnum::SceneGraph::LevelOfDetail2D, @ref Magnum::SceneGraph::LevelOfDetail3D
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "Drawable.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Level of detail metric
+
+@see @ref LevelOfDetail::setMetric()
+*/
+enum class LevelOfDetailMetric: UnsignedByte {
+    /**
+     * Distance of bounding box center (or object origin, if the drawable
+     * doesn't have bounding box) from the camera. Level is used while the
+     * distance is smaller than its threshold. Default.
+     */
+    Distance,
+
+    /**
+     * Diameter of sphere enclosing the bounding box projected to the screen,
+     * relative to viewport height. Level is used while the size is larger
+     * than its threshold. Requires bounding box to be set, otherwise the
+     * size is always zero.
+     */
+    ProjectedSize
+};
+
+/** @debugoperator{Magnum::SceneGraph::LevelOfDetailMetric} */
+Debug MAGNUM_SCENEGRAPH_EXPORT operator<<(Debug debug, LevelOfDetailMetric value);
+
+/**
+@brief Level of detail statistics
+
+Counts how many times each level was drawn. Shared by any number of
+@ref LevelOfDetail instances, reset it before each frame to get per-frame
+counts.
+*/
+class LevelOfDetailStatistics {
+    template<UnsignedInt, class> friend class LevelOfDetail;
+
+    public:
+        explicit LevelOfDetailStatistics() = default;
+
+        /**
+         * @brief Draw counts for all levels
+         *
+         * Contains as many items as is the largest level drawn since the
+         * object was created.
+         */
+        const std::vector<UnsignedInt>& drawnCounts() const { return _drawnCounts; }
+
+        /**
+         * @brief Draw count of given level
+         *
+         * If the level was never drawn, returns `0`.
+         */
+        UnsignedInt drawnCount(UnsignedInt level) const {
+            return level < _drawnCounts.size() ? _drawnCounts[level] : 0;
+        }
+
+        /**
+         * @brief Reset the counts to zero
+         *
+         * The allocated storage is kept.
+         */
+        void reset() { std::fill(_drawnCounts.begin(), _drawnCounts.end(), 0); }
+
+    private:
+        void drawn(UnsignedInt level) {
+            if(level >= _drawnCounts.size()) _drawnCounts.resize(level + 1);
+            ++_drawnCounts[level];
+        }
+
+        std::vector<UnsignedInt> _drawnCounts;
+};
+
+/**
+@brief Level of detail
+
+%Drawable which draws one of given drawables based on distance or projected
+size of the object. The drawables are usually attached to the same object,
+each drawing one mesh variant, and they are not part of any group:
+@code
+Object3D* o = new Object3D(&scene);
+auto lod = new SceneGraph::LevelOfDetail3D(*o, &drawables);
+lod->setBoundingBox(box);
+lod->addLevel(*new MeshDrawable(*o, fullMesh), 10.0f)
+    .addLevel(*new MeshDrawable(*o, reducedMesh), 50.0f)
+    .addLevel(*new MeshDrawable(*o, impostorMesh), 200.0f);
+@endcode
+
+The level is selected in @ref draw() from the transformation already computed
+by the camera, thus it works with culling, sorting and all drawing
+functions of @ref AbstractCamera. Objects farther than the last threshold
+are not drawn at all, use infinity as the last threshold to always draw
+something.
+
+@section LevelOfDetail-hysteresis Hysteresis
+
+To avoid popping when the object is moving around the threshold, the
+currently selected level is kept until the metric crosses the threshold by
+given fraction, see @ref setHysteresis(). The selected level is stored in
+the drawable, thus when drawing the same drawable with multiple cameras,
+the hysteresis is shared between them.
+
+@section LevelOfDetail-statistics Statistics
+
+Optionally the drawable can count how many times each level was drawn into
+@ref LevelOfDetailStatistics instance shared by many drawables:
+@code
+SceneGraph::LevelOfDetailStatistics statistics;
+lod->setStatistics(&statistics);
+
+// ...
+statistics.reset();
+camera.draw(drawables);
+Debug() << statistics.drawnCounts();
+@endcode
+
+@see @ref scenegraph, @ref BasicLevelOfDetail2D, @ref BasicLevelOfDetail3D,
+    @ref LevelOfDetail2D, @ref LevelOfDetail3D
+*/
+template<UnsignedInt dimensions, class T> class LevelOfDetail: public Drawable<dimensions, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    %Object this drawable belongs to
+         * @param drawables Group this drawable belongs to
+         *
+         * Default metric is @ref LevelOfDetailMetric::Distance, default
+         * hysteresis is `0.1`.
+         */
+        explicit LevelOfDetail(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables = nullptr);
+
+        /** @brief Metric */
+        LevelOfDetailMetric metric() const { return _metric; }
+
+        /**
+         * @brief Set metric
+         * @return Reference to self (for method chaining)
+         *
+         * Can be set only if no levels are added yet.
+         */
+        LevelOfDetail<dimensions, T>& setMetric(LevelOfDetailMetric metric);
+
+        /** @brief Hysteresis */
+        T hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * Fraction by which the metric has to cross the threshold before
+         * another level is selected. E.g. with hysteresis `0.1` and threshold
+         * `100` for @ref LevelOfDetailMetric::Distance the next level is
+         * selected when the distance is larger than `110` and previous level
+         * when it is smaller than `90`. Must be in range @f$ [0, 1) @f$.
+         */
+        LevelOfDetail<dimensions, T>& setHysteresis(T hysteresis);
+
+        /** @brief Level count */
+        UnsignedInt levelCount() const { return _levels.size(); }
+
+        /** @brief Drawable for given level */
+        Drawable<dimensions, T>& levelDrawable(UnsignedInt level) const {
+            return *_levels[level].drawable;
+        }
+
+        /** @brief Threshold for given level */
+        T levelThreshold(UnsignedInt level) const {
+            return _levels[level].threshold;
+        }
+
+        /**
+         * @brief Add level
+         * @return Reference to self (for method chaining)
+         *
+         * The levels must be added from the most detailed one. For
+         * @ref LevelOfDetailMetric::Distance the thresholds must be
+         * increasing, for @ref LevelOfDetailMetric::ProjectedSize
+         * decreasing. The drawable must not be part of any group, otherwise
+         * it would be drawn twice.
+         */
+        LevelOfDetail<dimensions, T>& addLevel(Drawable<dimensions, T>& drawable, T threshold);
+
+        /**
+         * @brief Level selected in last draw
+         *
+         * If the object was not drawn yet or was farther than the last
+         * threshold, returns @ref levelCount().
+         */
+        UnsignedInt level() const { return _level; }
+
+        /** @brief Statistics */
+        LevelOfDetailStatistics* statistics() const { return _statistics; }
+
+        /**
+         * @brief Set statistics
+         * @return Reference to self (for method chaining)
+         *
+         * Each draw increases count of drawn level in given statistics. Set
+         * to `nullptr` to disable counting.
+         */
+        LevelOfDetail<dimensions, T>& setStatistics(LevelOfDetailStatistics* statistics) {
+            _statistics = statistics;
+            return *this;
+        }
+
+        /**
+         * @brief Select level and draw it
+         *
+         * Computes the metric from @p transformationMatrix and
+         * @ref AbstractCamera::projectionMatrix(), selects the level and
+         * draws its drawable with the same parameters.
+         */
+        void draw(const typename DimensionTraits<dimensions, T>::MatrixType& transformationMatrix, AbstractCamera<dimensions, T>& camera) override;
+
+    private:
+        struct Level {
+            Drawable<dimensions, T>* drawable;
+            T threshold;
+        };
+
+        /* Whether the metric is past threshold of given level, scaled with
+           given factor */
+        bool isPast(T value, UnsignedInt level, T factor) const;
+
+        std::vector<Level> _levels;
+        LevelOfDetailStatistics* _statistics;
+        T _hysteresis;
+        UnsignedInt _level;
+        LevelOfDetailMetric _metric;
+        bool _hasLevel;
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Level of detail for two-dimensional scenes
+
+Convenience alternative to <tt>%LevelOfDetail<2, T></tt>. See LevelOfDetail
+for more information.
+@note Not available on GCC < 4.7. Use <tt>%LevelOfDetail<2, T></tt> instead.
+@see @ref LevelOfDetail2D, @ref BasicLevelOfDetail3D
+*/
+template<class T> using BasicLevelOfDetail2D = LevelOfDetail<2, T>;
+#endif
+
+/**
+@brief Level of detail for two-dimensional float scenes
+
+@see @ref LevelOfDetail3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicLevelOfDetail2D<Float> LevelOfDetail2D;
+#else
+typedef LevelOfDetail<2, Float> LevelOfDetail2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Level of detail for three-dimensional scenes
+
+Convenience alternative to <tt>%LevelOfDetail<3, T></tt>. See LevelOfDetail
+for more information.
+@note Not available on GCC < 4.7. Use <tt>%LevelOfDetail<3, T></tt> instead.
+@see @ref LevelOfDetail3D, @ref BasicLevelOfDetail2D
+*/
+template<class T> using BasicLevelOfDetail3D = LevelOfDetail<3, T>;
+#endif
+
+/**
+@brief Level of detail for three-dimensional float scenes
+
+@see @ref LevelOfDetail2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicLevelOfDetail3D<Float> LevelOfDetail3D;
+#else
+typedef LevelOfDetail<3, Float> LevelOfDetail3D;
+#endif
+
+#ifdef CORRADE_TARGET_WINDOWS
+extern template class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetail<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetail<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef Magnum_SceneGraph_LevelOfDetail_hpp
+#define Magnum_SceneGraph_LevelOfDetail_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref LevelOfDetail.h
+ */
+
+#include "LevelOfDetail.h"
+
+#include <cmath>
+
+#include <Utility/Assert.h>
+
+#include "AbstractCamera.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Largest scaling of the transformation */
+template<UnsignedInt dimensions, class T> T maxScaling(const typename DimensionTraits<dimensions, T>::MatrixType& transformation) {
+    T scaling(0);
+    const Math::Matrix<dimensions, T> rotationScaling = transformation.rotationScaling();
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        scaling = std::max(scaling, rotationScaling[i].dot());
+    return std::sqrt(scaling);
+}
+
+}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>::LevelOfDetail(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): Drawable<dimensions, T>(object, drawables), _statistics(nullptr), _hysteresis(T(0.1)), _level(0), _metric(LevelOfDetailMetric::Distance), _hasLevel(false) {}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>& LevelOfDetail<dimensions, T>::setMetric(const LevelOfDetailMetric metric) {
+    CORRADE_ASSERT(_levels.empty(), "SceneGraph::LevelOfDetail::setMetric(): can't change metric after levels were added", *this);
+    _metric = metric;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>& LevelOfDetail<dimensions, T>::setHysteresis(const T hysteresis) {
+    CORRADE_ASSERT(hysteresis >= T(0) && hysteresis < T(1), "SceneGraph::LevelOfDetail::setHysteresis(): hysteresis must be in range [0, 1), got" << hysteresis, *this);
+    _hysteresis = hysteresis;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>& LevelOfDetail<dimensions, T>::addLevel(Drawable<dimensions, T>& drawable, const T threshold) {
+    CORRADE_ASSERT(!drawable.drawables(), "SceneGraph::LevelOfDetail::addLevel(): the drawable must not be part of any group", *this);
+    CORRADE_ASSERT(_levels.empty() || (_metric == LevelOfDetailMetric::Distance ? threshold > _levels.back().threshold : threshold < _levels.back().threshold),
+        "SceneGraph::LevelOfDetail::addLevel(): thresholds must be" << (_metric == LevelOfDetailMetric::Distance ? "increasing" : "decreasing") << "but got" << threshold << "after" << _levels.back().threshold, *this);
+
+    _levels.push_back({&drawable, threshold});
+
+    /* Previous selection is not valid anymore */
+    _level = _levels.size();
+    _hasLevel = false;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> bool LevelOfDetail<dimensions, T>::isPast(const T value, const UnsignedInt level, const T factor) const {
+    return _metric == LevelOfDetailMetric::Distance ?
+        value > _levels[level].threshold*factor :
+        value*factor < _levels[level].threshold;
+}
+
+template<UnsignedInt dimensions, class T> void LevelOfDetail<dimensions, T>::draw(const typename DimensionTraits<dimensions, T>::MatrixType& transformationMatrix, AbstractCamera<dimensions, T>& camera) {
+    if(_levels.empty()) return;
+
+    /* Center and radius of sphere enclosing the bounding box in camera
+       coordinates, or object origin, if there's no bounding box */
+    typename DimensionTraits<dimensions, T>::VectorType center;
+    T radius(0);
+    if(this->hasBoundingBox()) {
+        center = this->boundingBox().center();
+        radius = (this->boundingBox().size()/T(2)).length()*Implementation::maxScaling<dimensions, T>(transformationMatrix);
+    }
+    center = transformationMatrix.transformPoint(center);
+
+    /* Compute the metric. Projected size is diameter of the sphere in NDC
+       divided by height of NDC, i.e. fraction of viewport height. */
+    T value;
+    if(_metric == LevelOfDetailMetric::Distance) value = center.length();
+    else {
+        const typename DimensionTraits<dimensions, T>::MatrixType& projection = camera.projectionMatrix();
+        T w = projection[dimensions][dimensions];
+        for(UnsignedInt i = 0; i != dimensions; ++i)
+            w += projection[i][dimensions]*center[i];
+        value = w > T(0) ? radius*std::abs(projection[1][1])/w : T(0);
+    }
+
+    /* Select the level. Moving to less detailed level requires the metric to
+       be past the threshold by the hysteresis, moving to more detailed level
+       requires it to be before the threshold by the hysteresis. Without
+       previous selection the thresholds are used as-is. */
+    UnsignedInt level = 0;
+    for(; level != _levels.size(); ++level) {
+        const T factor = !_hasLevel ? T(1) :
+            level >= _level ? T(1) + _hysteresis : T(1) - _hysteresis;
+        if(!isPast(value, level, factor)) break;
+    }
+    _level = level;
+    _hasLevel = true;
+
+    /* Farther than the last level, don't draw anything */
+    if(level == _levels.size()) return;
+
+    if(_statistics) _statistics->drawn(level);
+    _levels[level].drawable->draw(transformationMatrix, camera);
+}
+
+}}
+
+#endif
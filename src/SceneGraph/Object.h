@@ -41,12 +41,15 @@ namespace Implementation {
     enum class ObjectFlag: UnsignedByte {
         Dirty = 1 << 0,
         Visited = 1 << 1,
-        Joint = 1 << 2
+        Joint = 1 << 2,
+        CachedAbsolute = 1 << 3
     };
 
     typedef Containers::EnumSet<ObjectFlag, UnsignedByte> ObjectFlags;
 
     CORRADE_ENUMSET_OPERATORS(ObjectFlags)
+
+    template<class> struct HierarchyBuilder;
 }
 
 /**
@@ -101,6 +104,8 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 {
     friend class Containers::LinkedList<Object<Transformation>>;
     friend class Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
+    friend class Scene<Transformation>;
+    friend struct Implementation::HierarchyBuilder<Transformation>;
 
     #ifndef DOXYGEN_GENERATING_OUTPUT
     Object(const Object<Transformation>&) = delete;
@@ -234,29 +239,74 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /**
          * @brief Transformation relative to root object
          *
-         * @see absoluteTransformationMatrix()
+         * The transformation is cached in the object and also in all its
+         * parents, so repeated calls are done in constant time until
+         * transformation of the object or any of its parents changes. Clean
+         * objects have the transformation always cached, see
+         * @ref scenegraph-caching.
+         *
+         * @attention Although the function is @c const, it updates the cache
+         *      in the object and its parents if the transformation isn't
+         *      cached yet. Calling it concurrently from multiple threads on
+         *      objects with common dirty parent is thus a data race, clean
+         *      the objects first (e.g. using @ref Scene::setAllClean()) or
+         *      use @ref transformations() with explicit thread count instead.
+         * @see @ref absoluteTransformationMatrix()
          */
         typename Transformation::DataType absoluteTransformation() const;
 
         /**
          * @brief Transformation matrices of given set of objects relative to this object
          *
+         * Can be called on any object, not just the scene. Only the subtree
+         * below the nearest common ancestor of this object and all @p objects
+         * is touched, thus e.g. computing transformations relative to a root
+         * of small subtree is independent of the size of the rest of the
+         * scene. All objects must be part of the same tree as this object.
+         *
          * All transformations are premultiplied with @p initialTransformationMatrix,
-         * if specified.
+         * if specified. If @p threadCount is larger than `1`, independent
+         * parts of the hierarchy are processed in parallel on given count of
+         * threads (including the calling one). The scene must not be
+         * accessed from other threads during the computation.
          * @see transformations()
          */
-        std::vector<MatrixType> transformationMatrices(const std::vector<Object<Transformation>*>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+        std::vector<MatrixType> transformationMatrices(const std::vector<Object<Transformation>*>& objects, const MatrixType& initialTransformationMatrix = MatrixType(), UnsignedInt threadCount = 1) const;
 
         /**
          * @brief Transformations of given group of objects relative to this object
          *
          * All transformations can be premultiplied with @p initialTransformation,
-         * if specified.
-         * @see transformationMatrices()
+         * if specified. See @ref transformationMatrices() for description of
+         * @p threadCount.
          */
         /* `objects` passed by copy intentionally (to allow move from
            transformationMatrices() and avoid copy in the function itself) */
-        std::vector<typename Transformation::DataType> transformations(std::vector<Object<Transformation>*> objects, const typename Transformation::DataType& initialTransformation = typename Transformation::DataType()) const;
+        std::vector<typename Transformation::DataType> transformations(std::vector<Object<Transformation>*> objects, const typename Transformation::DataType& initialTransformation = typename Transformation::DataType(), UnsignedInt threadCount = 1) const;
+
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object using external context
+         *
+         * Same as @ref transformationMatrices(const std::vector<Object<Transformation>*>&, const MatrixType&, UnsignedInt) const,
+         * but all temporary bookkeeping is done in given @p context instead
+         * of the objects themselves. The scene is thus not modified and it is
+         * possible to call this function from more threads at once, each
+         * having its own context. The context can be reused for subsequent
+         * calls to avoid repeated allocations.
+         * @see transformations(std::vector<Object<Transformation>*>, TransformationContext<Transformation>&, const typename Transformation::DataType&) const
+         */
+        std::vector<MatrixType> transformationMatrices(const std::vector<Object<Transformation>*>& objects, TransformationContext<Transformation>& context, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
+        /**
+         * @brief Transformations of given group of objects relative to this object using external context
+         *
+         * Same as @ref transformations(std::vector<Object<Transformation>*>, const typename Transformation::DataType&, UnsignedInt) const,
+         * but all temporary bookkeeping is done in given @p context instead
+         * of the objects themselves. See
+         * @ref transformationMatrices(const std::vector<Object<Transformation>*>&, TransformationContext<Transformation>&, const MatrixType&) const
+         * for more information.
+         */
+        std::vector<typename Transformation::DataType> transformations(std::vector<Object<Transformation>*> objects, TransformationContext<Transformation>& context, const typename Transformation::DataType& initialTransformation = typename Transformation::DataType()) const;
 
         /*@}*/
 
@@ -269,11 +319,12 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /**
          * @brief Clean absolute transformations of given set of objects
          *
-         * Only dirty objects in the list are cleaned.
-         * @see setClean()
+         * Only dirty objects in the list are cleaned. The objects and all
+         * their dirty parents are ordered so parents are before their
+         * children and then cleaned in a single pass, each of them only once.
+         * @see @ref setClean(), @ref Scene::setAllClean()
          */
-        /* `objects` passed by copy intentionally (to avoid copy internally) */
-        static void setClean(std::vector<Object<Transformation>*> objects);
+        static void setClean(const std::vector<Object<Transformation>*>& objects);
 
         /** @copydoc AbstractObject::isDirty() */
         bool isDirty() const { return !!(flags & Flag::Dirty); }
@@ -302,9 +353,17 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             return absoluteTransformationMatrix();
         }
 
-        std::vector<MatrixType> doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix) const override final;
+        std::vector<MatrixType> doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix, UnsignedInt threadCount) const override final;
+
+        /* Joint marks stored directly in the objects */
+        struct InPlaceMarks {
+            Implementation::ObjectFlags& flags(Object<Transformation>* o) { return o->flags; }
+            UnsignedInt& counter(Object<Transformation>* o) { return o->counter; }
+        };
+
+        template<class Marks> std::vector<typename Transformation::DataType> MAGNUM_SCENEGRAPH_LOCAL transformationsInternal(std::vector<Object<Transformation>*> objects, Marks& marks, const typename Transformation::DataType& initialTransformation, UnsignedInt threadCount) const;
 
-        typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<Object<Transformation>*>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
+        template<class Marks> static typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(Object<Transformation>* o, Marks& marks, UnsignedInt& parentJoint);
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
@@ -313,10 +372,32 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 
         void MAGNUM_SCENEGRAPH_LOCAL setClean(const typename Transformation::DataType& absoluteTransformation);
 
+        /* Used by buildHierarchy(). Like setParent(), but without the cycle
+           check, the object must not have any parent yet. */
+        void setParentUnchecked(Object<Transformation>& parent);
+
+        /* Scene dirty queue, see Scene::setAllClean() */
+        void MAGNUM_SCENEGRAPH_LOCAL enqueueDirty();
+        void MAGNUM_SCENEGRAPH_LOCAL dequeueDirty();
+        void clearDirtyQueue();
+        void cleanDirtyQueue();
+
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
-        UnsignedShort counter;
-        Flags flags;
+
+        static bool isDirtyUncached(const Object<Transformation>* o) {
+            return (o->flags & (Flag::Dirty|Flag::CachedAbsolute)) == Flag::Dirty;
+        }
+
+        /* Cached absolute transformation, valid if CachedAbsolute flag is set.
+           Clean objects have it always cached. */
+        mutable typename Transformation::DataType cachedAbsoluteTransformation;
+        UnsignedInt counter;
+        mutable Flags flags;
+
+        /* Circular list of dirty subtrees, the scene is the list head. Object
+           which is not in the queue points to itself. */
+        Object<Transformation> *previousDirty, *nextDirty;
 };
 
 }}
@@ -32,9 +32,10 @@
 #include "Object.h"
 
 #include <algorithm>
-#include <stack>
 
 #include "Scene.h"
+#include "TransformationContext.h"
+#include "parallelImplementation.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -43,11 +44,14 @@ template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~Abstra
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFFFFFu), flags(Flag::Dirty), previousDirty(this), nextDirty(this) {
     setParent(parent);
 }
 
-template<class Transformation> Object<Transformation>::~Object() = default;
+template<class Transformation> Object<Transformation>::~Object() {
+    /* Remove itself from dirty queue of the scene, if queued */
+    dequeueDirty();
+}
 
 template<class Transformation> Scene<Transformation>* Object<Transformation>::scene() {
     Object<Transformation>* p(this);
@@ -82,16 +86,50 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
         p = p->parent();
     }
 
+    /* Remove the object from dirty queue of old scene. If the scene changes,
+       remove also all queued objects in the subtree, otherwise they would
+       stay linked in queue of the old scene and enqueueDirty() would never
+       add them to the new one. */
+    if(scene() != (parent ? parent->scene() : nullptr)) {
+        /* Go through the subtree without recursion */
+        Object<Transformation>* o = this;
+        for(;;) {
+            o->dequeueDirty();
+
+            /* Go to first child. If there is none, go to next sibling of
+               the object or of the nearest parent which has some. */
+            Object<Transformation>* next = o->firstChild();
+            while(!next && o != this) {
+                if(!(next = o->nextSibling())) o = o->parent();
+            }
+
+            if(!next) break;
+            o = next;
+        }
+    } else dequeueDirty();
+
     /* Remove the object from old parent children list */
     if(this->parent()) this->parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
 
     /* Add the object to list of new parent */
     if(parent) parent->Containers::LinkedList<Object<Transformation>>::insert(this);
 
+    /* If the object was already dirty, setDirty() doesn't add it to the
+       queue of new scene */
     setDirty();
+    enqueueDirty();
     return *this;
 }
 
+template<class Transformation> void Object<Transformation>::setParentUnchecked(Object<Transformation>& parent) {
+    CORRADE_INTERNAL_ASSERT(!this->parent() && !isScene());
+    parent.Containers::template LinkedList<Object<Transformation>>::insert(this);
+
+    /* New objects are dirty, thus only objects with clean parent are added to
+       the queue, the check is done inside */
+    enqueueDirty();
+}
+
 template<class Transformation> Object<Transformation>& Object<Transformation>::setParentKeepTransformation(Object<Transformation>* parent) {
     CORRADE_ASSERT(scene() == parent->scene(), "SceneGraph::Object::setParentKeepTransformation(): both parents must be in the same scene", *this);
 
@@ -104,39 +142,81 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
 }
 
 template<class Transformation> typename Transformation::DataType Object<Transformation>::absoluteTransformation() const {
-    if(!parent()) return Transformation::transformation();
-    return Implementation::Transformation<Transformation>::compose(parent()->absoluteTransformation(), Transformation::transformation());
+    /* Nothing changed since last time, done */
+    if(flags & Flag::CachedAbsolute) return cachedAbsoluteTransformation;
+
+    /* Compute and cache the transformations going down from the nearest
+       parent with cached transformation (or from the root). Parents of object
+       with cached transformation have it cached too. To avoid allocation,
+       only the topmost uncached parents are remembered on the way up, if
+       there are more of them, the walk is repeated until this object is
+       reached. */
+    constexpr std::size_t Size = 32;
+    const Object<Transformation>* objects[Size];
+    for(;;) {
+        std::size_t count = 0;
+        const Object<Transformation>* p = this;
+        for(; p && !(p->flags & Flag::CachedAbsolute); p = p->parent())
+            objects[count++%Size] = p;
+
+        typename Transformation::DataType absoluteTransformation = p ? p->cachedAbsoluteTransformation : typename Transformation::DataType();
+        for(std::size_t i = 0, end = std::min(count, Size); i != end; ++i) {
+            const Object<Transformation>* o = objects[(count - i - 1)%Size];
+            absoluteTransformation = Implementation::Transformation<Transformation>::compose(absoluteTransformation, o->transformation());
+            o->cachedAbsoluteTransformation = absoluteTransformation;
+            o->flags |= Flag::CachedAbsolute;
+        }
+
+        if(count <= Size) return absoluteTransformation;
+    }
 }
 
 template<class Transformation> void Object<Transformation>::setDirty() {
-    /* The transformation of this object (and all children) is already dirty,
-       nothing to do */
-    if(flags & Flag::Dirty) return;
+    /* The transformation of this object (and all children) is already dirty
+       and not cached, nothing to do */
+    if(isDirtyUncached(this)) return;
 
-    Object<Transformation>* self = static_cast<Object<Transformation>*>(this);
+    /* Go through the subtree without recursion, skipping children which are
+       already dirty and not cached, as their subtrees are too */
+    Object<Transformation>* o = this;
+    for(;;) {
+        /* Make all features dirty, mark object as dirty */
+        if(!(o->flags & Flag::Dirty)) {
+            for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = o->firstFeature(); i; i = i->nextFeature())
+                i->markDirty();
+            o->flags |= Flag::Dirty;
+        }
 
-    /* Make all features dirty */
-    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = self->firstFeature(); i; i = i->nextFeature())
-        i->markDirty();
+        /* Invalidate cached absolute transformation */
+        o->flags &= ~Flag::CachedAbsolute;
+
+        /* Go to first clean child. If there is none, go to next clean
+           sibling of the object or of the nearest parent which has some. */
+        Object<Transformation>* next = o->firstChild();
+        while(next && isDirtyUncached(next)) next = next->nextSibling();
+        while(!next && o != this) {
+            next = o->nextSibling();
+            while(next && isDirtyUncached(next)) next = next->nextSibling();
+            if(!next) o = o->parent();
+        }
 
-    /* Make all children dirty */
-    for(Object<Transformation>* i = self->firstChild(); i; i = i->nextSibling())
-        i->setDirty();
+        if(!next) break;
+        o = next;
+    }
 
-    /* Mark object as dirty */
-    flags |= Flag::Dirty;
+    enqueueDirty();
 }
 
 template<class Transformation> void Object<Transformation>::setClean() {
     /* The object (and all its parents) are already clean, nothing to do */
     if(!(flags & Flag::Dirty)) return;
 
-    /* Collect all parents, compute base transformation */
-    std::stack<Object<Transformation>*> objects;
+    /* Collect all dirty parents, compute base transformation */
+    std::vector<Object<Transformation>*> objects;
     typename Transformation::DataType absoluteTransformation;
-    Object<Transformation>* p = static_cast<Object<Transformation>*>(this);
+    Object<Transformation>* p = this;
     for(;;) {
-        objects.push(p);
+        objects.push_back(p);
 
         p = p->parent();
 
@@ -152,9 +232,8 @@ template<class Transformation> void Object<Transformation>::setClean() {
     }
 
     /* Clean features on every collected object, going down from root object */
-    while(!objects.empty()) {
-        Object<Transformation>* o = objects.top();
-        objects.pop();
+    for(auto it = objects.rbegin(); it != objects.rend(); ++it) {
+        Object<Transformation>* o = *it;
 
         /* Compose transformation and clean object */
         absoluteTransformation = Implementation::Transformation<Transformation>::compose(absoluteTransformation, o->transformation());
@@ -164,18 +243,18 @@ template<class Transformation> void Object<Transformation>::setClean() {
     }
 }
 
-template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix, const UnsignedInt threadCount) const -> std::vector<MatrixType> {
     std::vector<Object<Transformation>*> castObjects(objects.size());
     for(std::size_t i = 0; i != objects.size(); ++i)
         /* Non-null is checked in transformations() */
         /** @todo Ensure this doesn't crash, somehow */
         castObjects[i] = static_cast<Object<Transformation>*>(objects[i]);
 
-    return transformationMatrices(std::move(castObjects), initialTransformationMatrix);
+    return transformationMatrices(std::move(castObjects), initialTransformationMatrix, threadCount);
 }
 
-template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<Object<Transformation>*>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<Object<Transformation>*>& objects, const MatrixType& initialTransformationMatrix, const UnsignedInt threadCount) const -> std::vector<MatrixType> {
+    std::vector<typename Transformation::DataType> transformations = this->transformations(objects, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix), threadCount);
     std::vector<MatrixType> transformationMatrices(transformations.size());
     for(std::size_t i = 0; i != objects.size(); ++i)
         transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
@@ -184,24 +263,63 @@ template<class Transformation> auto Object<Transformation>::transformationMatric
 }
 
 /*
-Computing absolute transformations for given list of objects
+Computing transformations for given list of objects relative to this object
 
-The goal is to compute absolute transformation only once for each object
-involved. Objects contained in the subtree specified by `object` list are
-divided into two groups:
- - "joints", which are either part of `object` list or they have more than one
-   child in the subtree
+The goal is to compute transformation only once for each object involved.
+Objects contained in the subtree specified by `object` list and this object
+are divided into two groups:
+ - "joints", which are either part of `object` list, this object or they have
+   more than one child in the subtree
  - "non-joints", i.e. paths between joints
 
-Then for all joints their transformation (relative to parent joint) is
-computed and recursively concatenated together. Resulting transformations for
-joints which were originally in `object` list is then returned.
+Each object in the list is walked up the hierarchy until it reaches already
+visited object, joint or root, thus every object in the subtree is visited
+exactly once. If no object reached the root, all of them are in subtree of
+this object and nothing above it is touched. Otherwise this object is walked
+up too and the topmost joint on its path to the root is the nearest common
+ancestor of all objects. Then for all joints their transformation relative to parent joint is
+computed and the relative transformations are concatenated together going from
+the common ancestor. If this object is not the common ancestor, the
+transformations are then multiplied with inverse transformation of this object
+relative to the ancestor. Resulting transformations for joints which were
+originally in `object` list is then returned.
+
+The only per-object storage is the joint index (which fits into padding of the
+object) and the flags, everything else is allocated for the duration of the
+call.
 */
-template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<Object<Transformation>*> objects, const typename Transformation::DataType& initialTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", std::vector<typename Transformation::DataType>{});
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<Object<Transformation>*> objects, const typename Transformation::DataType& initialTransformation, const UnsignedInt threadCount) const {
+    CORRADE_ASSERT(threadCount, "SceneGraph::Object::transformations(): thread count must be at least one", std::vector<typename Transformation::DataType>{});
+
+    InPlaceMarks marks;
+    return transformationsInternal(std::move(objects), marks, initialTransformation, threadCount);
+}
+
+template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<Object<Transformation>*>& objects, TransformationContext<Transformation>& context, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+    std::vector<typename Transformation::DataType> transformations = this->transformations(objects, context, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+    std::vector<MatrixType> transformationMatrices(transformations.size());
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+
+    return transformationMatrices;
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<Object<Transformation>*> objects, TransformationContext<Transformation>& context, const typename Transformation::DataType& initialTransformation) const {
+    /* Clean up anything left from previous call which failed on assertion */
+    context._marks.clear();
+
+    std::vector<typename Transformation::DataType> transformations = transformationsInternal(std::move(objects), context, initialTransformation, 1);
+
+    /* Discard the marks, keep the allocated storage for next call */
+    context._marks.clear();
+    return transformations;
+}
+
+template<class Transformation> template<class Marks> std::vector<typename Transformation::DataType> Object<Transformation>::transformationsInternal(std::vector<Object<Transformation>*> objects, Marks& marks, const typename Transformation::DataType& initialTransformation, const UnsignedInt threadCount) const {
+    CORRADE_ASSERT(objects.size() < 0xFFFFFFFFu, "SceneGraph::Object::transformations(): too large scene", std::vector<typename Transformation::DataType>{});
 
     /* Remember object count for later */
-    std::size_t objectCount = objects.size();
+    const std::size_t objectCount = objects.size();
 
     /* Mark all original objects as joints and create initial list of joints
        from them */
@@ -210,81 +328,244 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
 
         /* Multiple occurences of one object in the array, don't overwrite it
            with different counter */
-        if(objects[i]->counter != 0xFFFFu) continue;
+        if(marks.counter(objects[i]) != 0xFFFFFFFFu) continue;
 
-        objects[i]->counter = UnsignedShort(i);
-        objects[i]->flags |= Flag::Joint;
+        marks.counter(objects[i]) = UnsignedInt(i);
+        marks.flags(objects[i]) |= Flag::Joint;
+    }
+    std::vector<Object<Transformation>*> jointObjects(std::move(objects));
+
+    /* This object is a joint too, add it to the list if it isn't there
+       already. The marks are not part of the observable state, so casting
+       away the constness is fine. */
+    Object<Transformation>* self = const_cast<Object<Transformation>*>(this);
+    if(marks.counter(self) == 0xFFFFFFFFu) {
+        marks.counter(self) = UnsignedInt(jointObjects.size());
+        marks.flags(self) |= Flag::Joint;
+        jointObjects.push_back(self);
     }
-    std::vector<Object<Transformation>*> jointObjects(objects);
+    const UnsignedInt selfJoint = marks.counter(self);
+
+    /* Mark all objects up the hierarchy as visited, stop at first already
+       visited object or joint. Objects where two paths meet become joints.
+       This object is marked as visited too, so if all objects are in its
+       subtree, nothing above it is touched. */
+    marks.flags(self) |= Flag::Visited;
+    Object<Transformation>* root = nullptr;
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        Object<Transformation>* o = jointObjects[i];
+
+        /* Already visited (duplicate occurence), continue to next */
+        if(marks.flags(o) & Flag::Visited) continue;
+
+        marks.flags(o) |= Flag::Visited;
+        for(;;) {
+            Object<Transformation>* parent = o->parent();
+
+            /* Root object, the object is not in subtree of this object.
+               Remember the root to check that all objects are in the same
+               tree. */
+            if(!parent) {
+                CORRADE_ASSERT(!root || root == o, "SceneGraph::Object::transformations(): the objects are not part of the same tree", std::vector<typename Transformation::DataType>{});
+                root = o;
+                break;
+            }
 
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
+            /* Parent is a joint or already visited, done */
+            if(marks.flags(parent) & (Flag::Visited|Flag::Joint)) {
+                /* If not already marked as joint, mark it as such and add it
+                   to list of joint objects */
+                if(!(marks.flags(parent) & Flag::Joint)) {
+                    CORRADE_ASSERT(jointObjects.size() < 0xFFFFFFFFu,
+                        "SceneGraph::Object::transformations(): too large scene", std::vector<typename Transformation::DataType>{});
+                    CORRADE_INTERNAL_ASSERT(marks.counter(parent) == 0xFFFFFFFFu);
+                    marks.counter(parent) = UnsignedInt(jointObjects.size());
+                    marks.flags(parent) |= Flag::Joint;
+                    jointObjects.push_back(parent);
+                }
+
+                break;
+            }
 
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", std::vector<typename Transformation::DataType>{});
+            /* Else mark the parent as visited and go up the hierarchy */
+            marks.flags(parent) |= Flag::Visited;
+            o = parent;
+        }
+    }
 
-    /* Mark all objects up the hierarchy as visited */
-    auto it = objects.begin();
-    while(!objects.empty()) {
-        /* Already visited, remove and continue to next (duplicate occurence) */
-        if((*it)->flags & Flag::Visited) {
-            it = objects.erase(it);
-            continue;
+    /* If all objects are in the subtree, this object is the nearest common
+       ancestor. Otherwise some paths went up to the root, walk up from this
+       object too until it meets them, the meeting object is the joint. */
+    Object<Transformation>* ancestor = self;
+    if(root) {
+        for(Object<Transformation>* o = self; ; o = o->parent()) {
+            Object<Transformation>* parent = o->parent();
+            CORRADE_ASSERT(parent, "SceneGraph::Object::transformations(): the objects are not part of the same tree", std::vector<typename Transformation::DataType>{});
+
+            if(marks.flags(parent) & (Flag::Visited|Flag::Joint)) {
+                if(!(marks.flags(parent) & Flag::Joint)) {
+                    CORRADE_ASSERT(jointObjects.size() < 0xFFFFFFFFu,
+                        "SceneGraph::Object::transformations(): too large scene", std::vector<typename Transformation::DataType>{});
+                    marks.counter(parent) = UnsignedInt(jointObjects.size());
+                    marks.flags(parent) |= Flag::Joint;
+                    jointObjects.push_back(parent);
+                }
+
+                break;
+            }
+
+            marks.flags(parent) |= Flag::Visited;
+        }
+
+        /* The nearest common ancestor is the topmost joint on the path from
+           this object to the root. Objects above it are on a single path to
+           the root, clean their visited marks, they are not needed. */
+        for(Object<Transformation>* o = self->parent(); o; o = o->parent())
+            if(marks.flags(o) & Flag::Joint) ancestor = o;
+        for(Object<Transformation>* o = ancestor->parent(); o; o = o->parent())
+            marks.flags(o) &= ~Flag::Visited;
+    }
+    const UnsignedInt ancestorJoint = marks.counter(ancestor);
+
+    /* Transformations of joints relative to parent joints, index of parent
+       joint (or 0xFFFFFFFFu for the common ancestor) */
+    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
+    std::vector<UnsignedInt> jointParents(jointObjects.size());
+    jointParents[ancestorJoint] = 0xFFFFFFFFu;
+
+    /* If this object is the common ancestor, all transformations can be
+       directly premultiplied with the initial transformation. Otherwise they
+       are first computed relative to the ancestor and then made relative to
+       this object at the end. */
+    const typename Transformation::DataType rootTransformation = selfJoint == ancestorJoint ?
+        initialTransformation : typename Transformation::DataType();
+
+    /* Compute transformation of all joints relative to parent joints. Each
+       non-joint object is part of exactly one path, so it is visited only
+       once and the paths can be processed in parallel. The common ancestor
+       has identity transformation, so the hierarchy above it is not touched
+       at all. */
+    Implementation::parallelFor(threadCount, jointObjects.size(), 1024, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            Object<Transformation>* o = jointObjects[i];
+
+            /* Second or next occurence of duplicate object or the common
+               ancestor, skip */
+            if(marks.counter(o) != i || i == ancestorJoint) continue;
+
+            jointTransformations[i] = computeJointTransformation(o, marks, jointParents[i]);
         }
+    });
+
+    /* Single-threaded, concatenate the relative transformations going from
+       root. Joints already resolved to absolute transformations are marked
+       with 0xFFFFFFFEu in the parent list. */
+    if(threadCount == 1) {
+        std::vector<UnsignedInt> unresolved;
+        for(std::size_t i = 0; i != jointObjects.size(); ++i) {
+            if(marks.counter(jointObjects[i]) != i) continue;
+
+            /* Collect all unresolved joints up to the root or first resolved
+               joint */
+            for(UnsignedInt joint = UnsignedInt(i); jointParents[joint] != 0xFFFFFFFEu; joint = jointParents[joint]) {
+                unresolved.push_back(joint);
+                if(jointParents[joint] == 0xFFFFFFFFu) break;
+            }
 
-        /* Mark the object as visited */
-        (*it)->flags |= Flag::Visited;
+            /* Resolve them going down */
+            while(!unresolved.empty()) {
+                const UnsignedInt joint = unresolved.back();
+                unresolved.pop_back();
 
-        Object<Transformation>* parent = (*it)->parent();
+                jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(
+                    jointParents[joint] == 0xFFFFFFFFu ? rootTransformation : jointTransformations[jointParents[joint]],
+                    jointTransformations[joint]);
+                jointParents[joint] = 0xFFFFFFFEu;
+            }
+        }
 
-        /* If this is root object, remove from list */
-        if(!parent) {
-            CORRADE_ASSERT(*it == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", std::vector<typename Transformation::DataType>{});
-            it = objects.erase(it);
-
-        /* Parent is an joint or already visited - remove current from list */
-        } else if(parent->flags & (Flag::Visited|Flag::Joint)) {
-            it = objects.erase(it);
-
-            /* If not already marked as joint, mark it as such and add it to
-               list of joint objects */
-            if(!(parent->flags & Flag::Joint)) {
-                CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", std::vector<typename Transformation::DataType>{});
-                CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
-                parent->counter = UnsignedShort(jointObjects.size());
-                parent->flags |= Flag::Joint;
-                jointObjects.push_back(parent);
+    /* Multi-threaded, compute depth of each joint in the joint tree and then
+       concatenate the transformations level by level, joints in one level are
+       independent of each other */
+    } else {
+        std::vector<UnsignedInt> depths(jointObjects.size(), 0xFFFFFFFFu);
+        std::vector<UnsignedInt> unresolved;
+        UnsignedInt maxDepth = 0;
+        for(std::size_t i = 0; i != jointObjects.size(); ++i) {
+            if(marks.counter(jointObjects[i]) != i) continue;
+
+            /* Collect all joints with unknown depth up to the root or first
+               joint with known depth */
+            UnsignedInt joint = UnsignedInt(i);
+            for(; joint != 0xFFFFFFFFu && depths[joint] == 0xFFFFFFFFu; joint = jointParents[joint])
+                unresolved.push_back(joint);
+
+            /* Assign the depths going down */
+            UnsignedInt depth = joint == 0xFFFFFFFFu ? 0 : depths[joint] + 1;
+            while(!unresolved.empty()) {
+                depths[unresolved.back()] = depth++;
+                unresolved.pop_back();
             }
+            maxDepth = std::max(maxDepth, depth);
+        }
 
-        /* Else go up the hierarchy */
-        } else *it = parent;
+        /* Sort the joints by depth */
+        std::vector<UnsignedInt> levelOffsets(maxDepth + 1);
+        for(std::size_t i = 0; i != jointObjects.size(); ++i)
+            if(marks.counter(jointObjects[i]) == i) ++levelOffsets[depths[i]];
+        for(std::size_t i = 0, offset = 0; i != levelOffsets.size(); ++i) {
+            const UnsignedInt count = levelOffsets[i];
+            levelOffsets[i] = UnsignedInt(offset);
+            offset += count;
+        }
+        std::vector<UnsignedInt> sortedJoints(levelOffsets.back());
+        {
+            std::vector<UnsignedInt> positions(levelOffsets.begin(), levelOffsets.end() - 1);
+            for(std::size_t i = 0; i != jointObjects.size(); ++i)
+                if(marks.counter(jointObjects[i]) == i) sortedJoints[positions[depths[i]]++] = UnsignedInt(i);
+        }
 
-        /* Cycle if reached end */
-        if(it == objects.end()) it = objects.begin();
+        /* Resolve the levels */
+        for(std::size_t level = 0; level + 1 != levelOffsets.size(); ++level) {
+            const UnsignedInt* levelJoints = sortedJoints.data() + levelOffsets[level];
+            Implementation::parallelFor(threadCount, levelOffsets[level + 1] - levelOffsets[level], 1024, [&](std::size_t begin, std::size_t end) {
+                for(std::size_t i = begin; i != end; ++i) {
+                    const UnsignedInt joint = levelJoints[i];
+                    jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(
+                        jointParents[joint] == 0xFFFFFFFFu ? rootTransformation : jointTransformations[jointParents[joint]],
+                        jointTransformations[joint]);
+                }
+            });
+        }
     }
 
-    /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
-
-    /* Compute transformations for all joints */
-    for(std::size_t i = 0; i != jointTransformations.size(); ++i)
-        computeJointTransformation(jointObjects, jointTransformations, i, initialTransformation);
+    /* Make the transformations relative to this object if it's not the
+       common ancestor. Done before copying the duplicates, as this object can
+       be in the list as well. */
+    if(selfJoint != ancestorJoint) {
+        const typename Transformation::DataType selfTransformation = Implementation::Transformation<Transformation>::compose(initialTransformation,
+            Implementation::Transformation<Transformation>::inverted(jointTransformations[selfJoint]));
+        for(std::size_t i = 0; i != objectCount; ++i) {
+            if(marks.counter(jointObjects[i]) == i)
+                jointTransformations[i] = Implementation::Transformation<Transformation>::compose(selfTransformation, jointTransformations[i]);
+        }
+    }
 
     /* Copy transformation for second or next occurences from first occurence
        of duplicate object */
     for(std::size_t i = 0; i != objectCount; ++i) {
-        if(jointObjects[i]->counter != i)
-            jointTransformations[i] = jointTransformations[jointObjects[i]->counter];
+        if(marks.counter(jointObjects[i]) != i)
+            jointTransformations[i] = jointTransformations[marks.counter(jointObjects[i])];
     }
 
-    /* All visited marks are now cleaned, clean joint marks and counters */
+    /* Visited marks of non-joint objects are now cleaned, clean joint marks,
+       visited marks and counters of joints */
     for(auto i: jointObjects) {
         /* All not-already cleaned objects (...duplicate occurences) should
            have joint mark */
-        CORRADE_INTERNAL_ASSERT(i->counter == 0xFFFFu || i->flags & Flag::Joint);
-        i->flags &= ~Flag::Joint;
-        i->counter = 0xFFFFu;
+        CORRADE_INTERNAL_ASSERT(marks.counter(i) == 0xFFFFFFFFu || marks.flags(i) & Flag::Joint);
+        marks.flags(i) &= ~(Flag::Joint|Flag::Visited);
+        marks.counter(i) = 0xFFFFFFFFu;
     }
 
     /* Shrink the array to contain only transformations of requested objects and return */
@@ -292,40 +573,34 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     return jointTransformations;
 }
 
-template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<Object<Transformation>*>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
-    Object<Transformation>* o = jointObjects[joint];
-
-    /* Transformation already computed ("unvisited" by this function before
-       either due to recursion or duplicate object occurences), done */
-    if(!(o->flags & Flag::Visited)) return jointTransformations[joint];
-
-    /* Initialize transformation */
-    jointTransformations[joint] = o->transformation();
+template<class Transformation> template<class Marks> typename Transformation::DataType Object<Transformation>::computeJointTransformation(Object<Transformation>* o, Marks& marks, UnsignedInt& parentJoint) {
+    /* Initialize transformation. The joint itself is only read here, as
+       other paths ending in it may be processed in parallel. */
+    typename Transformation::DataType transformation = o->transformation();
 
     /* Go up until next joint or root */
     for(;;) {
-        /* Clean visited mark */
-        CORRADE_INTERNAL_ASSERT(o->flags & Flag::Visited);
-        o->flags &= ~Flag::Visited;
-
         Object<Transformation>* parent = o->parent();
 
-        /* Root object, compose transformation with initial, done */
+        /* Root object, done */
         if(!parent) {
             CORRADE_INTERNAL_ASSERT(o->isScene());
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(initialTransformation, jointTransformations[joint]));
-
-        /* Joint object, compose transformation with the joint, done */
-        } else if(parent->flags & Flag::Joint) {
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(computeJointTransformation(jointObjects, jointTransformations, parent->counter, initialTransformation), jointTransformations[joint]));
+            parentJoint = 0xFFFFFFFFu;
+            return transformation;
+        }
 
-        /* Else compose transformation with parent, go up the hierarchy */
-        } else {
-            jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(parent->transformation(), jointTransformations[joint]);
-            o = parent;
+        /* Joint object, done */
+        if(marks.flags(parent) & Flag::Joint) {
+            parentJoint = marks.counter(parent);
+            return transformation;
         }
+
+        /* Else clean visited mark, compose transformation with parent and go
+           up the hierarchy */
+        CORRADE_INTERNAL_ASSERT(marks.flags(parent) & Flag::Visited);
+        marks.flags(parent) &= ~Flag::Visited;
+        transformation = Implementation::Transformation<Transformation>::compose(parent->transformation(), transformation);
+        o = parent;
     }
 }
 
@@ -335,46 +610,139 @@ template<class Transformation> void Object<Transformation>::doSetClean(const std
         /** @todo Ensure this doesn't crash, somehow */
         castObjects[i] = static_cast<Object<Transformation>*>(objects[i]);
 
-    setClean(std::move(castObjects));
+    setClean(castObjects);
 }
 
-template<class Transformation> void Object<Transformation>::setClean(std::vector<Object<Transformation>*> objects) {
-    /* Remove all clean objects from the list */
-    auto firstClean = std::remove_if(objects.begin(), objects.end(), [](Object<Transformation>* o) { return !o->isDirty(); });
-    objects.erase(firstClean, objects.end());
-
-    /* No dirty objects left, done */
-    if(objects.empty()) return;
-
-    /* Add non-clean parents to the list. Mark each added object as visited, so
-       they aren't added more than once */
-    for(std::size_t end = objects.size(), i = 0; i != end; ++i) {
-        Object<Transformation>* o = objects[i];
-        o->flags |= Flag::Visited;
+template<class Transformation> void Object<Transformation>::setClean(const std::vector<Object<Transformation>*>& objects) {
+    /* Put all dirty objects and their dirty parents into one list, ordered so
+       parents are always before their children. Mark each added object as
+       visited, so they aren't added more than once. */
+    std::vector<Object<Transformation>*> ordered;
+    ordered.reserve(objects.size());
+    for(Object<Transformation>* o: objects) {
+        const std::size_t begin = ordered.size();
+        for(Object<Transformation>* p = o; p && p->isDirty() && !(p->flags & Flag::Visited); p = p->parent()) {
+            p->flags |= Flag::Visited;
+            ordered.push_back(p);
+        }
+        std::reverse(ordered.begin() + begin, ordered.end());
+    }
 
+    /* Compute absolute transformations in one pass, going down the hierarchy.
+       Transformation of dirty parent is already computed, store its index in
+       the object counter. */
+    std::vector<typename Transformation::DataType> transformations(ordered.size());
+    for(std::size_t i = 0; i != ordered.size(); ++i) {
+        Object<Transformation>* o = ordered[i];
         Object<Transformation>* parent = o->parent();
-        while(parent && !(parent->flags & Flag::Visited) && parent->isDirty()) {
-            objects.push_back(parent);
-            parent = parent->parent();
-        }
+        o->counter = i;
+
+        if(!parent)
+            transformations[i] = o->transformation();
+        else if(parent->flags & Flag::Visited)
+            transformations[i] = Implementation::Transformation<Transformation>::compose(transformations[parent->counter], o->transformation());
+        else
+            transformations[i] = Implementation::Transformation<Transformation>::compose(parent->absoluteTransformation(), o->transformation());
     }
 
-    /* Cleanup all marks */
-    for(auto o: objects) o->flags &= ~Flag::Visited;
+    /* Clean all objects and cleanup the marks */
+    for(std::size_t i = 0; i != ordered.size(); ++i) {
+        ordered[i]->flags &= ~Flag::Visited;
+        ordered[i]->counter = 0xFFFFFFFFu;
+        ordered[i]->setClean(transformations[i]);
+        CORRADE_ASSERT(!ordered[i]->isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
+    }
+}
 
-    /* Compute absolute transformations */
-    Scene<Transformation>* scene = objects[0]->scene();
-    CORRADE_ASSERT(scene, "Object::setClean(): objects must be part of some scene", );
-    std::vector<typename Transformation::DataType> transformations(scene->transformations(objects));
+template<class Transformation> void Object<Transformation>::enqueueDirty() {
+    /* Already queued or some parent is dirty, thus this object will be
+       cleaned together with it */
+    if(nextDirty != this || !isDirty() || (parent() && parent()->isDirty())) return;
+
+    /* Nothing to do if the object is not part of any scene or it is the scene
+       itself */
+    Object<Transformation>* scene = this->scene();
+    if(!scene || scene == this) return;
+
+    /* Add it to the end of the queue */
+    previousDirty = scene->previousDirty;
+    nextDirty = scene;
+    scene->previousDirty->nextDirty = this;
+    scene->previousDirty = this;
+}
 
-    /* Go through all objects and clean them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
-        /* The object might be duplicated in the list, don't clean it more than once */
-        if(!objects[i]->isDirty()) continue;
+template<class Transformation> void Object<Transformation>::dequeueDirty() {
+    previousDirty->nextDirty = nextDirty;
+    nextDirty->previousDirty = previousDirty;
+    previousDirty = nextDirty = this;
+}
+
+template<class Transformation> void Object<Transformation>::clearDirtyQueue() {
+    while(nextDirty != this) nextDirty->dequeueDirty();
+}
 
-        objects[i]->setClean(transformations[i]);
-        CORRADE_ASSERT(!objects[i]->isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
+template<class Transformation> void Object<Transformation>::cleanDirtyQueue() {
+    /* Absolute transformations of objects on current path from the root of
+       cleaned subtree */
+    std::vector<typename Transformation::DataType> transformations(1);
+
+    /* Clean the whole subtree without recursion, going down the hierarchy.
+       Children of dirty object are always dirty. */
+    auto cleanSubtree = [&transformations](Object<Transformation>* root) {
+        transformations[0] = root->parent() ? Implementation::Transformation<Transformation>::compose(root->parent()->absoluteTransformation(), root->transformation()) : root->transformation();
+
+        std::size_t depth = 0;
+        Object<Transformation>* o = root;
+        for(;;) {
+            o->setClean(transformations[depth]);
+            CORRADE_ASSERT(!o->isDirty(), "SceneGraph::Scene::setAllClean(): original implementation was not called", );
+
+            /* Go to first child. If there is none, go to next sibling of the
+               object or of the nearest parent which has some. */
+            Object<Transformation>* next = o->firstChild();
+            if(next) ++depth;
+            else while(o != root) {
+                if((next = o->nextSibling())) break;
+                o = o->parent();
+                --depth;
+            }
+
+            if(!next) break;
+            o = next;
+
+            if(transformations.size() == depth) transformations.emplace_back();
+            transformations[depth] = Implementation::Transformation<Transformation>::compose(transformations[depth - 1], o->transformation());
+        }
+    };
+
+    /* If the scene itself is dirty, everything is dirty. Otherwise go through
+       all subtrees in the queue, skipping these which have dirty parent, as
+       they are cleaned together with the parent. */
+    std::vector<Object<Transformation>*> cleanObjects;
+    if(isDirty()) cleanSubtree(this);
+    else for(Object<Transformation>* root = nextDirty; root != this; root = root->nextDirty) {
+        if(root->isDirty()) {
+            if(!(root->parent() && root->parent()->isDirty())) cleanSubtree(root);
+            continue;
+        }
+
+        /* The root was cleaned separately since it was queued, together with
+           path to some of its descendants. Dirty children of that path are
+           not queued, as their parent was dirty at the time, clean them now.
+           Children of dirty object are always dirty, thus only the clean
+           part of the subtree needs to be searched. */
+        cleanObjects.push_back(root);
+        while(!cleanObjects.empty()) {
+            Object<Transformation>* o = cleanObjects.back();
+            cleanObjects.pop_back();
+            for(Object<Transformation>* child = o->firstChild(); child; child = child->nextSibling()) {
+                if(child->isDirty()) cleanSubtree(child);
+                else cleanObjects.push_back(child);
+            }
+        }
     }
+
+    clearDirtyQueue();
 }
 
 template<class Transformation> void Object<Transformation>::setClean(const typename Transformation::DataType& absoluteTransformation) {
@@ -408,8 +776,10 @@ template<class Transformation> void Object<Transformation>::setClean(const typen
         }
     }
 
-    /* Mark object as clean */
+    /* Mark object as clean, cache the transformation */
+    cachedAbsoluteTransformation = absoluteTransformation;
     flags &= ~Flag::Dirty;
+    flags |= Flag::CachedAbsolute;
 }
 
 }}
@@ -0,0 +1,107 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ObjectPool.h"
+
+#include <Utility/Assert.h>
+
+namespace Magnum { namespace SceneGraph {
+
+/*
+Each object is preceded by a header containing pointer to bucket from which it
+was allocated (or `nullptr` for heap allocation). The header is 16 bytes to
+keep the objects aligned. Free blocks in each bucket form a singly linked
+list, the pointer to next free block is stored in place of the object.
+*/
+
+namespace {
+    constexpr std::size_t HeaderSize = 16;
+    constexpr std::size_t SizeClass = 16;
+}
+
+ObjectPool::ObjectPool(const std::size_t chunkSize): _chunkSize(chunkSize), _allocatedCount(0), _capacity(0), _buckets(MaxSize/SizeClass, Bucket{this, nullptr}) {
+    CORRADE_ASSERT(chunkSize, "SceneGraph::ObjectPool: chunk size must be at least one", );
+}
+
+ObjectPool::~ObjectPool() {
+    CORRADE_ASSERT(!_allocatedCount, "SceneGraph::ObjectPool::~ObjectPool():" << _allocatedCount << "objects were not destroyed", );
+
+    for(char* chunk: _chunks) delete[] chunk;
+}
+
+void* ObjectPool::allocate(const std::size_t size) {
+    /* Too large, allocate on the heap */
+    if(size > MaxSize || !size) return allocateUnpooled(size);
+
+    const std::size_t sizeClass = (size + SizeClass - 1)/SizeClass;
+    Bucket& bucket = _buckets[sizeClass - 1];
+
+    /* No free block, allocate new chunk and put all its blocks to the free
+       list */
+    if(!bucket.free) {
+        const std::size_t blockSize = HeaderSize + sizeClass*SizeClass;
+        char* chunk = new char[_chunkSize*blockSize];
+        _chunks.push_back(chunk);
+        _capacity += _chunkSize;
+
+        for(std::size_t i = _chunkSize; i != 0; --i) {
+            char* block = chunk + (i - 1)*blockSize;
+            *reinterpret_cast<Bucket**>(block) = &bucket;
+            *reinterpret_cast<void**>(block + HeaderSize) = bucket.free;
+            bucket.free = block + HeaderSize;
+        }
+    }
+
+    /* Take first free block */
+    void* memory = bucket.free;
+    bucket.free = *static_cast<void**>(memory);
+    ++_allocatedCount;
+    return memory;
+}
+
+void* ObjectPool::allocateUnpooled(const std::size_t size) {
+    char* block = static_cast<char*>(::operator new(HeaderSize + size));
+    *reinterpret_cast<Bucket**>(block) = nullptr;
+    return block + HeaderSize;
+}
+
+void ObjectPool::deallocate(void* const memory) {
+    if(!memory) return;
+
+    char* block = static_cast<char*>(memory) - HeaderSize;
+    Bucket* bucket = *reinterpret_cast<Bucket**>(block);
+
+    /* Allocated on the heap */
+    if(!bucket) {
+        ::operator delete(block);
+        return;
+    }
+
+    /* Put the block back to the free list */
+    *static_cast<void**>(memory) = bucket->free;
+    bucket->free = memory;
+    --bucket->pool->_allocatedCount;
+}
+
+}}
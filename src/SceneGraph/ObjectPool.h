@@ -0,0 +1,184 @@
+#ifndef Magnum_SceneGraph_ObjectPool_h
+#define Magnum_SceneGraph_ObjectPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::ObjectPool, @ref Magnum::SceneGraph::PoolAllocated
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "SceneGraph/magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Memory pool for objects and features
+
+Allocates memory for objects and features in large chunks instead of
+allocating each of them separately on the heap. Memory of destroyed objects
+is reused for new ones of similar size, so spawning and destroying many
+short-lived objects doesn't fragment the heap. All the chunks are freed at
+once when the pool is destroyed.
+
+The pool is used together with @ref PoolAllocated, which is added as an
+additional base to your object or feature classes:
+@code
+class Bullet: public Object3D, SceneGraph::Drawable3D, public SceneGraph::PoolAllocated {
+    // ...
+};
+
+SceneGraph::ObjectPool pool;
+Scene3D scene;
+
+new(pool) Bullet(&scene, &drawables);
+@endcode
+
+The ownership semantics stay the same as with plain `new` -- the object is
+deleted either explicitly or together with its parent and its memory is then
+returned back to the pool. All objects allocated from the pool must be
+destroyed before the pool itself, thus the pool should be created before the
+scene. Objects larger than @ref MaxSize bytes are allocated on the heap.
+
+The pool is not thread-safe, all allocations and deallocations from given
+pool must be done from the same thread.
+@see @ref scenegraph-pool
+*/
+class MAGNUM_SCENEGRAPH_EXPORT ObjectPool {
+    public:
+        /** @brief Max size of object allocated from the pool */
+        static const std::size_t MaxSize = 1024;
+
+        /**
+         * @brief Constructor
+         * @param chunkSize     Count of objects allocated at once
+         *
+         * Memory is allocated separately for each object size class, each
+         * time @p chunkSize objects at once.
+         */
+        explicit ObjectPool(std::size_t chunkSize = 256);
+
+        /** @brief Copying is not allowed */
+        ObjectPool(const ObjectPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool(ObjectPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all allocated memory. Expects that all objects allocated from
+         * the pool were destroyed.
+         */
+        ~ObjectPool();
+
+        /** @brief Copying is not allowed */
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        /** @brief Count of objects currently allocated from the pool */
+        std::size_t allocatedCount() const { return _allocatedCount; }
+
+        /** @brief Count of objects which fit into already allocated memory */
+        std::size_t capacity() const { return _capacity; }
+
+        /**
+         * @brief Allocate memory
+         *
+         * Returns memory for object of given size, aligned to 16 bytes. You
+         * usually don't need to call this function directly, use
+         * @ref PoolAllocated instead. The memory must be freed with
+         * @ref deallocate().
+         */
+        void* allocate(std::size_t size);
+
+        /**
+         * @brief Allocate memory on the heap
+         *
+         * Returns heap memory which can be freed with @ref deallocate().
+         */
+        static void* allocateUnpooled(std::size_t size);
+
+        /**
+         * @brief Free memory
+         *
+         * The memory must be allocated with @ref allocate() or
+         * @ref allocateUnpooled(). Memory allocated from the pool is returned
+         * back to it.
+         */
+        static void deallocate(void* memory);
+
+    private:
+        struct MAGNUM_SCENEGRAPH_LOCAL Bucket {
+            ObjectPool* pool;
+            void* free;
+        };
+
+        std::size_t _chunkSize, _allocatedCount, _capacity;
+        std::vector<Bucket> _buckets;
+        std::vector<char*> _chunks;
+};
+
+/**
+@brief Base for pool-allocated objects and features
+
+Adds placement `new` taking @ref ObjectPool and `delete` which returns the
+memory back to the pool. See @ref ObjectPool for more information. Objects
+created with plain `new` are allocated on the heap as usual.
+*/
+class PoolAllocated {
+    public:
+        /** @brief Allocate object from given pool */
+        static void* operator new(std::size_t size, ObjectPool& pool) {
+            return pool.allocate(size);
+        }
+
+        /** @brief Allocate object on the heap */
+        static void* operator new(std::size_t size) {
+            return ObjectPool::allocateUnpooled(size);
+        }
+
+        /** @brief Free the object */
+        static void operator delete(void* memory) {
+            ObjectPool::deallocate(memory);
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Called when constructor of object allocated from the pool throws */
+        static void operator delete(void* memory, ObjectPool&) {
+            ObjectPool::deallocate(memory);
+        }
+        #endif
+
+    protected:
+        ~PoolAllocated() = default;
+};
+
+}}
+
+#endif
@@ -37,11 +37,40 @@ namespace Magnum { namespace SceneGraph {
 
 Basically Object which cannot have parent or non-default transformation.
 See @ref scenegraph for introduction.
+
+@section Scene-dirty-queue Cleaning all dirty objects
+
+The scene keeps a queue of subtrees which were marked as dirty since they were
+last cleaned. When you need all objects in the scene to be clean, for example
+after animating large hierarchy, you can use @ref setAllClean() instead of
+calling @ref Object::setClean() on each object, which cleans all queued
+subtrees in one pass without walking the hierarchy up from each object.
 */
 template<class Transformation> class Scene: public Object<Transformation> {
     public:
         explicit Scene() = default;
 
+        /**
+         * @brief Destructor
+         *
+         * Removes all objects from the dirty queue and destroys all
+         * children.
+         */
+        ~Scene() { this->clearDirtyQueue(); }
+
+        /**
+         * @brief Clean absolute transformations of all objects in the scene
+         *
+         * Goes through all subtrees marked as dirty since the last cleaning
+         * and cleans all objects in them, going down the hierarchy, thus
+         * each transformation is computed only once. Clean parts of the scene
+         * are not touched, except for queued subtrees which were partially
+         * cleaned using @ref Object::setClean() in the meantime, for which the
+         * already clean part is searched for remaining dirty objects.
+         * @see @ref Object::setClean(), @ref Object::setDirty()
+         */
+        void setAllClean() { this->cleanDirtyQueue(); }
+
     private:
         bool isScene() const override final { return true; }
 };
@@ -128,6 +128,17 @@ typedef Animable<3, Float> Animable3D;
 
 enum class AnimationState: UnsignedByte;
 
+template<UnsignedInt, class> class AnimableBatch;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicAnimableBatch2D = AnimableBatch<2, T>;
+template<class T> using BasicAnimableBatch3D = AnimableBatch<3, T>;
+typedef BasicAnimableBatch2D<Float> AnimableBatch2D;
+typedef BasicAnimableBatch3D<Float> AnimableBatch3D;
+#else
+typedef AnimableBatch<2, Float> AnimableBatch2D;
+typedef AnimableBatch<3, Float> AnimableBatch3D;
+#endif
+
 template<UnsignedInt, class> class AnimableGroup;
 #ifndef CORRADE_GCC46_COMPATIBILITY
 template<class T> using BasicAnimableGroup2D = AnimableGroup<2, T>;
@@ -139,6 +150,28 @@ typedef AnimableGroup<2, Float> AnimableGroup2D;
 typedef AnimableGroup<3, Float> AnimableGroup3D;
 #endif
 
+template<UnsignedInt, class> class BoundingVolume;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+#else
+typedef BoundingVolume<2, Float> BoundingVolume2D;
+typedef BoundingVolume<3, Float> BoundingVolume3D;
+#endif
+
+template<UnsignedInt, class> class BoundingVolumeHierarchy;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicBoundingVolumeHierarchy2D = BoundingVolumeHierarchy<2, T>;
+template<class T> using BasicBoundingVolumeHierarchy3D = BoundingVolumeHierarchy<3, T>;
+typedef BasicBoundingVolumeHierarchy2D<Float> BoundingVolumeHierarchy2D;
+typedef BasicBoundingVolumeHierarchy3D<Float> BoundingVolumeHierarchy3D;
+#else
+typedef BoundingVolumeHierarchy<2, Float> BoundingVolumeHierarchy2D;
+typedef BoundingVolumeHierarchy<3, Float> BoundingVolumeHierarchy3D;
+#endif
+
 template<class> class BasicCamera2D;
 template<class> class BasicCamera3D;
 typedef BasicCamera2D<Float> Camera2D;
@@ -177,12 +210,75 @@ typedef DrawableGroup<2, Float> DrawableGroup2D;
 typedef DrawableGroup<3, Float> DrawableGroup3D;
 #endif
 
+template<class Transformation> class FlatObject;
+template<class Transformation> class FlatScene;
+
+template<UnsignedInt, class> class FramePacket;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicFramePacket2D = FramePacket<2, T>;
+template<class T> using BasicFramePacket3D = FramePacket<3, T>;
+typedef BasicFramePacket2D<Float> FramePacket2D;
+typedef BasicFramePacket3D<Float> FramePacket3D;
+#else
+typedef FramePacket<2, Float> FramePacket2D;
+typedef FramePacket<3, Float> FramePacket3D;
+#endif
+
+template<UnsignedInt, class> class FramePacketBuffer;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicFramePacketBuffer2D = FramePacketBuffer<2, T>;
+template<class T> using BasicFramePacketBuffer3D = FramePacketBuffer<3, T>;
+typedef BasicFramePacketBuffer2D<Float> FramePacketBuffer2D;
+typedef BasicFramePacketBuffer3D<Float> FramePacketBuffer3D;
+#else
+typedef FramePacketBuffer<2, Float> FramePacketBuffer2D;
+typedef FramePacketBuffer<3, Float> FramePacketBuffer3D;
+#endif
+
+template<UnsignedInt, class> class InstancedDrawable;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicInstancedDrawable2D = InstancedDrawable<2, T>;
+template<class T> using BasicInstancedDrawable3D = InstancedDrawable<3, T>;
+typedef BasicInstancedDrawable2D<Float> InstancedDrawable2D;
+typedef BasicInstancedDrawable3D<Float> InstancedDrawable3D;
+#else
+typedef InstancedDrawable<2, Float> InstancedDrawable2D;
+typedef InstancedDrawable<3, Float> InstancedDrawable3D;
+#endif
+
+template<UnsignedInt, class> class InstancedDrawableGroup;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicInstancedDrawableGroup2D = InstancedDrawableGroup<2, T>;
+template<class T> using BasicInstancedDrawableGroup3D = InstancedDrawableGroup<3, T>;
+typedef BasicInstancedDrawableGroup2D<Float> InstancedDrawableGroup2D;
+typedef BasicInstancedDrawableGroup3D<Float> InstancedDrawableGroup3D;
+#else
+typedef InstancedDrawableGroup<2, Float> InstancedDrawableGroup2D;
+typedef InstancedDrawableGroup<3, Float> InstancedDrawableGroup3D;
+#endif
+
+enum class LevelOfDetailMetric: UnsignedByte;
+class LevelOfDetailStatistics;
+template<UnsignedInt, class> class LevelOfDetail;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicLevelOfDetail2D = LevelOfDetail<2, T>;
+template<class T> using BasicLevelOfDetail3D = LevelOfDetail<3, T>;
+typedef BasicLevelOfDetail2D<Float> LevelOfDetail2D;
+typedef BasicLevelOfDetail3D<Float> LevelOfDetail3D;
+#else
+typedef LevelOfDetail<2, Float> LevelOfDetail2D;
+typedef LevelOfDetail<3, Float> LevelOfDetail3D;
+#endif
+
 template<class> class BasicMatrixTransformation2D;
 template<class> class BasicMatrixTransformation3D;
 typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
 typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
 template<class Transformation> class Object;
+class ObjectPool;
+
+class PoolAllocated;
 
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
@@ -191,6 +287,22 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<class Transformation> class TransformationContext;
+
+template<class> class Track;
+enum class TrackInterpolation: UnsignedByte;
+
+template<UnsignedInt, class> class TrackPlayer;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicTrackPlayer2D = TrackPlayer<2, T>;
+template<class T> using BasicTrackPlayer3D = TrackPlayer<3, T>;
+typedef BasicTrackPlayer2D<Float> TrackPlayer2D;
+typedef BasicTrackPlayer3D<Float> TrackPlayer3D;
+#else
+typedef TrackPlayer<2, Float> TrackPlayer2D;
+typedef TrackPlayer<3, Float> TrackPlayer3D;
+#endif
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 #ifndef CORRADE_GCC46_COMPATIBILITY
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
@@ -0,0 +1,157 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "SceneGraph/Animable.h"
+#include "SceneGraph/AnimableBatch.h"
+#include "SceneGraph/AnimableGroup.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class AnimableBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        AnimableBenchmark();
+
+        void animables10k();
+        void animables100k();
+        void animables100kMostlyStopped();
+        void batch10k();
+        void batch100k();
+        void batch100kMostlyStopped();
+
+    private:
+        void stepAnimables(const std::string& name, std::size_t count, std::size_t runningEach);
+        void stepBatch(const std::string& name, std::size_t count, std::size_t runningEach);
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+
+class Animation: public SceneGraph::Animable3D {
+    public:
+        explicit Animation(AbstractObject3D& object, AnimableGroup3D* group): SceneGraph::Animable3D(object, group), angle(0.0f) {}
+
+        Float angle;
+
+    protected:
+        void animationStep(Float, Float delta) override {
+            angle += 15.0f*delta;
+        }
+};
+
+class Batch: public SceneGraph::AnimableBatch3D {
+    public:
+        explicit Batch(AnimableGroup3D* group): SceneGraph::AnimableBatch3D(group) {}
+
+        std::vector<Float> angle;
+
+    protected:
+        void animationStep(const std::size_t* indices, const Float*, std::size_t count, Float delta) override {
+            for(std::size_t i = 0; i != count; ++i)
+                angle[indices[i]] += 15.0f*delta;
+        }
+};
+
+}
+
+AnimableBenchmark::AnimableBenchmark() {
+    addTests({&AnimableBenchmark::animables10k,
+              &AnimableBenchmark::animables100k,
+              &AnimableBenchmark::animables100kMostlyStopped,
+              &AnimableBenchmark::batch10k,
+              &AnimableBenchmark::batch100k,
+              &AnimableBenchmark::batch100kMostlyStopped});
+}
+
+void AnimableBenchmark::stepAnimables(const std::string& name, std::size_t count, std::size_t runningEach) {
+    Scene3D scene;
+    AnimableGroup3D group;
+
+    /* Objects scattered in memory similarly to real usage */
+    for(std::size_t i = 0; i != count; ++i) {
+        auto o = new Object3D(&scene);
+        auto a = new Animation(*o, &group);
+        if(i % runningEach == 0) a->setState(AnimationState::Running);
+    }
+
+    Float time = 0.0f;
+    group.step(time, 0.0f);
+    benchmark(name, 100, [&]() {
+        time += 1.0f/60.0f;
+        group.step(time, 1.0f/60.0f);
+    });
+
+    CORRADE_COMPARE(group.runningCount(), (count + runningEach - 1)/runningEach);
+}
+
+void AnimableBenchmark::stepBatch(const std::string& name, std::size_t count, std::size_t runningEach) {
+    AnimableGroup3D group;
+    Batch batch(&group);
+    batch.angle.resize(count);
+    for(std::size_t i = 0; i != count; ++i) {
+        const std::size_t index = batch.add();
+        if(i % runningEach == 0) batch.setState(index, AnimationState::Running);
+    }
+
+    Float time = 0.0f;
+    group.step(time, 0.0f);
+    benchmark(name, 100, [&]() {
+        time += 1.0f/60.0f;
+        group.step(time, 1.0f/60.0f);
+    });
+
+    CORRADE_COMPARE(batch.runningCount(), (count + runningEach - 1)/runningEach);
+}
+
+void AnimableBenchmark::animables10k() {
+    stepAnimables("stepping 10k running animables", 10000, 1);
+}
+
+void AnimableBenchmark::animables100k() {
+    stepAnimables("stepping 100k running animables", 100000, 1);
+}
+
+void AnimableBenchmark::animables100kMostlyStopped() {
+    stepAnimables("stepping 100k animables, 1k running", 100000, 100);
+}
+
+void AnimableBenchmark::batch10k() {
+    stepBatch("stepping batch of 10k running animations", 10000, 1);
+}
+
+void AnimableBenchmark::batch100k() {
+    stepBatch("stepping batch of 100k running animations", 100000, 1);
+}
+
+void AnimableBenchmark::batch100kMostlyStopped() {
+    stepBatch("stepping batch of 100k animations, 1k running", 100000, 100);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AnimableBenchmark)
@@ -22,10 +22,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
 #include <sstream>
 #include <TestSuite/Tester.h>
 
 #include "SceneGraph/Animable.h"
+#include "SceneGraph/AnimableBatch.h"
 #include "SceneGraph/AnimableGroup.h"
 #include "SceneGraph/MatrixTransformation3D.h"
 
@@ -41,6 +43,13 @@ class AnimableTest: public TestSuite::Tester {
         void repeat();
         void stop();
         void pause();
+        void groupChange();
+        void groupChangeThroughBase();
+        void destroyRunning();
+
+        void batch();
+        void batchRemove();
+        void batchDestroyGroup();
 
         void debug();
 };
@@ -54,6 +63,13 @@ AnimableTest::AnimableTest() {
               &AnimableTest::repeat,
               &AnimableTest::stop,
               &AnimableTest::pause,
+              &AnimableTest::groupChange,
+              &AnimableTest::groupChangeThroughBase,
+              &AnimableTest::destroyRunning,
+
+              &AnimableTest::batch,
+              &AnimableTest::batchRemove,
+              &AnimableTest::batchDestroyGroup,
 
               &AnimableTest::debug});
 }
@@ -351,6 +367,241 @@ void AnimableTest::pause() {
     CORRADE_COMPARE(animable.time, 2.0f);
 }
 
+void AnimableTest::groupChange() {
+    Object3D object;
+    AnimableGroup3D group1, group2;
+    OneShotAnimable animable(object, &group1);
+    group1.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group1.runningCount(), 1);
+
+    /* Moving running animable to another group continues the animation
+       there */
+    group2.add(animable);
+    CORRADE_COMPARE(group1.runningCount(), 0);
+    CORRADE_COMPARE(group2.runningCount(), 1);
+    group1.step(2.0f, 0.5f);
+    CORRADE_COMPARE(animable.time, 0.0f);
+    group2.step(2.0f, 0.5f);
+    CORRADE_COMPARE(animable.time, 1.0f);
+
+    /* Removed animable is not animated anymore */
+    group2.remove(animable);
+    CORRADE_COMPARE(group2.runningCount(), 0);
+    group2.step(3.0f, 0.5f);
+    CORRADE_COMPARE(animable.time, 1.0f);
+
+    /* State change outside of group is processed after adding to the group */
+    animable.setState(AnimationState::Stopped);
+    group1.add(animable);
+    group1.step(4.0f, 0.5f);
+    CORRADE_COMPARE(animable.stateChanges, "started;stopped;");
+    CORRADE_COMPARE(group1.runningCount(), 0);
+}
+
+void AnimableTest::groupChangeThroughBase() {
+    Object3D object;
+    AnimableGroup3D group1, group2;
+    OneShotAnimable animable(object, &group1);
+    OneShotAnimable other(object, &group1);
+    group1.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group1.runningCount(), 2);
+
+    /* Moving through reference to the base class has the same effect */
+    FeatureGroup3D<Animable3D>& base2 = group2;
+    base2.add(animable);
+    CORRADE_COMPARE(group1.runningCount(), 1);
+    CORRADE_COMPARE(group2.runningCount(), 1);
+    group1.step(2.0f, 0.5f);
+    CORRADE_COMPARE(animable.time, 0.0f);
+    CORRADE_COMPARE(other.time, 1.0f);
+    group2.step(2.0f, 0.5f);
+    CORRADE_COMPARE(animable.time, 1.0f);
+
+    FeatureGroup3D<Animable3D>& base1 = group1;
+    base1.remove(other);
+    CORRADE_COMPARE(group1.runningCount(), 0);
+    group1.step(3.0f, 0.5f);
+    CORRADE_COMPARE(other.time, 1.0f);
+}
+
+void AnimableTest::destroyRunning() {
+    Object3D object;
+    AnimableGroup3D group;
+    OneShotAnimable a(object, &group);
+    auto b = new OneShotAnimable(object, &group);
+    OneShotAnimable c(object, &group);
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 3);
+
+    delete b;
+    CORRADE_COMPARE(group.runningCount(), 2);
+    group.step(2.0f, 0.5f);
+    CORRADE_COMPARE(a.time, 1.0f);
+    CORRADE_COMPARE(c.time, 1.0f);
+}
+
+namespace {
+
+class Batch: public SceneGraph::AnimableBatch3D {
+    public:
+        explicit Batch(AnimableGroup3D* group): SceneGraph::AnimableBatch3D(group), stepCount(0) {}
+
+        std::size_t stepCount;
+        std::vector<Float> time;
+        std::string stateChanges;
+
+        std::size_t add(Float duration) {
+            time.push_back(-1.0f);
+            return SceneGraph::AnimableBatch3D::add(duration);
+        }
+
+        void remove(std::size_t index) {
+            time[index] = time.back();
+            time.pop_back();
+            SceneGraph::AnimableBatch3D::remove(index);
+        }
+
+    protected:
+        void animationStep(const std::size_t* indices, const Float* times, std::size_t count, Float) override {
+            ++stepCount;
+            for(std::size_t i = 0; i != count; ++i)
+                time[indices[i]] = times[i];
+        }
+
+        void animationStarted(std::size_t index) override {
+            stateChanges += "started " + std::to_string(index) + ";";
+        }
+
+        void animationPaused(std::size_t index) override {
+            stateChanges += "paused " + std::to_string(index) + ";";
+        }
+
+        void animationResumed(std::size_t index) override {
+            stateChanges += "resumed " + std::to_string(index) + ";";
+        }
+
+        void animationStopped(std::size_t index) override {
+            stateChanges += "stopped " + std::to_string(index) + ";";
+        }
+};
+
+}
+
+void AnimableTest::batch() {
+    AnimableGroup3D group;
+    Batch batch(&group);
+    CORRADE_VERIFY(batch.animables() == &group);
+
+    CORRADE_COMPARE(batch.add(10.0f), 0);
+    CORRADE_COMPARE(batch.add(0.0f), 1);
+    CORRADE_COMPARE(batch.add(10.0f), 2);
+    CORRADE_COMPARE(batch.size(), 3);
+    CORRADE_COMPARE(batch.state(0), AnimationState::Stopped);
+    CORRADE_VERIFY(!batch.isRepeated(0));
+    CORRADE_COMPARE(batch.repeatCount(0), 0);
+    CORRADE_COMPARE(batch.duration(2), 10.0f);
+
+    /* Nothing is running, animationStep() shouldn't be called */
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(batch.stepCount, 0);
+
+    /* Stopped -> paused is not supported */
+    batch.setState(0, AnimationState::Paused);
+    CORRADE_COMPARE(batch.state(0), AnimationState::Stopped);
+
+    batch.setState(0, AnimationState::Running)
+         .setState(1, AnimationState::Running)
+         .setState(2, AnimationState::Running)
+         .setRepeated(2, true)
+         .setRepeatCount(2, 2);
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(batch.stepCount, 1);
+    CORRADE_COMPARE(batch.runningCount(), 3);
+    CORRADE_COMPARE(batch.stateChanges, "started 0;started 1;started 2;");
+    CORRADE_COMPARE(batch.time, (std::vector<Float>{0.0f, 0.0f, 0.0f}));
+
+    /* Paused animation isn't stepped */
+    batch.stateChanges.clear();
+    batch.setState(1, AnimationState::Paused);
+    group.step(3.0f, 0.5f);
+    CORRADE_COMPARE(batch.stepCount, 2);
+    CORRADE_COMPARE(batch.runningCount(), 2);
+    CORRADE_COMPARE(batch.stateChanges, "paused 1;");
+    CORRADE_COMPARE(batch.time, (std::vector<Float>{2.0f, 0.0f, 2.0f}));
+
+    /* First animation is stopped after exceeding duration, third is
+       repeated, second continues from the paused time */
+    batch.stateChanges.clear();
+    batch.setState(1, AnimationState::Running);
+    group.step(12.0f, 0.5f);
+    CORRADE_COMPARE(batch.stepCount, 3);
+    CORRADE_COMPARE(batch.runningCount(), 2);
+    CORRADE_COMPARE(batch.stateChanges, "stopped 0;resumed 1;");
+    CORRADE_COMPARE(batch.state(0), AnimationState::Stopped);
+    CORRADE_COMPARE(batch.time, (std::vector<Float>{2.0f, 2.0f, 1.0f}));
+
+    /* Repeat count exceeded */
+    batch.stateChanges.clear();
+    group.step(22.0f, 0.5f);
+    CORRADE_COMPARE(batch.runningCount(), 1);
+    CORRADE_COMPARE(batch.stateChanges, "stopped 2;");
+    CORRADE_COMPARE(batch.time, (std::vector<Float>{2.0f, 12.0f, 1.0f}));
+
+    /* Explicitly stopped */
+    batch.stateChanges.clear();
+    batch.setState(1, AnimationState::Stopped);
+    group.step(23.0f, 0.5f);
+    CORRADE_COMPARE(batch.runningCount(), 0);
+    CORRADE_COMPARE(batch.stepCount, 4);
+    CORRADE_COMPARE(batch.stateChanges, "stopped 1;");
+}
+
+void AnimableTest::batchRemove() {
+    AnimableGroup3D group;
+    Batch batch(&group);
+    for(std::size_t i = 0; i != 4; ++i)
+        batch.setState(batch.add(10.0f), AnimationState::Running);
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(batch.runningCount(), 4);
+    batch.setState(1, AnimationState::Paused);
+    group.step(2.0f, 0.5f);
+    CORRADE_COMPARE(batch.runningCount(), 3);
+
+    /* Last animation is moved to place of removed one */
+    batch.time[3] = 100.0f;
+    batch.remove(0);
+    CORRADE_COMPARE(batch.size(), 3);
+    CORRADE_COMPARE(batch.runningCount(), 2);
+    CORRADE_COMPARE(batch.time[0], 100.0f);
+
+    /* Removing paused animation doesn't change running count */
+    batch.remove(1);
+    CORRADE_COMPARE(batch.size(), 2);
+    CORRADE_COMPARE(batch.runningCount(), 2);
+
+    batch.stateChanges.clear();
+    group.step(3.0f, 0.5f);
+    CORRADE_COMPARE(batch.stateChanges, "");
+    CORRADE_COMPARE(batch.time, (std::vector<Float>{2.0f, 2.0f}));
+
+    batch.setState(0, AnimationState::Stopped);
+    batch.remove(1);
+    group.step(4.0f, 0.5f);
+    CORRADE_COMPARE(batch.stateChanges, "stopped 0;");
+    CORRADE_COMPARE(batch.runningCount(), 0);
+}
+
+void AnimableTest::batchDestroyGroup() {
+    std::unique_ptr<Batch> batch;
+    {
+        AnimableGroup3D group;
+        batch.reset(new Batch(&group));
+        Batch another(&group);
+    }
+
+    CORRADE_VERIFY(!batch->animables());
+}
+
 void AnimableTest::debug() {
     std::ostringstream o;
     Debug(&o) << AnimationState::Running;
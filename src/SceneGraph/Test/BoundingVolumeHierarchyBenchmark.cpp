@@ -0,0 +1,141 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "SceneGraph/BoundingVolume.h"
+#include "SceneGraph/BoundingVolumeHierarchy.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class BoundingVolumeHierarchyBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        BoundingVolumeHierarchyBenchmark();
+        ~BoundingVolumeHierarchyBenchmark();
+
+        void query10k();
+        void update10k();
+
+    private:
+        std::vector<BoundingVolume3D*> bruteForce(const Range3D& box);
+
+        Scene3D scene;
+        BoundingVolumeHierarchy3D hierarchy;
+        std::vector<Object3D*> objects;
+        std::vector<BoundingVolume3D*> volumes;
+        std::vector<Range3D> queries;
+};
+
+BoundingVolumeHierarchyBenchmark::BoundingVolumeHierarchyBenchmark() {
+    addTests({&BoundingVolumeHierarchyBenchmark::query10k,
+              &BoundingVolumeHierarchyBenchmark::update10k});
+
+    /* 10k objects with unit boxes randomly placed in a 200^3 cube */
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<Float> position(-100.0f, 100.0f);
+    for(std::size_t i = 0; i != 10000; ++i) {
+        objects.push_back(new Object3D(&scene));
+        objects.back()->translate({position(generator), position(generator), position(generator)});
+        volumes.push_back(new BoundingVolume3D(*objects.back(), {Vector3(-0.5f), Vector3(0.5f)}, &hierarchy));
+    }
+
+    for(std::size_t i = 0; i != 100; ++i) {
+        const Vector3 center(position(generator), position(generator), position(generator));
+        queries.push_back({center - Vector3(10.0f), center + Vector3(10.0f)});
+    }
+
+    hierarchy.update();
+}
+
+BoundingVolumeHierarchyBenchmark::~BoundingVolumeHierarchyBenchmark() {
+    for(Object3D* object: objects) delete object;
+}
+
+std::vector<BoundingVolume3D*> BoundingVolumeHierarchyBenchmark::bruteForce(const Range3D& box) {
+    std::vector<BoundingVolume3D*> out;
+    for(BoundingVolume3D* volume: volumes) {
+        const Range3D absolute = volume->absoluteBox();
+        bool intersects = true;
+        for(std::size_t i = 0; i != 3; ++i)
+            if(absolute.max()[i] < box.min()[i] || box.max()[i] < absolute.min()[i])
+                intersects = false;
+        if(intersects) out.push_back(volume);
+    }
+
+    return out;
+}
+
+void BoundingVolumeHierarchyBenchmark::query10k() {
+    std::size_t bruteForceCount = 0;
+    benchmark("100 box queries in 10k volumes, brute force", 10, [&]() {
+        bruteForceCount = 0;
+        for(const Range3D& query: queries)
+            bruteForceCount += bruteForce(query).size();
+    });
+
+    std::size_t hierarchyCount = 0;
+    benchmark("100 box queries in 10k volumes, hierarchy", 10, [&]() {
+        hierarchyCount = 0;
+        for(const Range3D& query: queries)
+            hierarchyCount += hierarchy.intersecting(query).size();
+    });
+
+    CORRADE_COMPARE(hierarchyCount, bruteForceCount);
+}
+
+void BoundingVolumeHierarchyBenchmark::update10k() {
+    /* Each frame 1% of objects moves, the tree is refit and queried */
+    std::size_t frame = 0;
+    benchmark("moving 1% of 10k volumes, refit and query", 10, [&]() {
+        for(std::size_t i = frame % 100; i < objects.size(); i += 100)
+            objects[i]->translate(Vector3::xAxis((frame & 1) ? -1.0f : 1.0f));
+        ++frame;
+        hierarchy.intersecting(queries[frame % queries.size()]);
+    });
+
+    benchmark("moving 1% of 10k volumes, rebuild and query", 10, [&]() {
+        for(std::size_t i = frame % 100; i < objects.size(); i += 100)
+            objects[i]->translate(Vector3::xAxis((frame & 1) ? -1.0f : 1.0f));
+        ++frame;
+        hierarchy.rebuild();
+        hierarchy.intersecting(queries[frame % queries.size()]);
+    });
+
+    std::size_t hierarchyCount = 0, bruteForceCount = 0;
+    for(const Range3D& query: queries) {
+        hierarchyCount += hierarchy.intersecting(query).size();
+        bruteForceCount += bruteForce(query).size();
+    }
+    CORRADE_COMPARE(hierarchyCount, bruteForceCount);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BoundingVolumeHierarchyBenchmark)
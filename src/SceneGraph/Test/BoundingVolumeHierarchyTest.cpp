@@ -0,0 +1,448 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Functions.h"
+#include "SceneGraph/BoundingVolume.h"
+#include "SceneGraph/BoundingVolumeHierarchy.h"
+#include "SceneGraph/Camera3D.h"
+#include "SceneGraph/MatrixTransformation2D.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class BoundingVolumeHierarchyTest: public TestSuite::Tester {
+    public:
+        BoundingVolumeHierarchyTest();
+
+        void empty();
+        void absoluteBox();
+        void intersecting();
+        void intersectingSphere();
+        void intersectingFrustum();
+        void intersectingRay();
+        void nearest();
+        void refit();
+        void setBox();
+        void addRemove();
+        void destroy();
+        void destroyHierarchy();
+        void twoVolumesOnObject();
+        void random();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+BoundingVolumeHierarchyTest::BoundingVolumeHierarchyTest() {
+    addTests({&BoundingVolumeHierarchyTest::empty,
+              &BoundingVolumeHierarchyTest::absoluteBox,
+              &BoundingVolumeHierarchyTest::intersecting,
+              &BoundingVolumeHierarchyTest::intersectingSphere,
+              &BoundingVolumeHierarchyTest::intersectingFrustum,
+              &BoundingVolumeHierarchyTest::intersectingRay,
+              &BoundingVolumeHierarchyTest::nearest,
+              &BoundingVolumeHierarchyTest::refit,
+              &BoundingVolumeHierarchyTest::setBox,
+              &BoundingVolumeHierarchyTest::addRemove,
+              &BoundingVolumeHierarchyTest::destroy,
+              &BoundingVolumeHierarchyTest::destroyHierarchy,
+              &BoundingVolumeHierarchyTest::twoVolumesOnObject,
+              &BoundingVolumeHierarchyTest::random});
+}
+
+template<class T> std::vector<T*> sorted(std::vector<T*> volumes) {
+    std::sort(volumes.begin(), volumes.end());
+    return volumes;
+}
+
+void BoundingVolumeHierarchyTest::empty() {
+    BoundingVolumeHierarchy3D hierarchy;
+    CORRADE_COMPARE(hierarchy.bounds(), Range3D());
+    CORRADE_VERIFY(hierarchy.intersecting({Vector3(-1.0f), Vector3(1.0f)}).empty());
+    CORRADE_VERIFY(hierarchy.intersectingRay({}, Vector3::zAxis()).empty());
+    CORRADE_VERIFY(!hierarchy.nearest({}));
+}
+
+void BoundingVolumeHierarchyTest::absoluteBox() {
+    Scene2D scene;
+    Object2D parent(&scene);
+    parent.translate({10.0f, 0.0f});
+    Object2D object(&parent);
+    object.scale(Vector2(2.0f))
+        .rotate(Deg(90.0f));
+
+    BoundingVolumeHierarchy2D hierarchy;
+    BoundingVolume2D volume(object, {{0.0f, -1.0f}, {3.0f, 1.0f}}, &hierarchy);
+    CORRADE_VERIFY(volume.hierarchy() == &hierarchy);
+
+    hierarchy.update();
+    CORRADE_VERIFY(!object.isDirty());
+    CORRADE_COMPARE(volume.absoluteBox(), Range2D({8.0f, 0.0f}, {12.0f, 6.0f}));
+    CORRADE_COMPARE(hierarchy.bounds(), Range2D({8.0f, 0.0f}, {12.0f, 6.0f}));
+}
+
+void BoundingVolumeHierarchyTest::intersecting() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D hierarchy;
+
+    Object3D a(&scene);
+    a.translate(Vector3::xAxis(-5.0f));
+    BoundingVolume3D va(a, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    Object3D b(&scene);
+    BoundingVolume3D vb(b, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    Object3D c(&scene);
+    c.translate(Vector3::xAxis(5.0f));
+    BoundingVolume3D vc(c, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    CORRADE_COMPARE(hierarchy.bounds(), Range3D({-6.0f, -1.0f, -1.0f}, {6.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(sorted(hierarchy.intersecting({{-4.5f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}})),
+        sorted(std::vector<BoundingVolume3D*>{&va, &vb}));
+    CORRADE_COMPARE(hierarchy.intersecting({{6.5f, 0.0f, 0.0f}, {7.0f, 1.0f, 1.0f}}),
+        std::vector<BoundingVolume3D*>{});
+
+    /* Touching boxes intersect */
+    CORRADE_COMPARE(hierarchy.intersecting({{6.0f, 0.0f, 0.0f}, {7.0f, 1.0f, 1.0f}}),
+        std::vector<BoundingVolume3D*>{&vc});
+}
+
+void BoundingVolumeHierarchyTest::intersectingSphere() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D hierarchy;
+
+    Object3D a(&scene);
+    BoundingVolume3D va(a, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    Object3D b(&scene);
+    b.translate(Vector3(5.0f));
+    BoundingVolume3D vb(b, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    /* Distance to corner of the first box is sqrt(3) */
+    CORRADE_COMPARE(hierarchy.intersectingSphere(Vector3(2.0f), 1.8f),
+        std::vector<BoundingVolume3D*>{&va});
+    CORRADE_COMPARE(hierarchy.intersectingSphere(Vector3(2.0f), 1.7f),
+        std::vector<BoundingVolume3D*>{});
+    CORRADE_COMPARE(sorted(hierarchy.intersectingSphere(Vector3(2.0f), 3.5f)),
+        sorted(std::vector<BoundingVolume3D*>{&va, &vb}));
+}
+
+void BoundingVolumeHierarchyTest::intersectingFrustum() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D hierarchy;
+
+    /* In front of the camera */
+    Object3D a(&scene);
+    a.translate(Vector3::zAxis(-5.0f));
+    BoundingVolume3D front(a, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    /* Behind the camera */
+    Object3D b(&scene);
+    b.translate(Vector3::zAxis(5.0f));
+    BoundingVolume3D behind(b, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    /* Far to the side */
+    Object3D c(&scene);
+    c.translate({50.0f, 0.0f, -5.0f});
+    BoundingVolume3D side(c, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+    CORRADE_COMPARE(hierarchy.intersectingFrustum(camera),
+        std::vector<BoundingVolume3D*>{&front});
+    CORRADE_COMPARE(hierarchy.intersectingFrustum(camera.projectionMatrix()),
+        std::vector<BoundingVolume3D*>{&front});
+
+    /* Moving the camera changes the result */
+    cameraObject.translate(Vector3::xAxis(50.0f));
+    CORRADE_COMPARE(hierarchy.intersectingFrustum(camera),
+        std::vector<BoundingVolume3D*>{&side});
+}
+
+void BoundingVolumeHierarchyTest::intersectingRay() {
+    Scene2D scene;
+    BoundingVolumeHierarchy2D hierarchy;
+
+    std::vector<Object2D*> objects;
+    std::vector<BoundingVolume2D*> volumes;
+    for(Int i = 0; i != 5; ++i) {
+        objects.push_back(new Object2D(&scene));
+        objects.back()->translate({Float(4 - i)*3.0f, Float(i%2)});
+        volumes.push_back(new BoundingVolume2D(*objects.back(), {Vector2(-1.0f), Vector2(1.0f)}, &hierarchy));
+    }
+
+    /* Sorted from the nearest, box containing the origin is first */
+    CORRADE_COMPARE(hierarchy.intersectingRay({12.5f, 0.0f}, Vector2::xAxis(-1.0f)),
+        (std::vector<BoundingVolume2D*>{volumes[0], volumes[1], volumes[2], volumes[3], volumes[4]}));
+
+    /* Going up hits only the odd ones */
+    CORRADE_COMPARE(hierarchy.intersectingRay({-5.0f, 1.5f}, Vector2::xAxis()),
+        (std::vector<BoundingVolume2D*>{volumes[3], volumes[1]}));
+
+    /* Going slightly down misses the upper one on the left */
+    CORRADE_COMPARE(hierarchy.intersectingRay({20.0f, 1.5f}, {-1.0f, -0.1f}),
+        (std::vector<BoundingVolume2D*>{volumes[0], volumes[1], volumes[2], volumes[4]}));
+
+    /* Missing completely */
+    CORRADE_COMPARE(hierarchy.intersectingRay({0.0f, 5.0f}, Vector2::yAxis()),
+        std::vector<BoundingVolume2D*>{});
+
+    for(BoundingVolume2D* volume: volumes) delete volume;
+    for(Object2D* object: objects) delete object;
+}
+
+void BoundingVolumeHierarchyTest::nearest() {
+    Scene2D scene;
+    BoundingVolumeHierarchy2D hierarchy;
+
+    Object2D a(&scene);
+    a.translate({-10.0f, 0.0f});
+    BoundingVolume2D va(a, {Vector2(-1.0f), Vector2(1.0f)}, &hierarchy);
+
+    Object2D b(&scene);
+    b.translate({10.0f, 0.0f});
+    BoundingVolume2D vb(b, {Vector2(-1.0f), Vector2(1.0f)}, &hierarchy);
+
+    Object2D c(&scene);
+    c.translate({0.0f, 10.0f});
+    BoundingVolume2D vc(c, {Vector2(-1.0f), Vector2(5.0f)}, &hierarchy);
+
+    CORRADE_VERIFY(hierarchy.nearest({-4.0f, 0.0f}) == &va);
+    CORRADE_VERIFY(hierarchy.nearest({4.0f, 3.0f}) == &vb);
+    CORRADE_VERIFY(hierarchy.nearest({2.0f, 5.0f}) == &vc);
+    CORRADE_VERIFY(hierarchy.nearest({11.0f, 1.0f}) == &vb);
+}
+
+void BoundingVolumeHierarchyTest::refit() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D hierarchy;
+
+    Object3D parent(&scene);
+    Object3D a(&parent);
+    BoundingVolume3D va(a, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+    Object3D b(&scene);
+    b.translate(Vector3::xAxis(5.0f));
+    BoundingVolume3D vb(b, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+
+    CORRADE_COMPARE(hierarchy.intersecting({Vector3(-0.5f), Vector3(0.5f)}),
+        std::vector<BoundingVolume3D*>{&va});
+
+    /* Moving the parent moves the volume */
+    parent.translate(Vector3::yAxis(10.0f));
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_COMPARE(hierarchy.intersecting({Vector3(-0.5f), Vector3(0.5f)}),
+        std::vector<BoundingVolume3D*>{});
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_COMPARE(hierarchy.intersecting({{-0.5f, 9.5f, -0.5f}, {0.5f, 10.5f, 0.5f}}),
+        std::vector<BoundingVolume3D*>{&va});
+    CORRADE_COMPARE(hierarchy.bounds(), Range3D({-1.0f, -1.0f, -1.0f}, {6.0f, 11.0f, 1.0f}));
+
+    /* Swap the positions, the tree is only refit */
+    parent.resetTransformation();
+    a.translate(Vector3::xAxis(5.0f));
+    b.resetTransformation();
+    CORRADE_COMPARE(hierarchy.intersecting({Vector3(-0.5f), Vector3(0.5f)}),
+        std::vector<BoundingVolume3D*>{&vb});
+    CORRADE_VERIFY(hierarchy.nearest(Vector3::xAxis(7.0f)) == &va);
+
+    /* Rebuilding the tree gives the same results */
+    hierarchy.rebuild();
+    CORRADE_COMPARE(hierarchy.intersecting({Vector3(-0.5f), Vector3(0.5f)}),
+        std::vector<BoundingVolume3D*>{&vb});
+    CORRADE_VERIFY(hierarchy.nearest(Vector3::xAxis(7.0f)) == &va);
+}
+
+void BoundingVolumeHierarchyTest::setBox() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D hierarchy;
+
+    Object3D a(&scene);
+    a.translate(Vector3(1.0f));
+    BoundingVolume3D va(a, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+    CORRADE_COMPARE(hierarchy.bounds(), Range3D(Vector3(0.0f), Vector3(2.0f)));
+
+    /* Changing the box of clean object updates the hierarchy */
+    CORRADE_VERIFY(!a.isDirty());
+    va.setBox({Vector3(-2.0f), Vector3(0.0f)});
+    CORRADE_COMPARE(va.box(), Range3D(Vector3(-2.0f), Vector3(0.0f)));
+    CORRADE_COMPARE(hierarchy.bounds(), Range3D(Vector3(-1.0f), Vector3(1.0f)));
+}
+
+void BoundingVolumeHierarchyTest::addRemove() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D first;
+    BoundingVolumeHierarchy3D second;
+
+    Object3D a(&scene);
+    BoundingVolume3D va(a, {Vector3(-1.0f), Vector3(1.0f)});
+    CORRADE_VERIFY(!va.hierarchy());
+
+    Object3D b(&scene);
+    b.translate(Vector3::xAxis(3.0f));
+    BoundingVolume3D vb(b, {Vector3(-1.0f), Vector3(1.0f)}, &first);
+
+    /* Adding to already clean object */
+    first.update();
+    first.add(va);
+    CORRADE_COMPARE(first.size(), 2);
+    CORRADE_COMPARE(first.bounds(), Range3D({-1.0f, -1.0f, -1.0f}, {4.0f, 1.0f, 1.0f}));
+
+    /* Moving to another hierarchy */
+    second.add(vb);
+    CORRADE_VERIFY(vb.hierarchy() == &second);
+    CORRADE_COMPARE(first.size(), 1);
+    CORRADE_COMPARE(second.size(), 1);
+    CORRADE_COMPARE(first.bounds(), Range3D(Vector3(-1.0f), Vector3(1.0f)));
+    CORRADE_COMPARE(second.bounds(), Range3D({2.0f, -1.0f, -1.0f}, {4.0f, 1.0f, 1.0f}));
+
+    /* Removing dirty volume */
+    a.translate(Vector3::yAxis(1.0f));
+    first.remove(va);
+    CORRADE_VERIFY(!va.hierarchy());
+    CORRADE_VERIFY(first.intersecting({Vector3(-10.0f), Vector3(10.0f)}).empty());
+
+    /* Removing volume from wrong hierarchy */
+    std::ostringstream out;
+    Error::setOutput(&out);
+    first.remove(vb);
+    CORRADE_COMPARE(out.str(), "SceneGraph::BoundingVolumeHierarchy::remove(): volume is not part of this hierarchy\n");
+}
+
+void BoundingVolumeHierarchyTest::destroy() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D hierarchy;
+
+    Object3D a(&scene);
+    BoundingVolume3D va(a, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+    {
+        Object3D* b = new Object3D(&scene);
+        b->translate(Vector3::xAxis(3.0f));
+        new BoundingVolume3D(*b, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+        hierarchy.update();
+
+        /* Deleting dirty object deletes the volume */
+        b->translate(Vector3::yAxis(1.0f));
+        delete b;
+    }
+
+    CORRADE_COMPARE(hierarchy.size(), 1);
+    CORRADE_COMPARE(hierarchy.intersecting({Vector3(-10.0f), Vector3(10.0f)}),
+        std::vector<BoundingVolume3D*>{&va});
+}
+
+void BoundingVolumeHierarchyTest::destroyHierarchy() {
+    Scene3D scene;
+    Object3D a(&scene);
+    BoundingVolume3D* va;
+    {
+        BoundingVolumeHierarchy3D hierarchy;
+        va = new BoundingVolume3D(a, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+    }
+
+    /* The volume is still usable without the hierarchy */
+    CORRADE_VERIFY(!va->hierarchy());
+    a.translate(Vector3::xAxis(1.0f));
+    BoundingVolumeHierarchy3D another;
+    another.add(*va);
+    CORRADE_COMPARE(another.bounds(), Range3D({0.0f, -1.0f, -1.0f}, {2.0f, 1.0f, 1.0f}));
+}
+
+void BoundingVolumeHierarchyTest::twoVolumesOnObject() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D hierarchy;
+
+    Object3D a(&scene);
+    BoundingVolume3D body(a, {Vector3(-1.0f), Vector3(1.0f)}, &hierarchy);
+    BoundingVolume3D head(a, {{-0.5f, 1.0f, -0.5f}, {0.5f, 2.0f, 0.5f}}, &hierarchy);
+
+    a.translate(Vector3::xAxis(10.0f));
+    CORRADE_COMPARE(hierarchy.intersecting({{9.0f, 1.5f, 0.0f}, {11.0f, 3.0f, 1.0f}}),
+        std::vector<BoundingVolume3D*>{&head});
+    CORRADE_COMPARE(sorted(hierarchy.intersecting({{9.0f, 0.5f, 0.0f}, {11.0f, 3.0f, 1.0f}})),
+        sorted(std::vector<BoundingVolume3D*>{&body, &head}));
+}
+
+void BoundingVolumeHierarchyTest::random() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D hierarchy;
+
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<Float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<Float> size(0.1f, 3.0f);
+
+    std::vector<Object3D*> objects;
+    std::vector<BoundingVolume3D*> volumes;
+    for(std::size_t i = 0; i != 500; ++i) {
+        objects.push_back(new Object3D(&scene));
+        objects.back()->translate({position(generator), position(generator), position(generator)});
+        volumes.push_back(new BoundingVolume3D(*objects.back(), {{}, {size(generator), size(generator), size(generator)}}, &hierarchy));
+    }
+
+    for(std::size_t round = 0; round != 3; ++round) {
+        /* Move some objects, to test the refit */
+        for(std::size_t i = round; i < objects.size(); i += 7)
+            objects[i]->translate({position(generator), 0.0f, position(generator)*0.1f});
+        hierarchy.update();
+
+        for(std::size_t query = 0; query != 20; ++query) {
+            const Vector3 center(position(generator), position(generator), position(generator));
+            const Range3D box(center - Vector3(10.0f), center + Vector3(10.0f));
+
+            std::vector<BoundingVolume3D*> expected;
+            for(BoundingVolume3D* volume: volumes) {
+                const Range3D absolute = volume->absoluteBox();
+                bool intersects = true;
+                for(std::size_t i = 0; i != 3; ++i)
+                    if(absolute.max()[i] < box.min()[i] || box.max()[i] < absolute.min()[i])
+                        intersects = false;
+                if(intersects) expected.push_back(volume);
+            }
+
+            CORRADE_COMPARE(sorted(hierarchy.intersecting(box)), sorted(expected));
+
+            BoundingVolume3D* nearest = hierarchy.nearest(center);
+            CORRADE_VERIFY(nearest);
+            for(BoundingVolume3D* volume: volumes) {
+                const Vector3 a = Math::max(Math::min(center, volume->absoluteBox().max()), volume->absoluteBox().min()) - center;
+                const Vector3 b = Math::max(Math::min(center, nearest->absoluteBox().max()), nearest->absoluteBox().min()) - center;
+                CORRADE_VERIFY(b.dot() <= a.dot());
+            }
+        }
+    }
+
+    for(Object3D* object: objects) delete object;
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BoundingVolumeHierarchyTest)
@@ -0,0 +1,145 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "SceneGraph/BuildHierarchy.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class BuildHierarchyBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        BuildHierarchyBenchmark();
+
+        void wideIncremental();
+        void wide();
+        void widePooled();
+        void deepIncremental();
+        void deep();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class PooledObject: public Object3D, public PoolAllocated {
+    public:
+        PooledObject(Object3D* parent = nullptr): Object3D(parent) {}
+};
+
+namespace {
+    constexpr std::size_t ObjectCount = 200000;
+
+    /* Object destruction is recursive, so the chain can't be too long */
+    constexpr std::size_t ChainLength = 10000;
+
+    /* Objects with given branching factor, object 0 is the root */
+    std::vector<std::unique_ptr<Trade::ObjectData3D>> objectData(std::size_t count, std::size_t branching) {
+        std::vector<std::unique_ptr<Trade::ObjectData3D>> objects(count);
+        for(std::size_t i = 0; i != count; ++i) {
+            std::vector<UnsignedInt> children;
+            for(std::size_t j = i*branching + 1; j < std::min(i*branching + branching + 1, count); ++j)
+                children.push_back(j);
+            objects[i].reset(new Trade::ObjectData3D(children, Matrix4::translation(Vector3::xAxis(Float(i%7)))));
+        }
+        return objects;
+    }
+
+    /* What an application would do without the builder */
+    void addObject(Object3D& parent, const std::vector<std::unique_ptr<Trade::ObjectData3D>>& objects, UnsignedInt id) {
+        Object3D* object = new Object3D(&parent);
+        object->setTransformation(objects[id]->transformation());
+        for(UnsignedInt child: objects[id]->children())
+            addObject(*object, objects, child);
+    }
+}
+
+BuildHierarchyBenchmark::BuildHierarchyBenchmark() {
+    addTests({&BuildHierarchyBenchmark::wideIncremental,
+              &BuildHierarchyBenchmark::wide,
+              &BuildHierarchyBenchmark::widePooled,
+              &BuildHierarchyBenchmark::deepIncremental,
+              &BuildHierarchyBenchmark::deep});
+}
+
+void BuildHierarchyBenchmark::wideIncremental() {
+    const auto data = objectData(ObjectCount, 8);
+
+    benchmark("importing 200k objects with branching factor 8 one by one", 5, [&]() {
+        Scene3D scene;
+        addObject(scene, data, 0);
+    });
+}
+
+void BuildHierarchyBenchmark::wide() {
+    const auto data = objectData(ObjectCount, 8);
+    const Trade::SceneData sceneData({}, {0});
+
+    benchmark("importing 200k objects with branching factor 8 using buildHierarchy()", 5, [&]() {
+        Scene3D scene;
+        CORRADE_COMPARE(buildHierarchy(scene, sceneData, data).size(), ObjectCount);
+    });
+}
+
+void BuildHierarchyBenchmark::widePooled() {
+    const auto data = objectData(ObjectCount, 8);
+    const Trade::SceneData sceneData({}, {0});
+    ObjectPool pool(ObjectCount);
+
+    benchmark("importing 200k objects with branching factor 8 using buildHierarchy() and ObjectPool", 5, [&]() {
+        Scene3D scene;
+        CORRADE_COMPARE(buildHierarchy<PooledObject>(scene, sceneData, data, &pool).size(), ObjectCount);
+    });
+
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+}
+
+void BuildHierarchyBenchmark::deepIncremental() {
+    /* addObject() would recurse too deep, thus iterating over the chain */
+    const auto data = objectData(ChainLength, 1);
+
+    benchmark("importing chain of 10k objects one by one", 5, [&]() {
+        Scene3D scene;
+        Object3D* parent = &scene;
+        for(const auto& o: data) {
+            Object3D* object = new Object3D(parent);
+            object->setTransformation(o->transformation());
+            parent = object;
+        }
+    });
+}
+
+void BuildHierarchyBenchmark::deep() {
+    const auto data = objectData(ChainLength, 1);
+    const Trade::SceneData sceneData({}, {0});
+
+    benchmark("importing chain of 10k objects using buildHierarchy()", 5, [&]() {
+        Scene3D scene;
+        CORRADE_COMPARE(buildHierarchy(scene, sceneData, data).size(), ChainLength);
+    });
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BuildHierarchyBenchmark)
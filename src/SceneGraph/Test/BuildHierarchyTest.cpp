@@ -0,0 +1,261 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/AbstractFeature.h"
+#include "SceneGraph/BuildHierarchy.h"
+#include "SceneGraph/DualQuaternionTransformation.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class BuildHierarchyTest: public TestSuite::Tester {
+    public:
+        BuildHierarchyTest();
+
+        void build();
+        void buildSubtree();
+        void buildPooled();
+        void buildDualQuaternion();
+        void dirty();
+        void indexOutOfRange();
+        void notLoaded();
+        void referencedTwice();
+        void cycle();
+        void poolNotPoolAllocated();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+BuildHierarchyTest::BuildHierarchyTest() {
+    addTests({&BuildHierarchyTest::build,
+              &BuildHierarchyTest::buildSubtree,
+              &BuildHierarchyTest::buildPooled,
+              &BuildHierarchyTest::buildDualQuaternion,
+              &BuildHierarchyTest::dirty,
+              &BuildHierarchyTest::indexOutOfRange,
+              &BuildHierarchyTest::notLoaded,
+              &BuildHierarchyTest::referencedTwice,
+              &BuildHierarchyTest::cycle,
+              &BuildHierarchyTest::poolNotPoolAllocated});
+}
+
+namespace {
+    /* Object 3 is not part of the scene, children are intentionally listed
+       in non-sequential order */
+    std::vector<std::unique_ptr<Trade::ObjectData3D>> objectData() {
+        std::vector<std::unique_ptr<Trade::ObjectData3D>> objects;
+        objects.emplace_back(new Trade::ObjectData3D({4, 1}, Matrix4::translation(Vector3::xAxis(1.0f))));
+        objects.emplace_back(new Trade::ObjectData3D({}, Matrix4::scaling(Vector3(2.0f)), Trade::ObjectInstanceType3D::Mesh, 7));
+        objects.emplace_back(new Trade::ObjectData3D({}, Matrix4::translation(Vector3::yAxis(3.0f))));
+        objects.emplace_back(new Trade::ObjectData3D({}, Matrix4()));
+        objects.emplace_back(new Trade::ObjectData3D({5}, Matrix4::rotationZ(Deg(90.0f))));
+        objects.emplace_back(new Trade::ObjectData3D({}, Matrix4::translation(Vector3::zAxis(-1.0f))));
+        return objects;
+    }
+
+    class PooledObject: public Object3D, public PoolAllocated {
+        public:
+            PooledObject(Object3D* parent = nullptr): Object3D(parent) {}
+    };
+}
+
+void BuildHierarchyTest::build() {
+    const auto data = objectData();
+    const Trade::SceneData sceneData({}, {2, 0});
+
+    Scene3D scene;
+    const std::vector<Object3D*> objects = buildHierarchy(scene, sceneData, data);
+    CORRADE_COMPARE(objects.size(), 6);
+    CORRADE_VERIFY(!objects[3]);
+
+    /* Hierarchy and order of children */
+    CORRADE_VERIFY(scene.firstChild() == objects[2]);
+    CORRADE_VERIFY(scene.lastChild() == objects[0]);
+    CORRADE_VERIFY(objects[0]->firstChild() == objects[4]);
+    CORRADE_VERIFY(objects[0]->lastChild() == objects[1]);
+    CORRADE_VERIFY(objects[4]->firstChild() == objects[5]);
+    CORRADE_VERIFY(objects[4]->firstChild() == objects[4]->lastChild());
+    CORRADE_VERIFY(!objects[1]->hasChildren());
+    CORRADE_VERIFY(!objects[2]->hasChildren());
+    CORRADE_VERIFY(objects[5]->scene() == &scene);
+
+    /* Transformations */
+    CORRADE_COMPARE(objects[1]->transformation(), Matrix4::scaling(Vector3(2.0f)));
+    CORRADE_COMPARE(objects[5]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::rotationZ(Deg(90.0f))*Matrix4::translation(Vector3::zAxis(-1.0f)));
+}
+
+void BuildHierarchyTest::buildSubtree() {
+    const auto data = objectData();
+    const Trade::SceneData sceneData({}, {0});
+
+    /* Added after existing children */
+    Scene3D scene;
+    Object3D root(&scene);
+    root.translate(Vector3::yAxis(5.0f));
+    Object3D existing(&root);
+    const std::vector<Object3D*> objects = buildHierarchy(root, sceneData, data);
+    CORRADE_VERIFY(!objects[2]);
+    CORRADE_VERIFY(root.firstChild() == &existing);
+    CORRADE_VERIFY(root.lastChild() == objects[0]);
+    CORRADE_COMPARE(objects[1]->absoluteTransformation(), Matrix4::translation({1.0f, 5.0f, 0.0f})*Matrix4::scaling(Vector3(2.0f)));
+}
+
+void BuildHierarchyTest::buildPooled() {
+    const auto data = objectData();
+    const Trade::SceneData sceneData({}, {2, 0});
+
+    ObjectPool pool(data.size());
+    {
+        Scene3D scene;
+        const std::vector<PooledObject*> objects = buildHierarchy<PooledObject>(scene, sceneData, data, &pool);
+        CORRADE_COMPARE(pool.allocatedCount(), 5);
+        CORRADE_COMPARE(pool.capacity(), 6);
+        CORRADE_VERIFY(objects[0]->lastChild() == objects[1]);
+
+        /* Without pool allocated on heap */
+        Scene3D another;
+        buildHierarchy<PooledObject>(another, sceneData, data);
+        CORRADE_COMPARE(pool.allocatedCount(), 5);
+    }
+
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+}
+
+void BuildHierarchyTest::buildDualQuaternion() {
+    std::vector<std::unique_ptr<Trade::ObjectData3D>> data;
+    data.emplace_back(new Trade::ObjectData3D({1}, Matrix4::translation(Vector3::xAxis(1.0f))));
+    data.emplace_back(new Trade::ObjectData3D({}, Matrix4::rotationZ(Deg(90.0f))));
+    const Trade::SceneData sceneData({}, {0});
+
+    Scene<DualQuaternionTransformation> scene;
+    const std::vector<Object<DualQuaternionTransformation>*> objects = buildHierarchy(scene, sceneData, data);
+    CORRADE_COMPARE(objects[1]->absoluteTransformationMatrix(), Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::rotationZ(Deg(90.0f)));
+}
+
+void BuildHierarchyTest::dirty() {
+    class CachingFeature: public AbstractFeature3D {
+        public:
+            CachingFeature(AbstractObject3D& object): AbstractFeature3D(object) {
+                setCachedTransformations(CachedTransformation::Absolute);
+            }
+
+            Matrix4 absoluteTransformation;
+
+        protected:
+            void clean(const Matrix4& absoluteTransformation) override {
+                this->absoluteTransformation = absoluteTransformation;
+            }
+    };
+
+    const auto data = objectData();
+    const Trade::SceneData sceneData({}, {2, 0});
+
+    Scene3D scene;
+    const std::vector<Object3D*> objects = buildHierarchy(scene, sceneData, data);
+    for(Object3D* o: objects) if(o) CORRADE_VERIFY(o->isDirty());
+
+    /* Cleaning the scene cleans all new objects */
+    CachingFeature feature(*objects[5]);
+    scene.setAllClean();
+    for(Object3D* o: objects) if(o) CORRADE_VERIFY(!o->isDirty());
+    CORRADE_COMPARE(feature.absoluteTransformation, Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::rotationZ(Deg(90.0f))*Matrix4::translation(Vector3::zAxis(-1.0f)));
+}
+
+void BuildHierarchyTest::indexOutOfRange() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    auto data = objectData();
+    data[4]->children().push_back(6);
+    const Trade::SceneData sceneData({}, {0});
+
+    Scene3D scene;
+    CORRADE_VERIFY(buildHierarchy(scene, sceneData, data).empty());
+    CORRADE_VERIFY(!scene.hasChildren());
+    CORRADE_COMPARE(out.str(), "SceneGraph::buildHierarchy(): object index 6 out of range for 6 objects\n");
+}
+
+void BuildHierarchyTest::notLoaded() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    auto data = objectData();
+    data[5].reset();
+    const Trade::SceneData sceneData({}, {0});
+
+    Scene3D scene;
+    CORRADE_VERIFY(buildHierarchy(scene, sceneData, data).empty());
+    CORRADE_VERIFY(!scene.hasChildren());
+    CORRADE_COMPARE(out.str(), "SceneGraph::buildHierarchy(): object 5 is not loaded\n");
+}
+
+void BuildHierarchyTest::referencedTwice() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    const auto data = objectData();
+    const Trade::SceneData sceneData({}, {1, 0});
+
+    Scene3D scene;
+    CORRADE_VERIFY(buildHierarchy(scene, sceneData, data).empty());
+    CORRADE_VERIFY(!scene.hasChildren());
+    CORRADE_COMPARE(out.str(), "SceneGraph::buildHierarchy(): object 1 is referenced more than once\n");
+}
+
+void BuildHierarchyTest::cycle() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    auto data = objectData();
+    data[5]->children().push_back(4);
+    const Trade::SceneData sceneData({}, {0});
+
+    Scene3D scene;
+    CORRADE_VERIFY(buildHierarchy(scene, sceneData, data).empty());
+    CORRADE_VERIFY(!scene.hasChildren());
+    CORRADE_COMPARE(out.str(), "SceneGraph::buildHierarchy(): object 4 is referenced more than once\n");
+}
+
+void BuildHierarchyTest::poolNotPoolAllocated() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    const auto data = objectData();
+    const Trade::SceneData sceneData({}, {0});
+
+    ObjectPool pool;
+    Scene3D scene;
+    CORRADE_VERIFY(buildHierarchy(scene, sceneData, data, &pool).empty());
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+    CORRADE_COMPARE(out.str(), "SceneGraph::buildHierarchy(): the object type must be derived from PoolAllocated to use a pool\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BuildHierarchyTest)
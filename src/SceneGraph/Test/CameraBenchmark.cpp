@@ -0,0 +1,131 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "SceneGraph/Camera3D.h"
+#include "SceneGraph/Drawable.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class CameraBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        CameraBenchmark();
+
+        void drawCubeMapCached();
+        void drawCubeMapUncached();
+
+    private:
+        void drawCubeMap(const std::string& name, bool cached);
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+
+class Drawable: public SceneGraph::Drawable3D {
+    public:
+        explicit Drawable(AbstractObject3D& object, DrawableGroup3D* group, Float& sum, bool cached): SceneGraph::Drawable3D(object, group), sum(sum) {
+            if(!cached) setCachedTransformations({});
+        }
+
+    protected:
+        void draw(const Matrix4& transformationMatrix, AbstractCamera3D&) override {
+            sum += transformationMatrix.translation().z();
+        }
+
+    private:
+        Float& sum;
+};
+
+}
+
+CameraBenchmark::CameraBenchmark() {
+    addTests({&CameraBenchmark::drawCubeMapCached,
+              &CameraBenchmark::drawCubeMapUncached});
+}
+
+void CameraBenchmark::drawCubeMapCached() { drawCubeMap("cached", true); }
+void CameraBenchmark::drawCubeMapUncached() { drawCubeMap("uncached", false); }
+
+void CameraBenchmark::drawCubeMap(const std::string& name, const bool cached) {
+    Scene3D scene;
+    DrawableGroup3D group;
+    Float sum = 0.0f;
+
+    /* 100 groups with 1000 drawables each, half of the groups moves every
+       frame */
+    std::vector<Object3D*> moving;
+    for(std::size_t i = 0; i != 100; ++i) {
+        Object3D* parent = new Object3D(&scene);
+        parent->translate(Vector3::xAxis(Float(i)));
+        if(i % 2) moving.push_back(parent);
+        for(std::size_t j = 0; j != 1000; ++j) {
+            Object3D* o = new Object3D(parent);
+            o->translate(Vector3::yAxis(Float(j)));
+            new Drawable(*o, &group, sum, cached);
+        }
+    }
+
+    /* Six cameras for cube map faces */
+    Object3D* cameraRoot = new Object3D(&scene);
+    std::vector<AbstractCamera3D*> cameras;
+    for(const Matrix4& rotation: {Matrix4::rotationY(Deg(90.0f)), Matrix4::rotationY(Deg(-90.0f)),
+                                  Matrix4::rotationX(Deg(90.0f)), Matrix4::rotationX(Deg(-90.0f)),
+                                  Matrix4(), Matrix4::rotationY(Deg(180.0f))}) {
+        Object3D* o = new Object3D(cameraRoot);
+        o->setTransformation(rotation);
+        Camera3D* camera = new Camera3D(*o);
+        camera->setPerspective(Deg(90.0f), 1.0f, 0.1f, 1000.0f)
+            .setFrustumCulling(false);
+        cameras.push_back(camera);
+    }
+
+    Float separateSum = 0.0f;
+    benchmark("six cameras drawn separately, " + name, 5, [&]() {
+        for(Object3D* o: moving) o->translate(Vector3::zAxis(0.01f));
+        sum = 0.0f;
+        for(AbstractCamera3D* camera: cameras) camera->draw(group);
+        separateSum = sum;
+    });
+
+    Float multipleSum = 0.0f;
+    benchmark("six cameras drawn at once, " + name, 5, [&]() {
+        for(Object3D* o: moving) o->translate(Vector3::zAxis(-0.01f));
+        sum = 0.0f;
+        AbstractCamera3D::draw(cameras, group);
+        multipleSum = sum;
+    });
+
+    CORRADE_VERIFY(separateSum != 0.0f);
+    CORRADE_VERIFY(multipleSum != 0.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraBenchmark)
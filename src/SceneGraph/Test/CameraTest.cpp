@@ -22,12 +22,17 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <tuple>
 #include <TestSuite/Tester.h>
 
 #include "SceneGraph/AbstractCamera.hpp" /* only for aspectRatioFix(), so it doesn't have to be exported */
+#include "SceneGraph/BoundingVolume.h"
+#include "SceneGraph/BoundingVolumeHierarchy.h"
 #include "SceneGraph/Camera2D.h"
 #include "SceneGraph/Camera3D.h"
 #include "SceneGraph/Drawable.h"
+#include "SceneGraph/InstancedDrawable.h"
 #include "SceneGraph/MatrixTransformation2D.h"
 #include "SceneGraph/MatrixTransformation3D.h"
 #include "SceneGraph/Scene.h"
@@ -46,10 +51,24 @@ class CameraTest: public TestSuite::Tester {
         void projectionSizePerspective();
         void projectionSizeViewport();
         void draw();
+        void drawThreaded();
+        void drawCached();
+        void drawCulled2D();
+        void drawCulled3D();
+        void drawCulledHierarchy();
+        void drawSorted();
+        void drawSortedLarge();
+        void drawInstanced();
+        void drawInstancedEmpty();
+        void drawInstancedInvalid();
+        void drawSetAllClean();
+        void drawMultiple();
+        void drawMultipleDifferentScene();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
 CameraTest::CameraTest() {
@@ -60,7 +79,20 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeOrthographic,
               &CameraTest::projectionSizePerspective,
               &CameraTest::projectionSizeViewport,
-              &CameraTest::draw});
+              &CameraTest::draw,
+              &CameraTest::drawThreaded,
+              &CameraTest::drawCached,
+              &CameraTest::drawCulled2D,
+              &CameraTest::drawCulled3D,
+              &CameraTest::drawCulledHierarchy,
+              &CameraTest::drawSorted,
+              &CameraTest::drawSortedLarge,
+              &CameraTest::drawInstanced,
+              &CameraTest::drawInstancedEmpty,
+              &CameraTest::drawInstancedInvalid,
+              &CameraTest::drawSetAllClean,
+              &CameraTest::drawMultiple,
+              &CameraTest::drawMultipleDifferentScene});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -195,6 +227,667 @@ void CameraTest::draw() {
     CORRADE_COMPARE(thirdTransformation, Matrix4());
 }
 
+void CameraTest::drawThreaded() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<Matrix4>& results, std::size_t index): SceneGraph::Drawable3D(object, group), results(results), index(index) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, AbstractCamera3D&) override {
+                results[index] = transformationMatrix;
+            }
+
+        private:
+            std::vector<Matrix4>& results;
+            std::size_t index;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    /* More drawables than fit into one chunk of work */
+    std::vector<Matrix4> results(3000);
+    for(std::size_t i = 0; i != 30; ++i) {
+        Object3D* parent = new Object3D(&scene);
+        parent->translate(Vector3::xAxis(Float(i)));
+        for(std::size_t j = 0; j != 100; ++j) {
+            Object3D* o = new Object3D(parent);
+            o->translate(Vector3::yAxis(Float(j)));
+            new Drawable(*o, &group, results, i*100 + j);
+        }
+    }
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::zAxis(5.0f));
+    Camera3D camera(cameraObject);
+    CORRADE_COMPARE(camera.transformationThreadCount(), 1);
+
+    camera.draw(group);
+    const std::vector<Matrix4> expected = results;
+    CORRADE_COMPARE(expected[2345], Matrix4::translation({23.0f, 45.0f, -5.0f}));
+
+    results.assign(results.size(), Matrix4(Matrix4::Zero));
+    camera.setTransformationThreadCount(4);
+    CORRADE_COMPARE(camera.transformationThreadCount(), 4);
+    camera.draw(group);
+    CORRADE_COMPARE(results, expected);
+}
+
+void CameraTest::drawCached() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, Matrix4& result, bool cached = true): SceneGraph::Drawable3D(object, group), result(result) {
+                if(!cached) setCachedTransformations({});
+            }
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, AbstractCamera3D&) override {
+                result = transformationMatrix;
+            }
+
+        private:
+            Matrix4& result;
+    };
+
+    /* Counts how many times the object was cleaned */
+    class CleanCounter: public AbstractFeature3D {
+        public:
+            CleanCounter(AbstractObject3D& object): AbstractFeature3D(object), count(0) {
+                setCachedTransformations(CachedTransformation::Absolute);
+            }
+
+            UnsignedInt count;
+
+        protected:
+            void clean(const Matrix4&) override { ++count; }
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D first(&scene);
+    Matrix4 firstTransformation;
+    first.translate(Vector3::xAxis(1.0f));
+    new Drawable(first, &group, firstTransformation);
+    CleanCounter firstCounter(first);
+
+    Object3D second(&first);
+    Matrix4 secondTransformation;
+    second.translate(Vector3::yAxis(2.0f));
+    new Drawable(second, &group, secondTransformation);
+    CleanCounter secondCounter(second);
+
+    Object3D third(&scene);
+    Matrix4 thirdTransformation;
+    third.translate(Vector3::xAxis(-3.0f));
+    new Drawable(third, &group, thirdTransformation);
+    CleanCounter thirdCounter(third);
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::zAxis(5.0f));
+    Camera3D camera(cameraObject);
+
+    /* First draw cleans everything */
+    camera.draw(group);
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({1.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation({1.0f, 2.0f, -5.0f}));
+    CORRADE_COMPARE(thirdTransformation, Matrix4::translation({-3.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(firstCounter.count, 1);
+    CORRADE_COMPARE(secondCounter.count, 1);
+    CORRADE_COMPARE(thirdCounter.count, 1);
+
+    /* Nothing changed, nothing is cleaned again */
+    firstTransformation = secondTransformation = thirdTransformation = Matrix4(Matrix4::Zero);
+    camera.draw(group);
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({1.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation({1.0f, 2.0f, -5.0f}));
+    CORRADE_COMPARE(thirdTransformation, Matrix4::translation({-3.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(firstCounter.count, 1);
+    CORRADE_COMPARE(secondCounter.count, 1);
+    CORRADE_COMPARE(thirdCounter.count, 1);
+
+    /* Moving the parent cleans only the changed subtree */
+    first.translate(Vector3::xAxis(1.0f));
+    camera.draw(group);
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({2.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation({2.0f, 2.0f, -5.0f}));
+    CORRADE_COMPARE(thirdTransformation, Matrix4::translation({-3.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(firstCounter.count, 2);
+    CORRADE_COMPARE(secondCounter.count, 2);
+    CORRADE_COMPARE(thirdCounter.count, 1);
+
+    /* Moving the camera doesn't need any recomputation */
+    cameraObject.translate(Vector3::zAxis(1.0f));
+    camera.draw(group);
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({2.0f, 0.0f, -6.0f}));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation({2.0f, 2.0f, -6.0f}));
+    CORRADE_COMPARE(thirdTransformation, Matrix4::translation({-3.0f, 0.0f, -6.0f}));
+    CORRADE_COMPARE(firstCounter.count, 2);
+    CORRADE_COMPARE(secondCounter.count, 2);
+    CORRADE_COMPARE(thirdCounter.count, 1);
+
+    /* Drawable added to already clean object */
+    Matrix4 addedTransformation;
+    new Drawable(third, &group, addedTransformation);
+    camera.draw(group);
+    CORRADE_COMPARE(addedTransformation, Matrix4::translation({-3.0f, 0.0f, -6.0f}));
+
+    /* Drawable with disabled caching */
+    Matrix4 uncachedTransformation;
+    new Drawable(second, &group, uncachedTransformation, false);
+    camera.draw(group);
+    CORRADE_COMPARE(uncachedTransformation, Matrix4::translation({2.0f, 2.0f, -6.0f}));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation({2.0f, 2.0f, -6.0f}));
+}
+
+namespace {
+    template<UnsignedInt dimensions> class CountingDrawable: public SceneGraph::Drawable<dimensions, Float> {
+        public:
+            CountingDrawable(AbstractObject<dimensions, Float>& object, DrawableGroup<dimensions, Float>* group): SceneGraph::Drawable<dimensions, Float>(object, group), count(0) {}
+
+            UnsignedInt count;
+
+        protected:
+            void draw(const typename DimensionTraits<dimensions, Float>::MatrixType&, AbstractCamera<dimensions, Float>&) override {
+                ++count;
+            }
+    };
+}
+
+void CameraTest::drawCulled2D() {
+    DrawableGroup2D group;
+    Scene2D scene;
+
+    /* Inside */
+    Object2D a(&scene);
+    a.translate({0.5f, 0.5f});
+    CountingDrawable<2>* inside = new CountingDrawable<2>(a, &group);
+    inside->setBoundingBox({{-0.1f, -0.1f}, {0.1f, 0.1f}});
+
+    /* Partially inside */
+    Object2D b(&scene);
+    b.translate({1.9f, 0.0f});
+    CountingDrawable<2>* partial = new CountingDrawable<2>(b, &group);
+    partial->setBoundingBox({{-0.5f, -0.5f}, {0.5f, 0.5f}});
+
+    /* Outside */
+    Object2D c(&scene);
+    c.translate({0.0f, -3.0f});
+    CountingDrawable<2>* outside = new CountingDrawable<2>(c, &group);
+    outside->setBoundingBox({{-0.5f, -0.5f}, {0.5f, 0.5f}});
+
+    Object2D cameraObject(&scene);
+    Camera2D camera(cameraObject);
+    camera.setProjection({4.0f, 4.0f});
+    camera.draw(group);
+
+    CORRADE_COMPARE(inside->count, 1);
+    CORRADE_COMPARE(partial->count, 1);
+    CORRADE_COMPARE(outside->count, 0);
+    CORRADE_COMPARE(camera.testedDrawableCount(), 3);
+    CORRADE_COMPARE(camera.culledDrawableCount(), 1);
+}
+
+void CameraTest::drawCulled3D() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    /* In front of the camera */
+    Object3D a(&scene);
+    a.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable<3>* front = new CountingDrawable<3>(a, &group);
+    front->setBoundingBox({Vector3(-1.0f), Vector3(1.0f)});
+
+    /* Behind the camera */
+    Object3D b(&scene);
+    b.translate(Vector3::zAxis(5.0f));
+    CountingDrawable<3>* behind = new CountingDrawable<3>(b, &group);
+    behind->setBoundingBox({Vector3(-1.0f), Vector3(1.0f)});
+
+    /* Far to the side */
+    Object3D c(&scene);
+    c.translate({50.0f, 0.0f, -5.0f});
+    CountingDrawable<3>* side = new CountingDrawable<3>(c, &group);
+    side->setBoundingBox({Vector3(-1.0f), Vector3(1.0f)});
+
+    /* Crossing the near plane, partially visible */
+    Object3D d(&scene);
+    CountingDrawable<3>* crossing = new CountingDrawable<3>(d, &group);
+    crossing->setBoundingBox({Vector3(-1.0f), Vector3(1.0f)});
+
+    /* Beyond far plane, but no bounding box */
+    Object3D e(&scene);
+    e.translate(Vector3::zAxis(-500.0f));
+    CountingDrawable<3>* unbounded = new CountingDrawable<3>(e, &group);
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+    CORRADE_VERIFY(camera.isFrustumCullingEnabled());
+    camera.draw(group);
+
+    CORRADE_COMPARE(front->count, 1);
+    CORRADE_COMPARE(behind->count, 0);
+    CORRADE_COMPARE(side->count, 0);
+    CORRADE_COMPARE(crossing->count, 1);
+    CORRADE_COMPARE(unbounded->count, 1);
+    CORRADE_COMPARE(camera.testedDrawableCount(), 4);
+    CORRADE_COMPARE(camera.culledDrawableCount(), 2);
+
+    /* Moving the camera changes the result */
+    cameraObject.translate(Vector3::xAxis(50.0f));
+    camera.draw(group);
+    CORRADE_COMPARE(front->count, 1);
+    CORRADE_COMPARE(side->count, 1);
+    CORRADE_COMPARE(camera.culledDrawableCount(), 3);
+
+    /* Everything is drawn with culling disabled */
+    camera.setFrustumCulling(false);
+    camera.draw(group);
+    CORRADE_COMPARE(front->count, 2);
+    CORRADE_COMPARE(behind->count, 1);
+    CORRADE_COMPARE(side->count, 2);
+    CORRADE_COMPARE(camera.testedDrawableCount(), 0);
+    CORRADE_COMPARE(camera.culledDrawableCount(), 0);
+}
+
+void CameraTest::drawCulledHierarchy() {
+    DrawableGroup3D group, another;
+    BoundingVolumeHierarchy3D hierarchy;
+    Scene3D scene;
+    const Range3D box{Vector3(-1.0f), Vector3(1.0f)};
+
+    /* In front of the camera */
+    Object3D a(&scene);
+    a.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable<3>* front = new CountingDrawable<3>(a, &group);
+    new BoundingVolume3D(a, box, &hierarchy);
+
+    /* Behind the camera */
+    Object3D b(&scene);
+    b.translate(Vector3::zAxis(5.0f));
+    CountingDrawable<3>* behind = new CountingDrawable<3>(b, &group);
+    new BoundingVolume3D(b, box, &hierarchy);
+
+    /* In front of the camera, but without volume */
+    Object3D c(&scene);
+    c.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable<3>* noVolume = new CountingDrawable<3>(c, &group);
+
+    /* In front of the camera, with two volumes and drawable in another
+       group */
+    Object3D d(&scene);
+    d.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable<3>* twoVolumes = new CountingDrawable<3>(d, &group);
+    CountingDrawable<3>* otherGroup = new CountingDrawable<3>(d, &another);
+    new BoundingVolume3D(d, box, &hierarchy);
+    new BoundingVolume3D(d, box, &hierarchy);
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+    camera.draw(group, hierarchy);
+
+    CORRADE_COMPARE(front->count, 1);
+    CORRADE_COMPARE(behind->count, 0);
+    CORRADE_COMPARE(noVolume->count, 0);
+    CORRADE_COMPARE(twoVolumes->count, 1);
+    CORRADE_COMPARE(otherGroup->count, 0);
+
+    /* Turning the camera around and moving the objects changes the result */
+    cameraObject.rotateY(Deg(180.0f));
+    a.translate(Vector3::zAxis(20.0f));
+    camera.draw(group, hierarchy);
+    CORRADE_COMPARE(front->count, 2);
+    CORRADE_COMPARE(behind->count, 1);
+    CORRADE_COMPARE(twoVolumes->count, 1);
+}
+
+namespace {
+    class OrderDrawable: public SceneGraph::Drawable3D {
+        public:
+            OrderDrawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<Int>& order, Int id): SceneGraph::Drawable3D(object, group), order(order), id(id) {}
+
+        protected:
+            void draw(const Matrix4&, AbstractCamera3D&) override {
+                order.push_back(id);
+            }
+
+        private:
+            std::vector<Int>& order;
+            Int id;
+    };
+}
+
+void CameraTest::drawSorted() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> order;
+
+    /* ID, sort key, depth */
+    const std::tuple<Int, UnsignedInt, Float> data[] = {
+        std::make_tuple(0, 3, 1.0f),
+        std::make_tuple(1, 1, 5.0f),
+        std::make_tuple(2, 3, 0.5f),
+        std::make_tuple(3, 1, 2.0f),
+        std::make_tuple(4, 0, 10.0f),
+        std::make_tuple(5, 1, 2.0f)
+    };
+    for(const auto& d: data) {
+        Object3D* o = new Object3D(&scene);
+        o->translate(Vector3::zAxis(-std::get<2>(d)));
+        (new OrderDrawable(*o, &group, order, std::get<0>(d)))->setSortKey(std::get<1>(d));
+    }
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    CORRADE_COMPARE(camera.drawOrder(), DrawOrder::Unsorted);
+    camera.draw(group);
+    CORRADE_COMPARE(order, (std::vector<Int>{0, 1, 2, 3, 4, 5}));
+
+    /* Sorted by key, then front to back, stable for equal keys */
+    order.clear();
+    camera.setDrawOrder(DrawOrder::SortKeyFrontToBack)
+        .draw(group);
+    CORRADE_COMPARE(order, (std::vector<Int>{4, 3, 5, 1, 2, 0}));
+
+    /* Back to front, then by key */
+    order.clear();
+    camera.setDrawOrder(DrawOrder::BackToFront)
+        .draw(group);
+    CORRADE_COMPARE(order, (std::vector<Int>{4, 1, 3, 5, 0, 2}));
+}
+
+void CameraTest::drawSortedLarge() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> order;
+
+    /* Keys spanning all bytes, objects also behind the camera */
+    std::vector<std::pair<UnsignedInt, Float>> keys;
+    for(Int i = 0; i != 1000; ++i) {
+        const UnsignedInt key = (UnsignedInt(i)*2654435761u) >> (i % 4)*8;
+        const Float depth = Float((i*37) % 101) - 20.0f;
+        keys.emplace_back(key, depth);
+
+        Object3D* o = new Object3D(&scene);
+        o->translate(Vector3::zAxis(-depth));
+        (new OrderDrawable(*o, &group, order, i))->setSortKey(key);
+    }
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setDrawOrder(DrawOrder::SortKeyFrontToBack)
+        .draw(group);
+
+    CORRADE_COMPARE(order.size(), 1000);
+    bool sorted = true;
+    for(std::size_t i = 1; i < order.size(); ++i) {
+        const auto& a = keys[order[i - 1]];
+        const auto& b = keys[order[i]];
+        if(a.first > b.first || (a.first == b.first && a.second > b.second))
+            sorted = false;
+    }
+    CORRADE_VERIFY(sorted);
+}
+
+namespace {
+    class InstanceGroup: public InstancedDrawableGroup3D {
+        public:
+            InstanceGroup(): drawCount(0) {}
+
+            std::vector<Matrix4> instances;
+            UnsignedInt drawCount;
+
+        protected:
+            void draw(const std::vector<Matrix4>& transformationMatrices, AbstractCamera3D&) override {
+                instances = transformationMatrices;
+                ++drawCount;
+            }
+    };
+}
+
+void CameraTest::drawInstanced() {
+    InstanceGroup group;
+    Scene3D scene;
+
+    /* Depth, sort key */
+    const std::pair<Float, UnsignedInt> data[] = {
+        {1.0f, 2},
+        {5.0f, 1},
+        {-5.0f, 0}, /* behind the camera */
+        {3.0f, 1}
+    };
+    std::vector<Object3D*> objects;
+    for(const auto& d: data) {
+        Object3D* o = new Object3D(&scene);
+        o->translate(Vector3::zAxis(-d.first));
+        objects.push_back(o);
+        (new InstancedDrawable3D(*o, &group))
+            ->setBoundingBox({Vector3(-0.5f), Vector3(0.5f)})
+            .setSortKey(d.second);
+    }
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::xAxis(1.0f));
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+
+    /* All visible transformations in one draw, relative to camera */
+    camera.draw(group);
+    CORRADE_COMPARE(group.drawCount, 1);
+    CORRADE_COMPARE(camera.culledDrawableCount(), 1);
+    CORRADE_COMPARE(group.instances, (std::vector<Matrix4>{
+        Matrix4::translation({-1.0f, 0.0f, -1.0f}),
+        Matrix4::translation({-1.0f, 0.0f, -5.0f}),
+        Matrix4::translation({-1.0f, 0.0f, -3.0f})}));
+
+    /* Instances are in draw order */
+    camera.setDrawOrder(DrawOrder::SortKeyFrontToBack)
+        .draw(group);
+    CORRADE_COMPARE(group.drawCount, 2);
+    CORRADE_COMPARE(group.instances, (std::vector<Matrix4>{
+        Matrix4::translation({-1.0f, 0.0f, -3.0f}),
+        Matrix4::translation({-1.0f, 0.0f, -5.0f}),
+        Matrix4::translation({-1.0f, 0.0f, -1.0f})}));
+
+    /* Moving the object updates only its instance */
+    objects[0]->translate(Vector3::yAxis(0.5f));
+    camera.setDrawOrder(DrawOrder::Unsorted)
+        .draw(group);
+    CORRADE_COMPARE(group.instances[0], Matrix4::translation({-1.0f, 0.5f, -1.0f}));
+}
+
+void CameraTest::drawInstancedEmpty() {
+    InstanceGroup group;
+    Scene3D scene;
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+
+    /* Nothing is drawn if the group is empty */
+    camera.draw(group);
+    CORRADE_COMPARE(group.drawCount, 0);
+
+    /* ... or everything is culled */
+    Object3D o(&scene);
+    o.translate(Vector3::zAxis(10.0f));
+    (new InstancedDrawable3D(o, &group))->setBoundingBox({Vector3(-0.5f), Vector3(0.5f)});
+    camera.draw(group);
+    CORRADE_COMPARE(camera.culledDrawableCount(), 1);
+    CORRADE_COMPARE(group.drawCount, 0);
+}
+
+void CameraTest::drawInstancedInvalid() {
+    InstanceGroup group;
+    DrawableGroup3D plainGroup;
+    Scene3D scene;
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+
+    Object3D o(&scene);
+    o.translate(Vector3::zAxis(-1.0f));
+    InstancedDrawable3D instanced(o, &group);
+
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    /* Plain drawable added to instanced group through the base */
+    CountingDrawable<3> plain(o, nullptr);
+    instanced.drawables()->add(plain);
+    CORRADE_COMPARE(out.str(), "SceneGraph::InstancedDrawableGroup::add(): only instanced drawables can be added\n");
+    instanced.drawables()->remove(plain);
+
+    /* Instanced drawable drawn separately */
+    out.str({});
+    plainGroup.add(instanced);
+    camera.draw(plainGroup);
+    CORRADE_COMPARE(out.str(), "SceneGraph::InstancedDrawable::draw(): instanced drawable can be drawn only as part of InstancedDrawableGroup\n");
+}
+
+void CameraTest::drawSetAllClean() {
+    /* Caches absolute transformation, but isn't drawn */
+    class CachingFeature: public AbstractFeature3D {
+        public:
+            CachingFeature(AbstractObject3D& object): AbstractFeature3D(object) {
+                setCachedTransformations(CachedTransformation::Absolute);
+            }
+
+            Matrix4 absoluteTransformation;
+
+        protected:
+            void clean(const Matrix4& absoluteTransformation) override {
+                this->absoluteTransformation = absoluteTransformation;
+            }
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D parent(&scene);
+    Object3D drawn(&parent);
+    CountingDrawable<3> drawable(drawn, &group);
+    Object3D notDrawn(&parent);
+    CachingFeature feature(notDrawn);
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    scene.setAllClean();
+
+    /* The draw cleans the parent together with the drawn child, the other
+       child is cleaned afterwards */
+    parent.translate(Vector3::xAxis(1.0f));
+    camera.draw(group);
+    CORRADE_COMPARE(drawable.count, 1);
+    CORRADE_VERIFY(!parent.isDirty());
+    CORRADE_VERIFY(notDrawn.isDirty());
+    scene.setAllClean();
+    CORRADE_VERIFY(!notDrawn.isDirty());
+    CORRADE_COMPARE(feature.absoluteTransformation, Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* Next change of the child is propagated too */
+    notDrawn.translate(Vector3::yAxis(1.0f));
+    camera.draw(group);
+    scene.setAllClean();
+    CORRADE_VERIFY(!notDrawn.isDirty());
+    CORRADE_COMPARE(feature.absoluteTransformation, Matrix4::translation({1.0f, 1.0f, 0.0f}));
+}
+
+void CameraTest::drawMultiple() {
+    typedef std::tuple<Int, AbstractCamera3D*, Matrix4> Call;
+
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<Call>& calls, Int id, bool cached = true): SceneGraph::Drawable3D(object, group), calls(calls), id(id) {
+                if(!cached) setCachedTransformations({});
+            }
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, AbstractCamera3D& camera) override {
+                calls.emplace_back(id, &camera, transformationMatrix);
+            }
+
+        private:
+            std::vector<Call>& calls;
+            Int id;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Call> calls;
+
+    Object3D first(&scene);
+    first.translate(Vector3::zAxis(-5.0f));
+    (new Drawable(first, &group, calls, 0))->setBoundingBox({Vector3(-1.0f), Vector3(1.0f)});
+
+    /* Not cached, computed only once for both cameras */
+    Object3D second(&first);
+    second.translate(Vector3::xAxis(2.0f));
+    new Drawable(second, &group, calls, 1, false);
+
+    /* One camera looks the other way and culls the first drawable, the other
+       draws sorted */
+    Object3D leftObject(&scene), rightObject(&scene);
+    leftObject.translate(Vector3::xAxis(-1.0f));
+    rightObject.rotateY(Deg(180.0f))
+        .translate(Vector3::xAxis(1.0f));
+    Camera3D left(leftObject), right(rightObject);
+    left.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f)
+        .setDrawOrder(DrawOrder::BackToFront);
+    right.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+
+    std::vector<AbstractCamera3D*> drawnCameras;
+    AbstractCamera3D::draw({&left, &right}, group, [&](AbstractCamera3D& camera) {
+        drawnCameras.push_back(&camera);
+    });
+
+    CORRADE_COMPARE(drawnCameras, (std::vector<AbstractCamera3D*>{&left, &right}));
+    CORRADE_COMPARE(calls.size(), 3);
+    CORRADE_COMPARE(std::get<0>(calls[0]), 0);
+    CORRADE_VERIFY(std::get<1>(calls[0]) == &left);
+    CORRADE_COMPARE(std::get<2>(calls[0]), Matrix4::translation({1.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(std::get<0>(calls[1]), 1);
+    CORRADE_VERIFY(std::get<1>(calls[1]) == &left);
+    CORRADE_COMPARE(std::get<2>(calls[1]), Matrix4::translation({3.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(std::get<0>(calls[2]), 1);
+    CORRADE_VERIFY(std::get<1>(calls[2]) == &right);
+    CORRADE_COMPARE(std::get<2>(calls[2]), (Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::rotationY(Deg(180.0f))).inverted()*Matrix4::translation({2.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(left.culledDrawableCount(), 0);
+    CORRADE_COMPARE(right.culledDrawableCount(), 1);
+
+    /* Same result as drawing with each camera separately */
+    std::vector<Call> expected;
+    std::swap(calls, expected);
+    left.draw(group);
+    right.draw(group);
+    CORRADE_COMPARE(calls.size(), expected.size());
+    for(std::size_t i = 0; i != calls.size(); ++i) {
+        CORRADE_COMPARE(std::get<0>(calls[i]), std::get<0>(expected[i]));
+        CORRADE_VERIFY(std::get<1>(calls[i]) == std::get<1>(expected[i]));
+        CORRADE_COMPARE(std::get<2>(calls[i]), std::get<2>(expected[i]));
+    }
+
+    /* No cameras, nothing done */
+    calls.clear();
+    AbstractCamera3D::draw({}, group);
+    CORRADE_VERIFY(calls.empty());
+}
+
+void CameraTest::drawMultipleDifferentScene() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    DrawableGroup3D group;
+    Scene3D scene, another;
+    Object3D firstObject(&scene), secondObject(&another);
+    Camera3D first(firstObject), second(secondObject);
+    AbstractCamera3D::draw({&first, &second}, group);
+    CORRADE_COMPARE(out.str(), "Camera::draw(): all cameras must be part of the same scene\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
@@ -0,0 +1,75 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "SceneGraph/AbstractGroupedFeature.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class FeatureGroupBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        FeatureGroupBenchmark();
+
+        void addRemove100k();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class Feature: public AbstractGroupedFeature3D<Feature> {
+    public:
+        Feature(AbstractObject3D& object, FeatureGroup3D<Feature>* group = nullptr): AbstractGroupedFeature3D<Feature>(object, group) {}
+};
+
+FeatureGroupBenchmark::FeatureGroupBenchmark() {
+    addTests({&FeatureGroupBenchmark::addRemove100k});
+}
+
+void FeatureGroupBenchmark::addRemove100k() {
+    Scene3D scene;
+    FeatureGroup3D<Feature> group;
+
+    /* Objects living for the whole benchmark, each frame 100k features is
+       added to them and then destroyed in the order of creation */
+    std::vector<Object3D*> objects(1000);
+    for(Object3D*& o: objects) o = new Object3D(&scene);
+
+    std::vector<Feature*> features(100000);
+    std::size_t maxSize = 0;
+    benchmark("spawning and destroying 100k grouped features", 5, [&]() {
+        for(std::size_t i = 0; i != features.size(); ++i)
+            features[i] = new Feature(*objects[i % objects.size()], &group);
+        maxSize = group.size();
+        for(Feature* feature: features) delete feature;
+    });
+
+    CORRADE_COMPARE(maxSize, 100000);
+    CORRADE_VERIFY(group.isEmpty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FeatureGroupBenchmark)
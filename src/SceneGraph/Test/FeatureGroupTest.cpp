@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/AbstractGroupedFeature.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class FeatureGroupTest: public TestSuite::Tester {
+    public:
+        FeatureGroupTest();
+
+        void addRemove();
+        void removeDestroyed();
+        void moveToAnotherGroup();
+        void destroyGroup();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+class Feature: public AbstractGroupedFeature3D<Feature> {
+    public:
+        Feature(AbstractObject3D& object, FeatureGroup3D<Feature>* group = nullptr): AbstractGroupedFeature3D<Feature>(object, group) {}
+};
+
+typedef FeatureGroup3D<Feature> FeatureGroup;
+
+FeatureGroupTest::FeatureGroupTest() {
+    addTests({&FeatureGroupTest::addRemove,
+              &FeatureGroupTest::removeDestroyed,
+              &FeatureGroupTest::moveToAnotherGroup,
+              &FeatureGroupTest::destroyGroup});
+}
+
+void FeatureGroupTest::addRemove() {
+    Object3D o;
+    FeatureGroup group;
+    Feature a(o, &group);
+    Feature b(o, &group);
+    Feature c(o, &group);
+    Feature d(o, &group);
+    CORRADE_COMPARE(group.size(), 4);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[3] == &d);
+
+    /* The last feature is moved to place of removed one */
+    group.remove(b);
+    CORRADE_VERIFY(!b.group());
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &d);
+    CORRADE_VERIFY(&group[2] == &c);
+
+    /* Removing the moved feature and the last one */
+    group.remove(d);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &c);
+    group.remove(c);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_VERIFY(&group[0] == &a);
+
+    /* Adding again */
+    group.add(b);
+    CORRADE_VERIFY(b.group() == &group);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_VERIFY(&group[1] == &b);
+    group.remove(a);
+    group.remove(b);
+    CORRADE_VERIFY(group.isEmpty());
+}
+
+void FeatureGroupTest::removeDestroyed() {
+    Object3D o;
+    FeatureGroup group;
+    Feature a(o, &group);
+    Feature* b = new Feature(o, &group);
+    Feature c(o, &group);
+
+    delete b;
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &c);
+
+    /* Removing the feature from its new place */
+    group.remove(c);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_VERIFY(&group[0] == &a);
+}
+
+void FeatureGroupTest::moveToAnotherGroup() {
+    Object3D o;
+    FeatureGroup group, another;
+    Feature a(o, &group);
+    Feature b(o, &group);
+    Feature c(o, &another);
+
+    another.add(a);
+    CORRADE_VERIFY(a.group() == &another);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_VERIFY(&group[0] == &b);
+    CORRADE_COMPARE(another.size(), 2);
+    CORRADE_VERIFY(&another[1] == &a);
+
+    another.remove(c);
+    CORRADE_COMPARE(another.size(), 1);
+    CORRADE_VERIFY(&another[0] == &a);
+}
+
+void FeatureGroupTest::destroyGroup() {
+    Object3D o;
+    Feature a(o);
+    {
+        FeatureGroup group;
+        group.add(a);
+        CORRADE_VERIFY(a.group() == &group);
+    }
+
+    /* The feature is not part of any group anymore */
+    CORRADE_VERIFY(!a.group());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FeatureGroupTest)
@@ -0,0 +1,383 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/Camera3D.h"
+#include "SceneGraph/Drawable.h"
+#include "SceneGraph/DualQuaternionTransformation.h"
+#include "SceneGraph/FlatScene.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class FlatObjectTest: public TestSuite::Tester {
+    public:
+        FlatObjectTest();
+
+        void parenting();
+        void parentingDifferentScene();
+        void transformation();
+        void absoluteTransformation();
+        void absoluteTransformationReparent();
+        void transformations();
+        void transformationsRelative();
+        void destruction();
+        void spawnDestroyUpdated();
+        void setClean();
+        void draw();
+        void dualQuaternion();
+};
+
+typedef SceneGraph::FlatObject<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::FlatScene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class CachingObject: public Object3D, AbstractFeature3D {
+    public:
+        explicit CachingObject(Object3D* parent): Object3D(*parent), AbstractFeature3D(*this) {
+            setCachedTransformations(CachedTransformation::Absolute);
+        }
+
+        Matrix4 cleanedAbsoluteTransformation;
+
+    protected:
+        void clean(const Matrix4& absoluteTransformation) override {
+            cleanedAbsoluteTransformation = absoluteTransformation;
+        }
+};
+
+FlatObjectTest::FlatObjectTest() {
+    addTests({&FlatObjectTest::parenting,
+              &FlatObjectTest::parentingDifferentScene,
+              &FlatObjectTest::transformation,
+              &FlatObjectTest::absoluteTransformation,
+              &FlatObjectTest::absoluteTransformationReparent,
+              &FlatObjectTest::transformations,
+              &FlatObjectTest::transformationsRelative,
+              &FlatObjectTest::destruction,
+              &FlatObjectTest::spawnDestroyUpdated,
+              &FlatObjectTest::setClean,
+              &FlatObjectTest::draw,
+              &FlatObjectTest::dualQuaternion});
+}
+
+void FlatObjectTest::parenting() {
+    Scene3D scene;
+
+    Object3D* childOne = new Object3D(scene);
+    Object3D* childTwo = new Object3D(scene);
+
+    CORRADE_VERIFY(childOne->scene() == &scene);
+    CORRADE_VERIFY(childOne->parent() == &scene);
+    CORRADE_VERIFY(childTwo->parent() == &scene);
+    CORRADE_VERIFY(scene.firstChild() == childOne);
+    CORRADE_VERIFY(scene.lastChild() == childTwo);
+    CORRADE_COMPARE(scene.objectCount(), 3);
+
+    /* A object cannot be parent of itself */
+    childOne->setParent(*childOne);
+    CORRADE_VERIFY(childOne->parent() == &scene);
+
+    /* Scene cannot have parent */
+    scene.setParent(*childTwo);
+    CORRADE_VERIFY(scene.parent() == nullptr);
+
+    /* Reparent to another */
+    childTwo->setParent(*childOne);
+    CORRADE_VERIFY(scene.firstChild() == childOne && scene.firstChild()->nextSibling() == nullptr);
+    CORRADE_VERIFY(childOne->firstChild() == childTwo && childOne->firstChild()->nextSibling() == nullptr);
+
+    /* A object cannot be parented to its child */
+    childOne->setParent(*childTwo);
+    CORRADE_VERIFY(childOne->parent() == &scene);
+
+    /* Delete child */
+    delete childTwo;
+    CORRADE_VERIFY(!childOne->hasChildren());
+    CORRADE_COMPARE(scene.objectCount(), 2);
+}
+
+void FlatObjectTest::parentingDifferentScene() {
+    Scene3D scene;
+    Scene3D another;
+    Object3D* object = new Object3D(scene);
+
+    std::ostringstream o;
+    Error::setOutput(&o);
+    object->setParent(another);
+    CORRADE_VERIFY(object->parent() == &scene);
+    CORRADE_COMPARE(o.str(), "SceneGraph::FlatObject::setParent(): the parent must be in the same scene\n");
+}
+
+void FlatObjectTest::transformation() {
+    Scene3D scene;
+    Object3D object(scene);
+
+    object.setTransformation(Matrix4::translation(Vector3::xAxis(2.0f)))
+        .transform(Matrix4::scaling(Vector3(3.0f)))
+        .transform(Matrix4::rotationZ(Deg(30.0f)), TransformationType::Local);
+    CORRADE_COMPARE(object.transformation(), Matrix4::scaling(Vector3(3.0f))*Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::rotationZ(Deg(30.0f)));
+
+    object.resetTransformation();
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4());
+
+    /* Scene cannot be transformed */
+    scene.setTransformation(Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(scene.transformation(), Matrix4());
+}
+
+void FlatObjectTest::absoluteTransformation() {
+    Scene3D scene;
+
+    Object3D* first = new Object3D(scene);
+    first->setTransformation(Matrix4::rotationZ(Deg(35.0f)));
+    Object3D* second = new Object3D(*first);
+    second->setTransformation(Matrix4::translation(Vector3::xAxis(2.0f)));
+    Object3D* third = new Object3D(*second);
+    third->setTransformation(Matrix4::scaling(Vector3(0.5f)));
+
+    CORRADE_COMPARE(third->absoluteTransformation(), Matrix4::rotationZ(Deg(35.0f))*Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::scaling(Vector3(0.5f)));
+    CORRADE_COMPARE(second->absoluteTransformationMatrix(), Matrix4::rotationZ(Deg(35.0f))*Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(scene.absoluteTransformation(), Matrix4());
+
+    /* Change in the middle of the hierarchy is propagated to children */
+    second->setTransformation(Matrix4::translation(Vector3::yAxis(3.0f)));
+    CORRADE_COMPARE(third->absoluteTransformation(), Matrix4::rotationZ(Deg(35.0f))*Matrix4::translation(Vector3::yAxis(3.0f))*Matrix4::scaling(Vector3(0.5f)));
+}
+
+void FlatObjectTest::absoluteTransformationReparent() {
+    Scene3D scene;
+
+    /* Child created before the parent, so the storage is not topologically
+       sorted after reparenting */
+    Object3D* child = new Object3D(scene);
+    child->setTransformation(Matrix4::scaling(Vector3(2.0f)));
+    Object3D* parent = new Object3D(scene);
+    parent->setTransformation(Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_COMPARE(child->absoluteTransformation(), Matrix4::scaling(Vector3(2.0f)));
+
+    child->setParent(*parent);
+    CORRADE_COMPARE(child->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::scaling(Vector3(2.0f)));
+
+    parent->setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f)));
+    CORRADE_COMPARE(child->absoluteTransformation(), Matrix4::translation(Vector3::zAxis(-1.0f))*Matrix4::scaling(Vector3(2.0f)));
+}
+
+void FlatObjectTest::transformations() {
+    Scene3D scene;
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+
+    Object3D first(scene);
+    first.setTransformation(Matrix4::rotationZ(Deg(30.0f)));
+    Object3D second(first);
+    second.setTransformation(Matrix4::scaling(Vector3(0.5f)));
+    Object3D third(first);
+    third.setTransformation(Matrix4::translation(Vector3::xAxis(5.0f)));
+
+    /* Transformation relative to the scene, including duplicates */
+    CORRADE_COMPARE(scene.transformations({&second, &third, &second}, initial), (std::vector<Matrix4>{
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f))
+    }));
+
+    /* The same through the generic interface */
+    AbstractObject3D& abstractScene = scene;
+    CORRADE_COMPARE(abstractScene.transformationMatrices({&second, &third}, initial), (std::vector<Matrix4>{
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f))
+    }));
+}
+
+void FlatObjectTest::transformationsRelative() {
+    Scene3D scene;
+    Object3D first(scene);
+    first.setTransformation(Matrix4::rotationZ(Deg(30.0f)));
+    Object3D second(first);
+    second.setTransformation(Matrix4::scaling(Vector3(0.5f)));
+    Object3D third(first);
+    third.setTransformation(Matrix4::translation(Vector3::xAxis(5.0f)));
+
+    /* Transformation relative to another object */
+    CORRADE_COMPARE(second.transformations({&third}), std::vector<Matrix4>{
+        Matrix4::scaling(Vector3(0.5f)).inverted()*Matrix4::translation(Vector3::xAxis(5.0f))
+    });
+}
+
+void FlatObjectTest::destruction() {
+    Scene3D scene;
+
+    Object3D* first = new Object3D(scene);
+    first->setTransformation(Matrix4::translation(Vector3::xAxis(1.0f)));
+    Object3D* second = new Object3D(*first);
+    new Object3D(*second);
+    Object3D* fourth = new Object3D(scene);
+    fourth->setTransformation(Matrix4::translation(Vector3::yAxis(1.0f)));
+    Object3D* fifth = new Object3D(*fourth);
+    fifth->setTransformation(Matrix4::translation(Vector3::zAxis(1.0f)));
+    CORRADE_COMPARE(scene.objectCount(), 6);
+
+    /* Destroying the object destroys also its children, the storage is
+       compacted */
+    delete first;
+    CORRADE_COMPARE(scene.objectCount(), 3);
+    CORRADE_COMPARE(fifth->absoluteTransformation(), Matrix4::translation({0.0f, 1.0f, 1.0f}));
+}
+
+void FlatObjectTest::spawnDestroyUpdated() {
+    Scene3D scene;
+
+    std::vector<Object3D*> objects;
+    for(Int i = 0; i != 8; ++i) {
+        objects.push_back(new Object3D(scene));
+        objects.back()->setTransformation(Matrix4::translation(Vector3::xAxis(Float(i))));
+    }
+    CORRADE_COMPARE(objects[7]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(7.0f)));
+
+    /* New child of an object in already updated scene is appended after it */
+    Object3D* child = new Object3D(*objects[2]);
+    child->setTransformation(Matrix4::translation(Vector3::yAxis(1.0f)));
+    CORRADE_COMPARE(child->absoluteTransformation(), Matrix4::translation({2.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(objects[7]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(7.0f)));
+
+    /* Reparenting to an object before it doesn't need reordering */
+    child->setParent(*objects[1]);
+    CORRADE_COMPARE(child->absoluteTransformation(), Matrix4::translation({1.0f, 1.0f, 0.0f}));
+
+    /* Reparenting to an object after it does */
+    child->setParent(*objects[0]);
+    objects[0]->setParent(*objects[6]);
+    CORRADE_COMPARE(child->absoluteTransformation(), Matrix4::translation({6.0f, 1.0f, 0.0f}));
+
+    /* Destroyed objects are not counted even before the storage is
+       compacted, the rest stays valid */
+    delete objects[3];
+    CORRADE_COMPARE(scene.objectCount(), 9);
+    objects[4]->setTransformation(Matrix4::translation(Vector3::zAxis(1.0f)));
+    Object3D* another = new Object3D(*objects[4]);
+    another->setTransformation(Matrix4::translation(Vector3::yAxis(1.0f)));
+    CORRADE_COMPARE(another->absoluteTransformation(), Matrix4::translation({0.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(child->absoluteTransformation(), Matrix4::translation({6.0f, 1.0f, 0.0f}));
+
+    /* Destroying more objects compacts the storage */
+    delete objects[5];
+    delete objects[6];
+    delete objects[7];
+    CORRADE_COMPARE(scene.objectCount(), 5);
+    objects[1]->setTransformation(Matrix4::translation(Vector3::zAxis(2.0f)));
+    CORRADE_COMPARE(objects[1]->absoluteTransformation(), Matrix4::translation(Vector3::zAxis(2.0f)));
+    CORRADE_COMPARE(another->absoluteTransformation(), Matrix4::translation({0.0f, 1.0f, 1.0f}));
+}
+
+void FlatObjectTest::setClean() {
+    Scene3D scene;
+
+    CachingObject* first = new CachingObject(&scene);
+    first->setTransformation(Matrix4::rotationZ(Deg(30.0f)));
+    CachingObject* second = new CachingObject(first);
+    second->setTransformation(Matrix4::scaling(Vector3(0.5f)));
+
+    /* Everything is dirty by default */
+    CORRADE_VERIFY(first->isDirty());
+    CORRADE_VERIFY(second->isDirty());
+
+    /* Cleaning the child cleans also the parent */
+    second->setClean();
+    CORRADE_VERIFY(!first->isDirty());
+    CORRADE_VERIFY(!second->isDirty());
+    CORRADE_COMPARE(first->cleanedAbsoluteTransformation, Matrix4::rotationZ(Deg(30.0f)));
+    CORRADE_COMPARE(second->cleanedAbsoluteTransformation, Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)));
+
+    /* Changing the parent marks the child dirty */
+    first->setTransformation(Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_VERIFY(first->isDirty());
+    CORRADE_VERIFY(second->isDirty());
+
+    /* Bulk cleaning */
+    AbstractObject3D::setClean({second});
+    CORRADE_VERIFY(!first->isDirty());
+    CORRADE_VERIFY(!second->isDirty());
+    CORRADE_COMPARE(second->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::scaling(Vector3(0.5f)));
+}
+
+void FlatObjectTest::draw() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, Matrix4& result): SceneGraph::Drawable3D(object, group), result(result) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, AbstractCamera3D&) override {
+                result = transformationMatrix;
+            }
+
+        private:
+            Matrix4& result;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D first(scene);
+    Matrix4 firstTransformation;
+    first.transform(Matrix4::scaling(Vector3(5.0f)));
+    new Drawable(first, &group, firstTransformation);
+
+    Object3D second(scene);
+    Matrix4 secondTransformation;
+    second.transform(Matrix4::translation(Vector3::yAxis(3.0f)));
+    new Drawable(second, &group, secondTransformation);
+
+    Object3D third(second);
+    Matrix4 thirdTransformation;
+    third.transform(Matrix4::translation(Vector3::zAxis(-1.5f)));
+    new Drawable(third, &group, thirdTransformation);
+
+    Camera3D camera(third);
+    camera.draw(group);
+
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({0.0f, -3.0f, 1.5f})*Matrix4::scaling(Vector3(5.0f)));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation(Vector3::zAxis(1.5f)));
+    CORRADE_COMPARE(thirdTransformation, Matrix4());
+
+    /* Moving the camera is reflected on next draw */
+    third.transform(Matrix4::translation(Vector3::zAxis(1.5f)));
+    camera.draw(group);
+    CORRADE_COMPARE(secondTransformation, Matrix4());
+}
+
+void FlatObjectTest::dualQuaternion() {
+    FlatScene<DualQuaternionTransformation> scene;
+    FlatObject<DualQuaternionTransformation> first(scene);
+    first.setTransformation(DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis()));
+    FlatObject<DualQuaternionTransformation> second(first);
+    second.setTransformation(DualQuaternion::translation(Vector3::xAxis(2.0f)));
+
+    CORRADE_COMPARE(second.absoluteTransformationMatrix(), Matrix4::rotationZ(Deg(90.0f))*Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatObjectTest)
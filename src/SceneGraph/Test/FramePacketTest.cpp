@@ -0,0 +1,331 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/Camera3D.h"
+#include "SceneGraph/Drawable.h"
+#include "SceneGraph/FramePacket.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class FramePacketTest: public TestSuite::Tester {
+    public:
+        FramePacketTest();
+
+        void snapshot();
+        void draw();
+        void buffer();
+        void bufferNoAllocations();
+        void threaded();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+FramePacketTest::FramePacketTest() {
+    addTests({&FramePacketTest::snapshot,
+              &FramePacketTest::draw,
+              &FramePacketTest::buffer,
+              &FramePacketTest::bufferNoAllocations,
+              &FramePacketTest::threaded});
+}
+
+namespace {
+    class IdDrawable: public Drawable3D {
+        public:
+            IdDrawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<Int>& order, Int id): Drawable3D(object, group), order(order), id(id) {}
+
+            std::vector<Int>& order;
+            Int id;
+
+        protected:
+            void draw(const Matrix4&, AbstractCamera3D&) override {
+                order.push_back(id);
+            }
+    };
+}
+
+void FramePacketTest::snapshot() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> order;
+
+    Object3D a(&scene);
+    a.translate(Vector3::zAxis(-5.0f));
+    IdDrawable da(a, &group, order, 0);
+    da.setBoundingBox({Vector3(-1.0f), Vector3(1.0f)})
+        .setSortKey(1);
+
+    /* Behind the camera */
+    Object3D b(&scene);
+    b.translate(Vector3::zAxis(5.0f));
+    IdDrawable db(b, &group, order, 1);
+    db.setBoundingBox({Vector3(-1.0f), Vector3(1.0f)});
+
+    Object3D c(&scene);
+    c.translate(Vector3::zAxis(-2.0f));
+    IdDrawable dc(c, &group, order, 2);
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::xAxis(1.0f));
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f)
+        .setDrawOrder(DrawOrder::SortKeyFrontToBack);
+
+    FramePacket3D packet;
+    CORRADE_VERIFY(!packet.camera());
+    CORRADE_COMPARE(packet.size(), 0);
+
+    camera.snapshot(group, packet);
+    CORRADE_VERIFY(packet.camera() == &camera);
+    CORRADE_COMPARE(packet.frame(), 0);
+    CORRADE_COMPARE(packet.projectionMatrix(), camera.projectionMatrix());
+    CORRADE_COMPARE(packet.cameraMatrix(), Matrix4::translation(Vector3::xAxis(-1.0f)));
+    CORRADE_COMPARE(packet.drawables(), (std::vector<Drawable3D*>{&dc, &da}));
+    CORRADE_COMPARE(packet.transformationMatrices(), (std::vector<Matrix4>{
+        Matrix4::translation({-1.0f, 0.0f, -2.0f}),
+        Matrix4::translation({-1.0f, 0.0f, -5.0f})}));
+
+    /* Nothing was drawn */
+    CORRADE_VERIFY(order.empty());
+
+    /* Changing the scene doesn't affect the packet */
+    a.translate(Vector3::yAxis(1.0f));
+    cameraObject.resetTransformation();
+    CORRADE_COMPARE(packet.transformationMatrices()[1], Matrix4::translation({-1.0f, 0.0f, -5.0f}));
+
+    /* Next snapshot reuses the packet */
+    camera.snapshot(group, packet);
+    CORRADE_COMPARE(packet.cameraMatrix(), Matrix4());
+    CORRADE_COMPARE(packet.transformationMatrices(), (std::vector<Matrix4>{
+        Matrix4::translation({0.0f, 0.0f, -2.0f}),
+        Matrix4::translation({0.0f, 1.0f, -5.0f})}));
+}
+
+void FramePacketTest::draw() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> order;
+
+    Object3D a(&scene);
+    IdDrawable da(a, &group, order, 0);
+    Object3D b(&scene);
+    IdDrawable db(b, &group, order, 1);
+    db.setSortKey(0);
+    da.setSortKey(1);
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setDrawOrder(DrawOrder::SortKeyFrontToBack);
+
+    FramePacket3D packet;
+    camera.snapshot(group, packet);
+    packet.draw();
+    CORRADE_COMPARE(order, (std::vector<Int>{1, 0}));
+}
+
+void FramePacketTest::buffer() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> order;
+
+    Object3D a(&scene);
+    IdDrawable da(a, &group, order, 0);
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+
+    FramePacketBuffer3D buffer;
+    CORRADE_COMPARE(buffer.publishedCount(), 0);
+    CORRADE_COMPARE(buffer.acquiredFrame(), 0);
+    CORRADE_VERIFY(!buffer.acquire());
+    CORRADE_COMPARE(buffer.acquiredFrame(), 0);
+
+    a.translate(Vector3::xAxis(1.0f));
+    buffer.publish(camera, group);
+    CORRADE_COMPARE(buffer.publishedCount(), 1);
+
+    const FramePacket3D* first = buffer.acquire();
+    CORRADE_VERIFY(first);
+    CORRADE_COMPARE(first->frame(), 1);
+    CORRADE_COMPARE(buffer.acquiredFrame(), 1);
+    CORRADE_COMPARE(first->transformationMatrices(), std::vector<Matrix4>{Matrix4::translation(Vector3::xAxis(1.0f))});
+
+    /* No new frame, returns the same */
+    CORRADE_VERIFY(buffer.acquire() == first);
+
+    /* Only the newest frame is returned, the acquired one isn't touched */
+    a.translate(Vector3::xAxis(1.0f));
+    buffer.publish(camera, group);
+    a.translate(Vector3::xAxis(1.0f));
+    buffer.publish(camera, group);
+    a.translate(Vector3::xAxis(1.0f));
+    buffer.publish(camera, group);
+    CORRADE_COMPARE(first->frame(), 1);
+    CORRADE_COMPARE(first->transformationMatrices(), std::vector<Matrix4>{Matrix4::translation(Vector3::xAxis(1.0f))});
+
+    /* The consumer still holds the first packet */
+    CORRADE_COMPARE(buffer.acquiredFrame(), 1);
+
+    const FramePacket3D* newest = buffer.acquire();
+    CORRADE_VERIFY(newest != first);
+    CORRADE_COMPARE(newest->frame(), 4);
+    CORRADE_COMPARE(buffer.acquiredFrame(), 4);
+    CORRADE_COMPARE(newest->transformationMatrices(), std::vector<Matrix4>{Matrix4::translation(Vector3::xAxis(4.0f))});
+}
+
+void FramePacketTest::bufferNoAllocations() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> order;
+
+    std::vector<Object3D*> objects;
+    for(Int i = 0; i != 100; ++i) {
+        objects.push_back(new Object3D(&scene));
+        new IdDrawable(*objects.back(), &group, order, i);
+    }
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+
+    /* After all packets were used once, the memory is reused */
+    FramePacketBuffer3D buffer;
+    std::vector<const Matrix4*> data;
+    for(Int i = 0; i != 4; ++i) {
+        buffer.publish(camera, group);
+        data.push_back(buffer.acquire()->transformationMatrices().data());
+    }
+    for(Int i = 0; i != 6; ++i) {
+        buffer.publish(camera, group);
+        const Matrix4* current = buffer.acquire()->transformationMatrices().data();
+        CORRADE_VERIFY(std::find(data.begin(), data.end(), current) != data.end());
+    }
+}
+
+namespace {
+    class CountingDrawable: public Drawable3D {
+        public:
+            CountingDrawable(AbstractObject3D& object, DrawableGroup3D* group, std::size_t& count): Drawable3D(object, group), count(count) {}
+
+            std::size_t& count;
+
+        protected:
+            void draw(const Matrix4&, AbstractCamera3D&) override {
+                ++count;
+            }
+    };
+}
+
+void FramePacketTest::threaded() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::size_t drawCount = 0;
+
+    /* All objects are at the same position in each frame */
+    std::vector<Object3D*> objects;
+    std::vector<CountingDrawable*> drawables;
+    for(Int i = 0; i != 200; ++i) {
+        objects.push_back(new Object3D(&scene));
+        drawables.push_back(new CountingDrawable(*objects.back(), &group, drawCount));
+    }
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+
+    FramePacketBuffer3D buffer;
+    std::atomic<bool> done(false);
+    constexpr UnsignedLong frameCount = 2000;
+
+    /* Simulation thread moves all objects, replaces one drawable in each
+       frame and publishes the frame. The replaced drawables are deleted only
+       after the consumer released all packets referencing them. */
+    std::vector<std::pair<UnsignedLong, CountingDrawable*>> pending;
+    std::thread simulation([&]() {
+        for(UnsignedLong frame = 1; frame <= frameCount; ++frame) {
+            const std::size_t replaced = frame%objects.size();
+            group.remove(*drawables[replaced]);
+            pending.emplace_back(buffer.publishedCount(), drawables[replaced]);
+            drawables[replaced] = new CountingDrawable(*objects[replaced], &group, drawCount);
+
+            for(Object3D* o: objects)
+                o->setTransformation(Matrix4::translation(Vector3::xAxis(Float(frame))));
+            buffer.publish(camera, group);
+
+            const UnsignedLong acquiredFrame = buffer.acquiredFrame();
+            auto released = std::find_if(pending.begin(), pending.end(), [acquiredFrame](const std::pair<UnsignedLong, CountingDrawable*>& p) {
+                return acquiredFrame <= p.first;
+            });
+            for(auto it = pending.begin(); it != released; ++it) delete it->second;
+            pending.erase(pending.begin(), released);
+        }
+        done = true;
+    });
+
+    /* Render thread draws each packet and checks that it is consistent and
+       newer than the previous one */
+    UnsignedLong lastFrame = 0;
+    std::size_t acquiredCount = 0, expectedDrawCount = 0;
+    bool consistent = true, ordered = true;
+    for(;;) {
+        const bool finished = done;
+        const FramePacket3D* packet = buffer.acquire();
+        if(packet && packet->frame() != lastFrame) {
+            ++acquiredCount;
+            if(packet->frame() < lastFrame) ordered = false;
+            lastFrame = packet->frame();
+
+            if(packet->size() != objects.size()) consistent = false;
+            for(const Matrix4& transformation: packet->transformationMatrices())
+                if(transformation != Matrix4::translation(Vector3::xAxis(Float(lastFrame))))
+                    consistent = false;
+        }
+
+        /* Draw the packet, possibly again, while the simulation continues */
+        if(packet) {
+            packet->draw();
+            expectedDrawCount += packet->size();
+        }
+
+        if(finished && lastFrame == frameCount) break;
+    }
+
+    simulation.join();
+    for(const auto& p: pending) delete p.second;
+
+    CORRADE_VERIFY(consistent);
+    CORRADE_VERIFY(ordered);
+    CORRADE_VERIFY(acquiredCount >= 1);
+    CORRADE_COMPARE(lastFrame, frameCount);
+    CORRADE_COMPARE(drawCount, expectedDrawCount);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FramePacketTest)
@@ -0,0 +1,385 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/Camera2D.h"
+#include "SceneGraph/Camera3D.h"
+#include "SceneGraph/LevelOfDetail.h"
+#include "SceneGraph/MatrixTransformation2D.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class LevelOfDetailTest: public TestSuite::Tester {
+    public:
+        LevelOfDetailTest();
+
+        void distance();
+        void distanceBoundingBox();
+        void projectedSize();
+        void projectedSizeOrthographic();
+        void projectedSize2D();
+        void hysteresis();
+        void statistics();
+        void cameraDraw();
+        void noLevels();
+        void addLevelInvalid();
+        void setMetricInvalid();
+        void setHysteresisInvalid();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+LevelOfDetailTest::LevelOfDetailTest() {
+    addTests({&LevelOfDetailTest::distance,
+              &LevelOfDetailTest::distanceBoundingBox,
+              &LevelOfDetailTest::projectedSize,
+              &LevelOfDetailTest::projectedSizeOrthographic,
+              &LevelOfDetailTest::projectedSize2D,
+              &LevelOfDetailTest::hysteresis,
+              &LevelOfDetailTest::statistics,
+              &LevelOfDetailTest::cameraDraw,
+              &LevelOfDetailTest::noLevels,
+              &LevelOfDetailTest::addLevelInvalid,
+              &LevelOfDetailTest::setMetricInvalid,
+              &LevelOfDetailTest::setHysteresisInvalid});
+}
+
+namespace {
+    template<UnsignedInt dimensions> class IdDrawable: public Drawable<dimensions, Float> {
+        public:
+            IdDrawable(AbstractObject<dimensions, Float>& object, std::vector<Int>& drawn, Int id): Drawable<dimensions, Float>(object), drawn(drawn), id(id) {}
+
+            void draw(const typename DimensionTraits<dimensions, Float>::MatrixType&, AbstractCamera<dimensions, Float>&) override {
+                drawn.push_back(id);
+            }
+
+        private:
+            std::vector<Int>& drawn;
+            Int id;
+    };
+
+    /* Draws the LOD with object at given distance from the camera, returns
+       drawn level or -1 */
+    Int drawAt(LevelOfDetail3D& lod, AbstractCamera3D& camera, std::vector<Int>& drawn, Float distance) {
+        drawn.clear();
+        lod.draw(Matrix4::translation(Vector3::zAxis(-distance)), camera);
+        return drawn.empty() ? -1 : drawn.front();
+    }
+}
+
+void LevelOfDetailTest::distance() {
+    Scene3D scene;
+    Object3D o(&scene), cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    std::vector<Int> drawn;
+
+    LevelOfDetail3D lod(o);
+    CORRADE_COMPARE(lod.metric(), LevelOfDetailMetric::Distance);
+    lod.setHysteresis(0.0f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 0), 10.0f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 1), 50.0f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 2), 200.0f);
+    CORRADE_COMPARE(lod.levelCount(), 3);
+    CORRADE_COMPARE(lod.levelThreshold(1), 50.0f);
+    CORRADE_COMPARE(lod.level(), 3);
+
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 1.0f), 0);
+    CORRADE_COMPARE(lod.level(), 0);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 20.0f), 1);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 199.0f), 2);
+    CORRADE_COMPARE(lod.level(), 2);
+
+    /* Beyond the last level, nothing is drawn */
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 201.0f), -1);
+    CORRADE_COMPARE(lod.level(), 3);
+
+    /* Back */
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 5.0f), 0);
+}
+
+void LevelOfDetailTest::distanceBoundingBox() {
+    Scene3D scene;
+    Object3D o(&scene), cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    std::vector<Int> drawn;
+
+    /* Distance is measured to center of the box */
+    LevelOfDetail3D lod(o);
+    lod.setBoundingBox({{-1.0f, -1.0f, 25.0f}, {1.0f, 1.0f, 35.0f}});
+    lod.addLevel(*new IdDrawable<3>(o, drawn, 0), 10.0f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 1), 50.0f);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 35.0f), 0);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 80.0f), 1);
+}
+
+void LevelOfDetailTest::projectedSize() {
+    Scene3D scene;
+    Object3D o(&scene), cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 1000.0f);
+    std::vector<Int> drawn;
+
+    /* Sphere with radius 1 enclosing the box, with 90° FOV at distance 10 the
+       viewport height is 20 units, thus the projected size is 0.1 */
+    LevelOfDetail3D lod(o);
+    lod.setBoundingBox({Vector3(-1.0f/Constants::sqrt3()), Vector3(1.0f/Constants::sqrt3())});
+    lod.setMetric(LevelOfDetailMetric::ProjectedSize)
+        .setHysteresis(0.0f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 0), 0.2f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 1), 0.05f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 2), 0.01f);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 4.0f), 0);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 10.0f), 1);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 30.0f), 2);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 150.0f), -1);
+
+    /* Scaled object */
+    drawn.clear();
+    lod.draw(Matrix4::translation(Vector3::zAxis(-10.0f))*Matrix4::scaling({1.0f, 3.0f, 1.0f}), camera);
+    CORRADE_COMPARE(drawn, std::vector<Int>{0});
+
+    /* Behind the camera */
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, -10.0f), -1);
+}
+
+void LevelOfDetailTest::projectedSizeOrthographic() {
+    Scene3D scene;
+    Object3D o(&scene), cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    std::vector<Int> drawn;
+
+    /* Size doesn't depend on distance */
+    LevelOfDetail3D lod(o);
+    lod.setBoundingBox({Vector3(-1.0f/Constants::sqrt3()), Vector3(1.0f/Constants::sqrt3())});
+    lod.setMetric(LevelOfDetailMetric::ProjectedSize)
+        .addLevel(*new IdDrawable<3>(o, drawn, 0), 0.2f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 1), 0.05f);
+
+    camera.setOrthographic({20.0f, 20.0f}, 0.1f, 1000.0f);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 1.0f), 1);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 100.0f), 1);
+
+    camera.setOrthographic({5.0f, 5.0f}, 0.1f, 1000.0f);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 100.0f), 0);
+}
+
+void LevelOfDetailTest::projectedSize2D() {
+    Scene2D scene;
+    Object2D o(&scene), cameraObject(&scene);
+    Camera2D camera(cameraObject);
+    camera.setProjection({10.0f, 10.0f});
+    std::vector<Int> drawn;
+
+    /* Circle with radius 1 in viewport with height 10 */
+    LevelOfDetail2D lod(o);
+    lod.setBoundingBox({Vector2(-1.0f/Constants::sqrt2()), Vector2(1.0f/Constants::sqrt2())});
+    lod.setMetric(LevelOfDetailMetric::ProjectedSize)
+        .addLevel(*new IdDrawable<2>(o, drawn, 0), 0.5f)
+        .addLevel(*new IdDrawable<2>(o, drawn, 1), 0.1f);
+
+    lod.draw(Matrix3(), camera);
+    CORRADE_COMPARE(drawn, std::vector<Int>{1});
+
+    drawn.clear();
+    lod.draw(Matrix3::scaling(Vector2(3.0f)), camera);
+    CORRADE_COMPARE(drawn, std::vector<Int>{0});
+}
+
+void LevelOfDetailTest::hysteresis() {
+    Scene3D scene;
+    Object3D o(&scene), cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    std::vector<Int> drawn;
+
+    LevelOfDetail3D lod(o);
+    CORRADE_COMPARE(lod.hysteresis(), 0.1f);
+    lod.addLevel(*new IdDrawable<3>(o, drawn, 0), 10.0f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 1), 100.0f);
+
+    /* First selection doesn't use hysteresis */
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 10.5f), 1);
+
+    /* Going back to more detailed level only before 9 */
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 9.5f), 1);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 8.5f), 0);
+
+    /* Going to less detailed level only after 11 */
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 10.5f), 0);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 11.5f), 1);
+
+    /* Disappearing after 110 and appearing before 90 */
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 105.0f), 1);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 115.0f), -1);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 95.0f), -1);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 85.0f), 1);
+
+    /* Skipping levels */
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 1.0f), 0);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 1000.0f), -1);
+}
+
+void LevelOfDetailTest::statistics() {
+    Scene3D scene;
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    std::vector<Int> drawn;
+
+    LevelOfDetailStatistics statistics;
+    CORRADE_VERIFY(statistics.drawnCounts().empty());
+    CORRADE_COMPARE(statistics.drawnCount(2), 0);
+
+    std::vector<LevelOfDetail3D*> lods;
+    for(Float distance: {1.0f, 2.0f, 20.0f, 30.0f, 40.0f, 300.0f, 400.0f}) {
+        Object3D* o = new Object3D(&scene);
+        LevelOfDetail3D* lod = new LevelOfDetail3D(*o);
+        lod->addLevel(*new IdDrawable<3>(*o, drawn, 0), 10.0f)
+            .addLevel(*new IdDrawable<3>(*o, drawn, 1), 50.0f)
+            .addLevel(*new IdDrawable<3>(*o, drawn, 2), 350.0f)
+            .setStatistics(&statistics);
+        CORRADE_VERIFY(lod->statistics() == &statistics);
+        drawAt(*lod, camera, drawn, distance);
+        lods.push_back(lod);
+    }
+
+    CORRADE_COMPARE(statistics.drawnCounts(), (std::vector<UnsignedInt>{2, 3, 1}));
+    CORRADE_COMPARE(statistics.drawnCount(1), 3);
+    CORRADE_COMPARE(statistics.drawnCount(7), 0);
+
+    statistics.reset();
+    CORRADE_COMPARE(statistics.drawnCounts(), (std::vector<UnsignedInt>{0, 0, 0}));
+
+    /* Disabled */
+    lods[0]->setStatistics(nullptr);
+    drawAt(*lods[0], camera, drawn, 1.0f);
+    CORRADE_COMPARE(drawn, std::vector<Int>{0});
+    CORRADE_COMPARE(statistics.drawnCounts(), (std::vector<UnsignedInt>{0, 0, 0}));
+}
+
+void LevelOfDetailTest::cameraDraw() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D near(&scene), far(&scene), behind(&scene);
+    near.translate(Vector3::zAxis(-5.0f));
+    far.translate(Vector3::zAxis(-500.0f));
+    behind.translate(Vector3::zAxis(500.0f));
+    for(Object3D* o: {&near, &far, &behind}) {
+        LevelOfDetail3D* lod = new LevelOfDetail3D(*o, &group);
+        lod->setBoundingBox({Vector3(-1.0f), Vector3(1.0f)});
+        lod->addLevel(*new IdDrawable<3>(*o, drawn, 0), 10.0f)
+            .addLevel(*new IdDrawable<3>(*o, drawn, 1), 1000.0f);
+    }
+
+    /* The one behind is culled, the others are drawn with their levels */
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 2000.0f);
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 1}));
+    CORRADE_COMPARE(camera.culledDrawableCount(), 1);
+}
+
+void LevelOfDetailTest::noLevels() {
+    Scene3D scene;
+    Object3D o(&scene), cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    std::vector<Int> drawn;
+
+    LevelOfDetail3D lod(o);
+    CORRADE_COMPARE(drawAt(lod, camera, drawn, 1.0f), -1);
+    CORRADE_COMPARE(lod.level(), 0);
+}
+
+void LevelOfDetailTest::addLevelInvalid() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Scene3D scene;
+    Object3D o(&scene);
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    LevelOfDetail3D lod(o);
+    lod.addLevel(*new IdDrawable<3>(o, drawn, 0), 10.0f);
+    lod.addLevel(*new IdDrawable<3>(o, drawn, 1), 10.0f);
+    CORRADE_COMPARE(lod.levelCount(), 1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::addLevel(): thresholds must be increasing but got 10 after 10\n");
+
+    out.str({});
+    LevelOfDetail3D lod2(o);
+    lod2.setMetric(LevelOfDetailMetric::ProjectedSize)
+        .addLevel(*new IdDrawable<3>(o, drawn, 0), 0.1f)
+        .addLevel(*new IdDrawable<3>(o, drawn, 1), 0.5f);
+    CORRADE_COMPARE(lod2.levelCount(), 1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::addLevel(): thresholds must be decreasing but got 0.5 after 0.1\n");
+
+    out.str({});
+    IdDrawable<3>* grouped = new IdDrawable<3>(o, drawn, 2);
+    group.add(*grouped);
+    lod.addLevel(*grouped, 100.0f);
+    CORRADE_COMPARE(lod.levelCount(), 1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::addLevel(): the drawable must not be part of any group\n");
+}
+
+void LevelOfDetailTest::setMetricInvalid() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Scene3D scene;
+    Object3D o(&scene);
+    std::vector<Int> drawn;
+
+    LevelOfDetail3D lod(o);
+    lod.addLevel(*new IdDrawable<3>(o, drawn, 0), 10.0f)
+        .setMetric(LevelOfDetailMetric::ProjectedSize);
+    CORRADE_COMPARE(lod.metric(), LevelOfDetailMetric::Distance);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::setMetric(): can't change metric after levels were added\n");
+}
+
+void LevelOfDetailTest::setHysteresisInvalid() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Scene3D scene;
+    Object3D o(&scene);
+
+    LevelOfDetail3D lod(o);
+    lod.setHysteresis(1.0f)
+        .setHysteresis(-0.5f);
+    CORRADE_COMPARE(lod.hysteresis(), 0.1f);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::setHysteresis(): hysteresis must be in range [0, 1), got 1\n"
+                               "SceneGraph::LevelOfDetail::setHysteresis(): hysteresis must be in range [0, 1), got -0.5\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::LevelOfDetailTest)
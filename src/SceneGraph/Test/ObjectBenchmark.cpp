@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+#include "SceneGraph/TransformationContext.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class ObjectBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        ObjectBenchmark();
+
+        void transformations10k();
+        void transformations100k();
+        void transformations1M();
+        void transformationsContext100k();
+        void transformationsThreadedWide();
+        void transformationsThreadedDeep();
+        void transformationsRelativeSubtree();
+        void absoluteTransformationDeep();
+
+    private:
+        void populate(Scene3D& scene, std::vector<Object3D*>& objects, std::size_t count);
+        void transformations(std::size_t count);
+};
+
+ObjectBenchmark::ObjectBenchmark() {
+    addTests({&ObjectBenchmark::transformations10k,
+              &ObjectBenchmark::transformations100k,
+              &ObjectBenchmark::transformations1M,
+              &ObjectBenchmark::transformationsContext100k,
+              &ObjectBenchmark::transformationsThreadedWide,
+              &ObjectBenchmark::transformationsThreadedDeep,
+              &ObjectBenchmark::transformationsRelativeSubtree,
+              &ObjectBenchmark::absoluteTransformationDeep});
+}
+
+void ObjectBenchmark::transformations10k() { transformations(10000); }
+void ObjectBenchmark::transformations100k() { transformations(100000); }
+void ObjectBenchmark::transformations1M() { transformations(1000000); }
+
+void ObjectBenchmark::populate(Scene3D& scene, std::vector<Object3D*>& objects, const std::size_t count) {
+    /* Three-level hierarchy with 100 groups, each having 10 children with
+       (count/1000) leaf objects */
+    objects.reserve(count);
+    for(std::size_t i = 0; i != 100; ++i) {
+        Object3D* group = new Object3D(&scene);
+        group->translate(Vector3::xAxis(Float(i)));
+        for(std::size_t j = 0; j != 10; ++j) {
+            Object3D* child = new Object3D(group);
+            child->translate(Vector3::yAxis(Float(j)));
+            for(std::size_t k = 0; k != count/1000; ++k) {
+                Object3D* leaf = new Object3D(child);
+                leaf->translate(Vector3::zAxis(Float(k)));
+                objects.push_back(leaf);
+            }
+        }
+    }
+}
+
+void ObjectBenchmark::transformations(const std::size_t count) {
+    Scene3D scene;
+    std::vector<Object3D*> objects;
+    populate(scene, objects, count);
+
+    std::vector<Matrix4> transformations;
+    benchmark("transformations()", 5, [&]() {
+        transformations = scene.transformations(objects);
+    });
+
+    CORRADE_COMPARE(transformations.size(), count);
+    CORRADE_COMPARE(transformations.back(), Matrix4::translation(Vector3(99.0f, 9.0f, Float(count/1000 - 1))));
+}
+
+void ObjectBenchmark::transformationsContext100k() {
+    Scene3D scene;
+    std::vector<Object3D*> objects;
+    populate(scene, objects, 100000);
+
+    TransformationContext<MatrixTransformation3D> context;
+    std::vector<Matrix4> transformations;
+    benchmark("transformations() with context", 5, [&]() {
+        transformations = scene.transformations(objects, context);
+    });
+
+    CORRADE_COMPARE(transformations.size(), 100000);
+    CORRADE_COMPARE(transformations.back(), Matrix4::translation({99.0f, 9.0f, 99.0f}));
+}
+
+void ObjectBenchmark::transformationsThreadedWide() {
+    Scene3D scene;
+    std::vector<Object3D*> objects;
+    populate(scene, objects, 1000000);
+
+    const std::vector<Matrix4> expected = scene.transformations(objects);
+    for(UnsignedInt threadCount: {1, 2, 4, 8}) {
+        std::ostringstream name;
+        name << "transformations() on wide hierarchy, " << threadCount << " threads";
+
+        std::vector<Matrix4> transformations;
+        benchmark(name.str(), 3, [&]() {
+            transformations = scene.transformations(objects, {}, threadCount);
+        });
+
+        CORRADE_VERIFY(transformations == expected);
+    }
+}
+
+void ObjectBenchmark::transformationsThreadedDeep() {
+    Scene3D scene;
+
+    /* 1000 chains with depth of 1000 objects, every tenth object in the chain
+       is in the list */
+    std::vector<Object3D*> objects;
+    objects.reserve(100000);
+    for(std::size_t i = 0; i != 1000; ++i) {
+        Object3D* chain = new Object3D(&scene);
+        chain->translate(Vector3::xAxis(Float(i)));
+        for(std::size_t j = 0; j != 1000; ++j) {
+            chain = new Object3D(chain);
+            chain->rotateZ(Deg(0.01f));
+            if(j % 10 == 9) objects.push_back(chain);
+        }
+    }
+
+    const std::vector<Matrix4> expected = scene.transformations(objects);
+    for(UnsignedInt threadCount: {1, 2, 4, 8}) {
+        std::ostringstream name;
+        name << "transformations() on deep hierarchy, " << threadCount << " threads";
+
+        std::vector<Matrix4> transformations;
+        benchmark(name.str(), 3, [&]() {
+            transformations = scene.transformations(objects, {}, threadCount);
+        });
+
+        CORRADE_VERIFY(transformations == expected);
+    }
+}
+
+void ObjectBenchmark::transformationsRelativeSubtree() {
+    Scene3D scene;
+    std::vector<Object3D*> sceneObjects;
+    populate(scene, sceneObjects, 100000);
+
+    /* Island with 10k objects at the end of a chain with depth of 1000
+       objects */
+    Object3D* chain = sceneObjects.back();
+    for(std::size_t i = 0; i != 1000; ++i) {
+        chain = new Object3D(chain);
+        chain->rotateZ(Deg(0.01f));
+    }
+    Object3D* island = chain;
+    std::vector<Object3D*> objects;
+    objects.reserve(10000);
+    for(std::size_t i = 0; i != 100; ++i) {
+        Object3D* group = new Object3D(island);
+        group->translate(Vector3::xAxis(Float(i)));
+        for(std::size_t j = 0; j != 100; ++j) {
+            objects.push_back(new Object3D(group));
+            objects.back()->translate(Vector3::yAxis(Float(j)));
+        }
+    }
+
+    /* Going through the root, the transformations have to be made relative
+       to the island afterwards */
+    std::vector<Matrix4> rootBased;
+    benchmark("transformations() relative to subtree, from root", 10, [&]() {
+        const Matrix4 inverted = island->absoluteTransformationMatrix().inverted();
+        rootBased = scene.transformationMatrices(objects);
+        for(Matrix4& transformation: rootBased) transformation = inverted*transformation;
+    });
+
+    std::vector<Matrix4> relative;
+    benchmark("transformations() relative to subtree, from subtree root", 10, [&]() {
+        relative = island->transformationMatrices(objects);
+    });
+
+    CORRADE_COMPARE(relative.back(), Matrix4::translation({99.0f, 99.0f, 0.0f}));
+    CORRADE_COMPARE(rootBased.back().translation().x(), 99.0f);
+}
+
+void ObjectBenchmark::absoluteTransformationDeep() {
+    Scene3D scene;
+
+    /* 1000 chains with depth of 64 objects, querying all objects */
+    std::vector<Object3D*> roots, objects;
+    objects.reserve(64000);
+    for(std::size_t i = 0; i != 1000; ++i) {
+        Object3D* chain = new Object3D(&scene);
+        roots.push_back(chain);
+        for(std::size_t j = 0; j != 64; ++j) {
+            chain = new Object3D(chain);
+            chain->translate(Vector3::xAxis(1.0f));
+            objects.push_back(chain);
+        }
+    }
+
+    Vector3 sum;
+    benchmark("absoluteTransformation() on deep chains, repeated", 10, [&]() {
+        sum = {};
+        for(Object3D* o: objects) sum += o->absoluteTransformation().translation();
+    });
+    CORRADE_COMPARE(sum, Vector3::xAxis(1000.0f*64.0f*65.0f/2.0f));
+
+    benchmark("absoluteTransformation() on deep chains, moved roots", 10, [&]() {
+        for(Object3D* o: roots) o->translate(Vector3::yAxis(1.0f));
+        sum = {};
+        for(Object3D* o: objects) sum += o->absoluteTransformation().translation();
+    });
+    CORRADE_COMPARE(sum.x(), 1000.0f*64.0f*65.0f/2.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ObjectBenchmark)
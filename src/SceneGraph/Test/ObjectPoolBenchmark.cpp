@@ -0,0 +1,98 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "SceneGraph/AbstractFeature.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/ObjectPool.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class ObjectPoolBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        ObjectPoolBenchmark();
+
+        void spawnDespawnHeap();
+        void spawnDespawnPool();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class Feature: public AbstractFeature3D {
+    public:
+        Feature(AbstractObject3D& object): AbstractFeature3D(object) {}
+};
+
+class PooledObject: public Object3D, public PoolAllocated {
+    public:
+        PooledObject(Object3D* parent = nullptr): Object3D(parent) {}
+};
+
+class PooledFeature: public AbstractFeature3D, public PoolAllocated {
+    public:
+        PooledFeature(AbstractObject3D& object): AbstractFeature3D(object) {}
+};
+
+ObjectPoolBenchmark::ObjectPoolBenchmark() {
+    addTests({&ObjectPoolBenchmark::spawnDespawnHeap,
+              &ObjectPoolBenchmark::spawnDespawnPool});
+}
+
+void ObjectPoolBenchmark::spawnDespawnHeap() {
+    Scene3D scene;
+    std::vector<Object3D*> objects(100000);
+
+    benchmark("spawning and despawning 100k objects using new/delete", 5, [&]() {
+        for(Object3D*& o: objects) {
+            o = new Object3D(&scene);
+            new Feature(*o);
+        }
+        for(Object3D* o: objects) delete o;
+    });
+
+    CORRADE_VERIFY(!scene.firstChild());
+}
+
+void ObjectPoolBenchmark::spawnDespawnPool() {
+    ObjectPool pool(4096);
+    Scene3D scene;
+    std::vector<Object3D*> objects(100000);
+
+    benchmark("spawning and despawning 100k objects using ObjectPool", 5, [&]() {
+        for(Object3D*& o: objects) {
+            o = new(pool) PooledObject(&scene);
+            new(pool) PooledFeature(*o);
+        }
+        for(Object3D* o: objects) delete o;
+    });
+
+    CORRADE_VERIFY(!scene.firstChild());
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ObjectPoolBenchmark)
@@ -0,0 +1,157 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/AbstractFeature.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/ObjectPool.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class ObjectPoolTest: public TestSuite::Tester {
+    public:
+        ObjectPoolTest();
+
+        void allocate();
+        void allocateLarge();
+        void objects();
+        void features();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class PooledObject: public Object3D, public PoolAllocated {
+    public:
+        PooledObject(Object3D* parent = nullptr): Object3D(parent) {}
+};
+
+class PooledFeature: public AbstractFeature3D, public PoolAllocated {
+    public:
+        PooledFeature(AbstractObject3D& object): AbstractFeature3D(object) {}
+};
+
+ObjectPoolTest::ObjectPoolTest() {
+    addTests({&ObjectPoolTest::allocate,
+              &ObjectPoolTest::allocateLarge,
+              &ObjectPoolTest::objects,
+              &ObjectPoolTest::features});
+}
+
+void ObjectPoolTest::allocate() {
+    ObjectPool pool(4);
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+    CORRADE_COMPARE(pool.capacity(), 0);
+
+    void* a = pool.allocate(100);
+    void* b = pool.allocate(100);
+    void* c = pool.allocate(7);
+    CORRADE_COMPARE(pool.allocatedCount(), 3);
+    CORRADE_COMPARE(pool.capacity(), 8);
+    CORRADE_VERIFY(a != b);
+    CORRADE_COMPARE(reinterpret_cast<std::size_t>(a) % 16, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::size_t>(b) % 16, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::size_t>(c) % 16, 0);
+
+    /* Freed memory is reused */
+    ObjectPool::deallocate(a);
+    CORRADE_COMPARE(pool.allocatedCount(), 2);
+    void* d = pool.allocate(112);
+    CORRADE_VERIFY(d == a);
+
+    /* New chunk is allocated when the previous one is full */
+    void* e = pool.allocate(100);
+    void* f = pool.allocate(100);
+    void* g = pool.allocate(100);
+    CORRADE_COMPARE(pool.allocatedCount(), 6);
+    CORRADE_COMPARE(pool.capacity(), 12);
+
+    for(void* memory: {b, c, d, e, f, g}) ObjectPool::deallocate(memory);
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+    CORRADE_COMPARE(pool.capacity(), 12);
+}
+
+void ObjectPoolTest::allocateLarge() {
+    ObjectPool pool;
+
+    /* Allocated on the heap */
+    void* a = pool.allocate(ObjectPool::MaxSize + 1);
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+    CORRADE_COMPARE(pool.capacity(), 0);
+    ObjectPool::deallocate(a);
+
+    void* b = ObjectPool::allocateUnpooled(32);
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+    ObjectPool::deallocate(b);
+}
+
+void ObjectPoolTest::objects() {
+    ObjectPool pool;
+    Scene3D scene;
+
+    /* Children are deleted together with parent, returning the memory to
+       the pool */
+    PooledObject* a = new(pool) PooledObject(&scene);
+    for(std::size_t i = 0; i != 1000; ++i)
+        new(pool) PooledObject(a);
+    CORRADE_COMPARE(pool.allocatedCount(), 1001);
+    CORRADE_COMPARE(a->lastChild()->parent(), a);
+
+    delete a;
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+    CORRADE_VERIFY(!scene.firstChild());
+
+    /* Pooled objects can be mixed with heap-allocated ones */
+    Object3D* b = new PooledObject(&scene);
+    new(pool) PooledObject(b);
+    new Object3D(b);
+    CORRADE_COMPARE(pool.allocatedCount(), 1);
+    delete b;
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+
+    /* Objects still in the scene are destroyed before the pool */
+    new(pool) PooledObject(&scene);
+}
+
+void ObjectPoolTest::features() {
+    ObjectPool pool;
+    Object3D* o = new Object3D;
+
+    new(pool) PooledFeature(*o);
+    PooledFeature* feature = new(pool) PooledFeature(*o);
+    CORRADE_COMPARE(pool.allocatedCount(), 2);
+
+    delete feature;
+    CORRADE_COMPARE(pool.allocatedCount(), 1);
+
+    /* Features are deleted together with the object */
+    delete o;
+    CORRADE_COMPARE(pool.allocatedCount(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ObjectPoolTest)
@@ -22,11 +22,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <TestSuite/Tester.h>
 
 #include "SceneGraph/MatrixTransformation3D.h"
 #include "SceneGraph/Scene.h"
+#include "SceneGraph/TransformationContext.h"
 
 namespace Magnum { namespace SceneGraph { namespace Test {
 
@@ -38,13 +40,27 @@ class ObjectTest: public TestSuite::Tester {
         void scene();
         void setParentKeepTransformation();
         void absoluteTransformation();
+        void absoluteTransformationCached();
+        void absoluteTransformationCachedDeep();
         void transformations();
         void transformationsRelative();
+        void transformationsRelativeSubtree();
+        void transformationsRelativeAncestor();
+        void transformationsRelativeThreaded();
         void transformationsOrphan();
         void transformationsDuplicate();
+        void transformationsLargeScene();
+        void transformationsContext();
+        void transformationsContextReused();
+        void transformationsThreaded();
         void setClean();
         void setCleanListHierarchy();
         void setCleanListBulk();
+        void setDirtyDeep();
+        void setAllClean();
+        void setAllCleanQueue();
+        void setAllCleanQueueMoveSubtree();
+        void setAllCleanPartiallyCleaned();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
@@ -69,13 +85,27 @@ ObjectTest::ObjectTest() {
               &ObjectTest::scene,
               &ObjectTest::setParentKeepTransformation,
               &ObjectTest::absoluteTransformation,
+              &ObjectTest::absoluteTransformationCached,
+              &ObjectTest::absoluteTransformationCachedDeep,
               &ObjectTest::transformations,
               &ObjectTest::transformationsRelative,
+              &ObjectTest::transformationsRelativeSubtree,
+              &ObjectTest::transformationsRelativeAncestor,
+              &ObjectTest::transformationsRelativeThreaded,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsLargeScene,
+              &ObjectTest::transformationsContext,
+              &ObjectTest::transformationsContextReused,
+              &ObjectTest::transformationsThreaded,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
-              &ObjectTest::setCleanListBulk});
+              &ObjectTest::setCleanListBulk,
+              &ObjectTest::setDirtyDeep,
+              &ObjectTest::setAllClean,
+              &ObjectTest::setAllCleanQueue,
+              &ObjectTest::setAllCleanQueueMoveSubtree,
+              &ObjectTest::setAllCleanPartiallyCleaned});
 }
 
 void ObjectTest::parenting() {
@@ -167,6 +197,65 @@ void ObjectTest::absoluteTransformation() {
     CORRADE_COMPARE(o3.absoluteTransformation(), Matrix4::translation({1.0f, 2.0f, 3.0f}));
 }
 
+void ObjectTest::absoluteTransformationCached() {
+    Scene3D s;
+    Object3D a(&s);
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D b(&a);
+    b.translate(Vector3::yAxis(1.0f));
+    Object3D c(&b);
+    c.translate(Vector3::zAxis(1.0f));
+
+    /* Repeated query gives the same result */
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(b.absoluteTransformation(), Matrix4::translation({1.0f, 1.0f, 0.0f}));
+
+    /* Changing transformation of already dirty parent invalidates the cache */
+    CORRADE_VERIFY(a.isDirty());
+    a.translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({2.0f, 1.0f, 1.0f}));
+    b.translate(Vector3::yAxis(1.0f));
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({2.0f, 2.0f, 1.0f}));
+    CORRADE_COMPARE(a.absoluteTransformation(), Matrix4::translation({2.0f, 0.0f, 0.0f}));
+
+    /* Cleaned objects have the transformation cached */
+    c.setClean();
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({2.0f, 2.0f, 1.0f}));
+    a.translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(b.absoluteTransformation(), Matrix4::translation({3.0f, 2.0f, 0.0f}));
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({3.0f, 2.0f, 1.0f}));
+
+    /* New child of object with cached transformation */
+    Object3D d(&c);
+    d.translate(Vector3::zAxis(1.0f));
+    CORRADE_COMPARE(d.absoluteTransformation(), Matrix4::translation({3.0f, 2.0f, 2.0f}));
+
+    /* Reparenting */
+    c.setParent(&a);
+    CORRADE_COMPARE(c.absoluteTransformation(), Matrix4::translation({3.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(d.absoluteTransformation(), Matrix4::translation({3.0f, 0.0f, 2.0f}));
+}
+
+void ObjectTest::absoluteTransformationCachedDeep() {
+    /* Chain deeper than what is collected in one walk up */
+    Scene3D s;
+    std::vector<Object3D*> chain{&s};
+    for(std::size_t i = 0; i != 100; ++i) {
+        chain.push_back(new Object3D(chain.back()));
+        chain.back()->translate(Vector3::xAxis(1.0f));
+    }
+
+    CORRADE_COMPARE(chain[100]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(100.0f)));
+    CORRADE_COMPARE(chain[50]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(50.0f)));
+    CORRADE_COMPARE(chain[1]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    chain[10]->translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(chain[100]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(101.0f)));
+    CORRADE_COMPARE(chain[9]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(9.0f)));
+    CORRADE_COMPARE(chain[60]->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(61.0f)));
+}
+
 void ObjectTest::transformations() {
     Scene3D s;
 
@@ -210,8 +299,6 @@ void ObjectTest::transformations() {
 }
 
 void ObjectTest::transformationsRelative() {
-    CORRADE_EXPECT_FAIL("Transformations not relative to scene are not yet implemented.");
-
     Scene3D s;
     Object3D first(&s);
     first.rotateZ(Deg(30.0f));
@@ -238,6 +325,97 @@ void ObjectTest::transformationsRelative() {
     });
 }
 
+void ObjectTest::transformationsRelativeSubtree() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D root(&first);
+    root.translate(Vector3::yAxis(3.0f));
+    Object3D second(&root);
+    second.scale(Vector3(0.5f));
+    Object3D third(&second);
+    third.translate(Vector3::xAxis(5.0f));
+    Object3D fourth(&root);
+    fourth.rotateX(Deg(15.0f));
+
+    /* Transformations relative to subtree root, the part above is ignored */
+    const Matrix4 initial = Matrix4::translation(Vector3::zAxis(-1.0f));
+    const std::vector<Matrix4> expected{
+        initial*Matrix4::scaling(Vector3(0.5f))*Matrix4::translation(Vector3::xAxis(5.0f)),
+        initial*Matrix4::rotationX(Deg(15.0f)),
+        initial*Matrix4::scaling(Vector3(0.5f))
+    };
+    CORRADE_COMPARE(root.transformationMatrices({&third, &fourth, &second}, initial), expected);
+
+    /* The root itself */
+    CORRADE_COMPARE(root.transformationMatrices({&root, &second}), (std::vector<Matrix4>{
+        Matrix4(),
+        Matrix4::scaling(Vector3(0.5f))
+    }));
+
+    /* All marks were cleaned up, the scene gives the same result afterwards */
+    CORRADE_COMPARE(root.transformationMatrices({&third, &fourth, &second}, initial), expected);
+    CORRADE_COMPARE(s.transformationMatrices({&third}), std::vector<Matrix4>{
+        Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::yAxis(3.0f))*Matrix4::scaling(Vector3(0.5f))*Matrix4::translation(Vector3::xAxis(5.0f))
+    });
+}
+
+void ObjectTest::transformationsRelativeAncestor() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.translate(Vector3::xAxis(2.0f));
+    Object3D third(&second);
+    third.scale(Vector3(0.5f));
+    Object3D fourth(&first);
+    fourth.translate(Vector3::yAxis(5.0f));
+
+    /* Objects above and next to this object, this object itself and
+       duplicates */
+    const Matrix4 inverse = (Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::scaling(Vector3(0.5f))).inverted();
+    CORRADE_COMPARE(third.transformationMatrices({&first, &fourth, &third, &s, &fourth}), (std::vector<Matrix4>{
+        inverse,
+        inverse*Matrix4::translation(Vector3::yAxis(5.0f)),
+        Matrix4(),
+        inverse*Matrix4::rotationZ(Deg(30.0f)).inverted(),
+        inverse*Matrix4::translation(Vector3::yAxis(5.0f))
+    }));
+
+    /* Marks are properly cleaned */
+    CORRADE_COMPARE(s.transformationMatrices({&third, &fourth}), (std::vector<Matrix4>{
+        Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::scaling(Vector3(0.5f)),
+        Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::yAxis(5.0f))
+    }));
+}
+
+void ObjectTest::transformationsRelativeThreaded() {
+    /* Deep chain with many leaves in various depths, relative to object in the
+       middle of the chain */
+    Scene3D s;
+    std::vector<Object3D*> chain{new Object3D(&s)};
+    std::vector<Object3D*> leaves;
+    for(Int i = 0; i != 3000; ++i) {
+        chain.push_back(new Object3D(chain.back()));
+        chain.back()->translate(Vector3::xAxis(1.0f));
+        if(i % 3 == 0) {
+            leaves.push_back(new Object3D(chain.back()));
+            leaves.back()->rotateY(Deg(Float(i%7)*15.0f));
+        }
+    }
+
+    Object3D& reference = *chain[1000];
+    const std::vector<Matrix4> expected = reference.transformationMatrices(leaves);
+    const Matrix4 inverse = reference.absoluteTransformationMatrix().inverted();
+    for(std::size_t i = 0; i != leaves.size(); i += 100)
+        CORRADE_COMPARE(expected[i], inverse*leaves[i]->absoluteTransformationMatrix());
+
+    CORRADE_COMPARE(reference.transformationMatrices(leaves, {}, 4), expected);
+
+    TransformationContext<MatrixTransformation3D> context;
+    CORRADE_COMPARE(reference.transformationMatrices(leaves, context), expected);
+}
+
 void ObjectTest::transformationsOrphan() {
     std::ostringstream o;
     Error::setOutput(&o);
@@ -247,6 +425,13 @@ void ObjectTest::transformationsOrphan() {
     Object3D orphan;
     CORRADE_COMPARE(s.transformations({&orphan}), std::vector<Matrix4>());
     CORRADE_COMPARE(o.str(), "SceneGraph::Object::transformations(): the objects are not part of the same tree\n");
+
+    /* Relative to an object in another tree */
+    o.str({});
+    Scene3D s2, s3;
+    Object3D a(&s2), b(&s3);
+    CORRADE_COMPARE(a.transformations({&b}), std::vector<Matrix4>());
+    CORRADE_COMPARE(o.str(), "SceneGraph::Object::transformations(): the objects are not part of the same tree\n");
 }
 
 void ObjectTest::transformationsDuplicate() {
@@ -266,6 +451,112 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsLargeScene() {
+    Scene3D s;
+
+    /* More objects than fit into 16-bit joint index, each group of ten
+       children has common parent which becomes a joint */
+    std::vector<Object3D*> objects;
+    for(std::size_t i = 0; i != 7000; ++i) {
+        Object3D* parent = new Object3D(&s);
+        parent->translate(Vector3::xAxis(Float(i)));
+        for(std::size_t j = 0; j != 10; ++j) {
+            Object3D* child = new Object3D(parent);
+            child->translate(Vector3::yAxis(Float(j)));
+            objects.push_back(child);
+        }
+    }
+
+    std::vector<Matrix4> transformations = s.transformations(objects);
+    CORRADE_COMPARE(transformations.size(), 70000);
+    CORRADE_COMPARE(transformations[0], Matrix4());
+    CORRADE_COMPARE(transformations[65537], Matrix4::translation({6553.0f, 7.0f, 0.0f}));
+    CORRADE_COMPARE(transformations[69999], Matrix4::translation({6999.0f, 9.0f, 0.0f}));
+}
+
+void ObjectTest::transformationsContext() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+    Object3D fourth(&third);
+    fourth.translate(Vector3::yAxis(1.0f));
+    Object3D fifth(&s);
+    fifth.rotateX(Deg(15.0f));
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+    const std::vector<Object3D*> objects{&fourth, &second, &s, &fifth, &fourth, &first, &third};
+
+    /* The output should be the same as with in-place marks */
+    TransformationContext<MatrixTransformation3D> context;
+    CORRADE_COMPARE(s.transformations(objects, context, initial), s.transformations(objects, initial));
+    CORRADE_COMPARE(s.transformationMatrices(objects, context, initial), s.transformationMatrices(objects, initial));
+    CORRADE_COMPARE(s.transformations(std::vector<Object3D*>{}, context), std::vector<Matrix4>{});
+}
+
+void ObjectTest::transformationsContextReused() {
+    Scene3D s;
+    std::vector<Object3D*> objects;
+    for(std::size_t i = 0; i != 100; ++i) {
+        Object3D* o = new Object3D(i < 2 ? static_cast<Object3D*>(&s) : objects[i/2 - 1]);
+        o->translate(Vector3::xAxis(Float(i)));
+        objects.push_back(o);
+    }
+
+    /* Reusing the context for different object sets gives the same results
+       as fresh computation */
+    TransformationContext<MatrixTransformation3D> context;
+    for(std::size_t i = 1; i < objects.size(); i += 7) {
+        std::vector<Object3D*> subset(objects.begin(), objects.begin() + i);
+        std::reverse(subset.begin(), subset.end());
+        CORRADE_COMPARE(s.transformations(subset, context), s.transformations(subset));
+    }
+}
+
+void ObjectTest::transformationsThreaded() {
+    Scene3D s;
+
+    /* Wide and deep parts of the hierarchy, with enough joints to be split
+       into more chunks */
+    std::vector<Object3D*> objects;
+    for(std::size_t i = 0; i != 50; ++i) {
+        Object3D* parent = new Object3D(&s);
+        parent->rotateZ(Deg(Float(i)));
+        for(std::size_t j = 0; j != 100; ++j) {
+            Object3D* o = new Object3D(parent);
+            o->translate(Vector3::xAxis(Float(j)));
+            objects.push_back(o);
+        }
+
+        Object3D* chain = parent;
+        for(std::size_t j = 0; j != 50; ++j) {
+            chain = new Object3D(chain);
+            chain->translate(Vector3::yAxis(0.1f));
+            if(j % 5 == 0) objects.push_back(chain);
+        }
+    }
+
+    /* Duplicates and the scene itself */
+    objects.push_back(objects[17]);
+    objects.push_back(&s);
+
+    const Matrix4 initial = Matrix4::rotationX(Deg(90.0f));
+    const std::vector<Matrix4> expected = s.transformations(objects, initial);
+    CORRADE_COMPARE(s.transformations(objects, initial, 4), expected);
+    CORRADE_COMPARE(s.transformationMatrices(objects, initial, 3), expected);
+
+    /* Marks are cleaned properly after the threaded version */
+    CORRADE_COMPARE(s.transformations(objects, initial), expected);
+
+    std::ostringstream out;
+    Error::setOutput(&out);
+    s.transformations(objects, initial, 0);
+    CORRADE_COMPARE(out.str(), "SceneGraph::Object::transformations(): thread count must be at least one\n");
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -445,6 +736,230 @@ void ObjectTest::setCleanListBulk() {
 
     /* Verify that right transformation was passed */
     CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
+
+    /* Objects with common dirty parent, the parent is cleaned only once */
+    c.translate(Vector3::zAxis(1.0f));
+    CachingObject f(&c);
+    f.translate(Vector3::xAxis(1.0f));
+    Object3D::setClean({&d, &f, &c});
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(!d.isDirty());
+    CORRADE_VERIFY(!f.isDirty());
+    CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(4.0f))*Matrix4::scaling(Vector3(-2.0f)));
+    CORRADE_COMPARE(f.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 0.0f, 4.0f}));
+
+    /* Objects which are not part of any scene */
+    CachingObject g;
+    g.translate(Vector3::yAxis(2.0f));
+    CachingObject h(&g);
+    h.translate(Vector3::yAxis(1.0f));
+    Object3D::setClean({&h});
+    CORRADE_VERIFY(!g.isDirty());
+    CORRADE_VERIFY(!h.isDirty());
+    CORRADE_COMPARE(h.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::yAxis(3.0f)));
+}
+
+void ObjectTest::setDirtyDeep() {
+    Scene3D scene;
+
+    /* Deep hierarchy with a branch at each level */
+    Object3D* o = &scene;
+    for(std::size_t i = 0; i != 10000; ++i) {
+        new Object3D(o);
+        o = new Object3D(o);
+        o->translate(Vector3::xAxis(1.0f));
+    }
+    CachingObject* leaf = new CachingObject(o);
+
+    leaf->setClean();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!o->isDirty());
+    CORRADE_COMPARE(leaf->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(10000.0f)));
+
+    /* Mark whole scene dirty */
+    scene.lastChild()->setDirty();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(o->isDirty());
+    CORRADE_VERIFY(o->parent()->firstChild()->isDirty());
+    CORRADE_VERIFY(leaf->isDirty());
+
+    /* Clean everything again */
+    o->parent()->translate(Vector3::xAxis(1.0f));
+    leaf->setClean();
+    CORRADE_VERIFY(!o->isDirty());
+    CORRADE_VERIFY(!leaf->isDirty());
+    CORRADE_COMPARE(leaf->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(10001.0f)));
+}
+
+void ObjectTest::setAllClean() {
+    Scene3D scene;
+    CachingObject a(&scene);
+    a.translate(Vector3::xAxis(1.0f));
+    CachingObject b(&a);
+    b.translate(Vector3::yAxis(1.0f));
+    CachingObject c(&scene);
+    c.translate(Vector3::zAxis(1.0f));
+
+    /* Everything is dirty at the beginning */
+    scene.setAllClean();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(a.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::translation({0.0f, 0.0f, 1.0f}));
+
+    /* Only changed objects are cleaned */
+    a.cleanedAbsoluteTransformation = c.cleanedAbsoluteTransformation = Matrix4(Matrix4::Zero);
+    b.translate(Vector3::yAxis(1.0f));
+    scene.setAllClean();
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(a.cleanedAbsoluteTransformation, Matrix4(Matrix4::Zero));
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 2.0f, 0.0f}));
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4(Matrix4::Zero));
+
+    /* Child queued before its parent */
+    b.translate(Vector3::yAxis(1.0f));
+    a.translate(Vector3::xAxis(1.0f));
+    scene.setAllClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(a.cleanedAbsoluteTransformation, Matrix4::translation({2.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation({2.0f, 3.0f, 0.0f}));
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4(Matrix4::Zero));
+
+    /* Objects cleaned explicitly are not cleaned again */
+    c.translate(Vector3::zAxis(1.0f));
+    c.setClean();
+    c.cleanedAbsoluteTransformation = Matrix4(Matrix4::Zero);
+    scene.setAllClean();
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4(Matrix4::Zero));
+}
+
+void ObjectTest::setAllCleanQueue() {
+    Scene3D scene;
+    CachingObject a(&scene);
+    scene.setAllClean();
+
+    /* Deleted object is removed from the queue */
+    CachingObject* b = new CachingObject(&a);
+    CORRADE_VERIFY(b->isDirty());
+    delete b;
+    scene.setAllClean();
+
+    /* Subtree added to the scene is queued */
+    CachingObject* c = new CachingObject;
+    c->translate(Vector3::yAxis(1.0f));
+    CachingObject* d = new CachingObject(c);
+    d->translate(Vector3::yAxis(1.0f));
+    c->setParent(&a);
+    scene.setAllClean();
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_VERIFY(!d->isDirty());
+    CORRADE_COMPARE(d->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::yAxis(2.0f)));
+
+    /* Subtree removed from the scene is not cleaned anymore */
+    d->translate(Vector3::yAxis(1.0f));
+    c->setParent(nullptr);
+    scene.setAllClean();
+    CORRADE_VERIFY(c->isDirty());
+    CORRADE_VERIFY(d->isDirty());
+    delete c;
+
+    /* Moving object to another scene removes it from the queue of the
+       original one */
+    {
+        Scene3D another;
+        CachingObject* e = new CachingObject(&a);
+        e->translate(Vector3::zAxis(1.0f));
+        e->setParent(&another);
+        scene.setAllClean();
+        CORRADE_VERIFY(e->isDirty());
+        another.setAllClean();
+        CORRADE_VERIFY(!e->isDirty());
+        CORRADE_COMPARE(e->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(1.0f)));
+
+        /* Scene is destroyed with objects still in the queue */
+        another.setAllClean();
+        e->translate(Vector3::zAxis(1.0f));
+        new CachingObject(e);
+    }
+}
+
+void ObjectTest::setAllCleanQueueMoveSubtree() {
+    Scene3D a, b;
+    CachingObject* p = new CachingObject(&a);
+    CachingObject* c = new CachingObject(p);
+    c->translate(Vector3::xAxis(1.0f));
+    a.setAllClean();
+
+    /* Dirty child is queued in the original scene */
+    c->translate(Vector3::xAxis(1.0f));
+    CORRADE_VERIFY(c->isDirty());
+
+    /* Moving the parent to another scene removes the child from the original
+       queue, so it is queued in the new scene when dirtied again */
+    p->setParent(&b);
+    b.setAllClean();
+    CORRADE_VERIFY(!p->isDirty());
+    CORRADE_VERIFY(!c->isDirty());
+
+    c->translate(Vector3::xAxis(1.0f));
+    b.setAllClean();
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_COMPARE(c->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(3.0f)));
+
+    /* The original scene doesn't touch objects it doesn't own anymore */
+    c->translate(Vector3::xAxis(1.0f));
+    c->cleanedAbsoluteTransformation = Matrix4(Matrix4::Zero);
+    a.setAllClean();
+    CORRADE_VERIFY(c->isDirty());
+    CORRADE_COMPARE(c->cleanedAbsoluteTransformation, Matrix4(Matrix4::Zero));
+    b.setAllClean();
+    CORRADE_VERIFY(!c->isDirty());
+
+    delete p;
+}
+
+void ObjectTest::setAllCleanPartiallyCleaned() {
+    Scene3D scene;
+    CachingObject p(&scene);
+    CachingObject a(&p);
+    CachingObject b(&p);
+    b.translate(Vector3::yAxis(1.0f));
+    CachingObject c(&b);
+    c.translate(Vector3::zAxis(1.0f));
+    scene.setAllClean();
+
+    /* Only the parent is queued, one child is cleaned separately together
+       with the parent */
+    p.translate(Vector3::xAxis(1.0f));
+    a.setClean();
+    CORRADE_VERIFY(!p.isDirty());
+    CORRADE_VERIFY(b.isDirty());
+
+    /* The other children are cleaned too */
+    scene.setAllClean();
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 1.0f, 1.0f}));
+
+    /* And they are properly queued again when changed */
+    b.translate(Vector3::yAxis(1.0f));
+    scene.setAllClean();
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 2.0f, 1.0f}));
+
+    /* Same when cleaned through a list */
+    p.translate(Vector3::xAxis(1.0f));
+    Object3D::setClean(std::vector<Object3D*>{&a});
+    CORRADE_VERIFY(!p.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+    scene.setAllClean();
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::translation({2.0f, 2.0f, 1.0f}));
 }
 
 }}}
@@ -0,0 +1,312 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "SceneGraph/AbstractFeature.h"
+#include "SceneGraph/AbstractGroupedFeature.h"
+#include "SceneGraph/Animable.h"
+#include "SceneGraph/AnimableGroup.h"
+#include "SceneGraph/Camera3D.h"
+#include "SceneGraph/Drawable.h"
+#include "SceneGraph/DualQuaternionTransformation.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/RigidMatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+/*
+Common scene graph workloads, each run for all 3D transformation
+implementations to catch regressions in any of them. Specialized benchmarks
+(object pool, bounding volume hierarchy, tracks...) are in separate files.
+*/
+class SceneGraphBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        SceneGraphBenchmark();
+
+        template<class Transformation> void transformationsWide();
+        template<class Transformation> void transformationsDeep();
+        template<class Transformation> void transformationsRandom();
+        template<class Transformation> void dirtyClean();
+        template<class Transformation> void draw();
+        template<class Transformation> void featureGroupChurn();
+        template<class Transformation> void animableStep();
+
+    private:
+        template<class Transformation> void transformations(const std::string& name, Scene<Transformation>& scene, const std::vector<Object<Transformation>*>& objects);
+};
+
+namespace {
+    template<class> struct TransformationName;
+    template<> struct TransformationName<MatrixTransformation3D> {
+        constexpr static const char* name() { return "MatrixTransformation3D"; }
+    };
+    template<> struct TransformationName<RigidMatrixTransformation3D> {
+        constexpr static const char* name() { return "RigidMatrixTransformation3D"; }
+    };
+    template<> struct TransformationName<DualQuaternionTransformation> {
+        constexpr static const char* name() { return "DualQuaternionTransformation"; }
+    };
+
+    /* Simple deterministic generator, so the random trees are the same on
+       every run and every platform */
+    class Random {
+        public:
+            explicit Random(): _state(1) {}
+
+            UnsignedInt operator()() {
+                _state = _state*1103515245u + 12345u;
+                return _state >> 8;
+            }
+
+        private:
+            UnsignedInt _state;
+    };
+
+    template<class Transformation> void setupObject(Object<Transformation>& object, std::size_t i) {
+        object.rotateY(Deg(Float(i % 360)))
+            .translate(Vector3::xAxis(Float(i % 17)));
+    }
+
+    /* 10k children of the scene */
+    template<class Transformation> void populateWide(Scene<Transformation>& scene, std::vector<Object<Transformation>*>& objects) {
+        objects.reserve(10000);
+        for(std::size_t i = 0; i != 10000; ++i) {
+            objects.push_back(new Object<Transformation>(&scene));
+            setupObject(*objects.back(), i);
+        }
+    }
+
+    /* 100 chains, each 100 objects long */
+    template<class Transformation> void populateDeep(Scene<Transformation>& scene, std::vector<Object<Transformation>*>& objects) {
+        objects.reserve(10000);
+        for(std::size_t i = 0; i != 100; ++i) {
+            Object<Transformation>* parent = &scene;
+            for(std::size_t j = 0; j != 100; ++j) {
+                objects.push_back(parent = new Object<Transformation>(parent));
+                setupObject(*parent, i*100 + j);
+            }
+        }
+    }
+
+    /* 10k objects, each attached to random previously created object or
+       the scene */
+    template<class Transformation> void populateRandom(Scene<Transformation>& scene, std::vector<Object<Transformation>*>& objects) {
+        Random random;
+        objects.reserve(10000);
+        for(std::size_t i = 0; i != 10000; ++i) {
+            const std::size_t parent = random() % (objects.size() + 1);
+            objects.push_back(new Object<Transformation>(parent == objects.size() ? &scene : objects[parent]));
+            setupObject(*objects.back(), i);
+        }
+    }
+
+    class CachingFeature: public AbstractFeature3D {
+        public:
+            explicit CachingFeature(AbstractObject3D& object): AbstractFeature3D(object) {
+                setCachedTransformations(CachedTransformation::Absolute);
+            }
+
+            Matrix4 absoluteTransformation;
+
+        protected:
+            void clean(const Matrix4& absoluteTransformation) override {
+                this->absoluteTransformation = absoluteTransformation;
+            }
+    };
+
+    class NoOpDrawable: public Drawable3D {
+        public:
+            explicit NoOpDrawable(AbstractObject3D& object, DrawableGroup3D* group): Drawable3D(object, group) {}
+
+            static std::size_t drawCount;
+
+        protected:
+            void draw(const Matrix4&, AbstractCamera3D&) override { ++drawCount; }
+    };
+
+    std::size_t NoOpDrawable::drawCount = 0;
+
+    class Feature: public AbstractGroupedFeature3D<Feature> {
+        public:
+            explicit Feature(AbstractObject3D& object, FeatureGroup3D<Feature>* group): AbstractGroupedFeature3D<Feature>(object, group) {}
+    };
+
+    template<class Transformation> class RotatingAnimable: public Animable3D {
+        public:
+            explicit RotatingAnimable(Object<Transformation>& object, AnimableGroup3D* group): Animable3D(object, group), _object(object) {}
+
+        protected:
+            void animationStep(Float, Float delta) override {
+                _object.rotateY(Deg(90.0f*delta));
+            }
+
+        private:
+            Object<Transformation>& _object;
+    };
+}
+
+SceneGraphBenchmark::SceneGraphBenchmark() {
+    addTests<SceneGraphBenchmark>({&SceneGraphBenchmark::transformationsWide<MatrixTransformation3D>,
+                                   &SceneGraphBenchmark::transformationsWide<RigidMatrixTransformation3D>,
+                                   &SceneGraphBenchmark::transformationsWide<DualQuaternionTransformation>,
+                                   &SceneGraphBenchmark::transformationsDeep<MatrixTransformation3D>,
+                                   &SceneGraphBenchmark::transformationsDeep<RigidMatrixTransformation3D>,
+                                   &SceneGraphBenchmark::transformationsDeep<DualQuaternionTransformation>,
+                                   &SceneGraphBenchmark::transformationsRandom<MatrixTransformation3D>,
+                                   &SceneGraphBenchmark::transformationsRandom<RigidMatrixTransformation3D>,
+                                   &SceneGraphBenchmark::transformationsRandom<DualQuaternionTransformation>,
+                                   &SceneGraphBenchmark::dirtyClean<MatrixTransformation3D>,
+                                   &SceneGraphBenchmark::dirtyClean<RigidMatrixTransformation3D>,
+                                   &SceneGraphBenchmark::dirtyClean<DualQuaternionTransformation>,
+                                   &SceneGraphBenchmark::draw<MatrixTransformation3D>,
+                                   &SceneGraphBenchmark::draw<RigidMatrixTransformation3D>,
+                                   &SceneGraphBenchmark::draw<DualQuaternionTransformation>,
+                                   &SceneGraphBenchmark::featureGroupChurn<MatrixTransformation3D>,
+                                   &SceneGraphBenchmark::featureGroupChurn<RigidMatrixTransformation3D>,
+                                   &SceneGraphBenchmark::featureGroupChurn<DualQuaternionTransformation>,
+                                   &SceneGraphBenchmark::animableStep<MatrixTransformation3D>,
+                                   &SceneGraphBenchmark::animableStep<RigidMatrixTransformation3D>,
+                                   &SceneGraphBenchmark::animableStep<DualQuaternionTransformation>});
+}
+
+template<class Transformation> void SceneGraphBenchmark::transformations(const std::string& name, Scene<Transformation>& scene, const std::vector<Object<Transformation>*>& objects) {
+    std::vector<typename Transformation::DataType> transformations;
+    benchmark(std::string(TransformationName<Transformation>::name()) + ": transformations() of 10k objects, " + name, 20, [&]() {
+        transformations = scene.transformations(objects);
+    });
+
+    CORRADE_COMPARE(transformations.size(), objects.size());
+    CORRADE_COMPARE(transformations.back(), objects.back()->absoluteTransformation());
+}
+
+template<class Transformation> void SceneGraphBenchmark::transformationsWide() {
+    Scene<Transformation> scene;
+    std::vector<Object<Transformation>*> objects;
+    populateWide(scene, objects);
+    transformations("wide tree", scene, objects);
+}
+
+template<class Transformation> void SceneGraphBenchmark::transformationsDeep() {
+    Scene<Transformation> scene;
+    std::vector<Object<Transformation>*> objects;
+    populateDeep(scene, objects);
+    transformations("deep tree", scene, objects);
+}
+
+template<class Transformation> void SceneGraphBenchmark::transformationsRandom() {
+    Scene<Transformation> scene;
+    std::vector<Object<Transformation>*> objects;
+    populateRandom(scene, objects);
+    transformations("random tree", scene, objects);
+}
+
+template<class Transformation> void SceneGraphBenchmark::dirtyClean() {
+    Scene<Transformation> scene;
+    std::vector<Object<Transformation>*> objects;
+    populateRandom(scene, objects);
+
+    std::vector<CachingFeature*> features;
+    features.reserve(objects.size());
+    for(Object<Transformation>* o: objects) features.push_back(new CachingFeature(*o));
+    scene.setAllClean();
+
+    /* Each frame moves 1% of the objects (with their subtrees) and cleans
+       the scene */
+    Random random;
+    benchmark(std::string(TransformationName<Transformation>::name()) + ": moving 1% of 10k objects in random tree and cleaning", 20, [&]() {
+        for(std::size_t i = 0; i != objects.size()/100; ++i)
+            objects[random() % objects.size()]->translate(Vector3::yAxis(0.1f));
+        scene.setAllClean();
+    });
+
+    for(Object<Transformation>* o: objects) CORRADE_VERIFY(!o->isDirty());
+    CORRADE_COMPARE(features.back()->absoluteTransformation, objects.back()->absoluteTransformationMatrix());
+}
+
+template<class Transformation> void SceneGraphBenchmark::draw() {
+    Scene<Transformation> scene;
+    std::vector<Object<Transformation>*> objects;
+    populateRandom(scene, objects);
+
+    DrawableGroup3D group;
+    for(Object<Transformation>* o: objects) new NoOpDrawable(*o, &group);
+
+    Object<Transformation>* cameraObject = new Object<Transformation>(&scene);
+    cameraObject->translate(Vector3::zAxis(10.0f));
+    Camera3D camera(*cameraObject);
+
+    NoOpDrawable::drawCount = 0;
+    benchmark(std::string(TransformationName<Transformation>::name()) + ": drawing 10k no-op drawables in random tree", 20, [&]() {
+        camera.draw(group);
+    });
+
+    /* Warm-up run and the measured ones */
+    CORRADE_COMPARE(NoOpDrawable::drawCount, 21*objects.size());
+}
+
+template<class Transformation> void SceneGraphBenchmark::featureGroupChurn() {
+    Scene<Transformation> scene;
+    std::vector<Object<Transformation>*> objects;
+    populateRandom(scene, objects);
+
+    /* Each frame a feature is added to every object and then all of them are
+       destroyed in the order of creation */
+    FeatureGroup3D<Feature> group;
+    std::vector<Feature*> features(objects.size());
+    std::size_t maxSize = 0;
+    benchmark(std::string(TransformationName<Transformation>::name()) + ": spawning and destroying 10k grouped features", 20, [&]() {
+        for(std::size_t i = 0; i != objects.size(); ++i)
+            features[i] = new Feature(*objects[i], &group);
+        maxSize = group.size();
+        for(Feature* feature: features) delete feature;
+    });
+
+    CORRADE_COMPARE(maxSize, objects.size());
+    CORRADE_VERIFY(group.isEmpty());
+}
+
+template<class Transformation> void SceneGraphBenchmark::animableStep() {
+    Scene<Transformation> scene;
+    std::vector<Object<Transformation>*> objects;
+    populateRandom(scene, objects);
+
+    AnimableGroup3D group;
+    for(Object<Transformation>* o: objects)
+        (new RotatingAnimable<Transformation>(*o, &group))->setState(AnimationState::Running);
+
+    Float time = 0.0f;
+    group.step(time, 0.0f);
+    benchmark(std::string(TransformationName<Transformation>::name()) + ": stepping 10k animables rotating objects in random tree", 20, [&]() {
+        time += 1.0f/60.0f;
+        group.step(time, 1.0f/60.0f);
+        scene.setAllClean();
+    });
+
+    CORRADE_COMPARE(group.runningCount(), objects.size());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SceneGraphBenchmark)
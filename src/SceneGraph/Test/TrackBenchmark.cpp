@@ -0,0 +1,126 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Test/AbstractBenchmarkTester.h"
+#include "Math/Angle.h"
+#include "SceneGraph/AnimableGroup.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/TrackPlayer.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class TrackBenchmark: public Magnum::Test::AbstractBenchmarkTester {
+    public:
+        TrackBenchmark();
+
+        void binarySearch();
+        void cursor();
+        void player();
+
+    private:
+        std::vector<Track<Vector3>> translations;
+        std::vector<Track<Quaternion>> rotations;
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef Math::Deg<Float> Deg;
+
+namespace {
+    /* 1000 joints with translation and rotation track, 300 keyframes each */
+    constexpr std::size_t JointCount = 1000;
+    constexpr std::size_t KeyframeCount = 300;
+    constexpr Float FrameDuration = 1.0f/60.0f;
+}
+
+TrackBenchmark::TrackBenchmark(): translations(JointCount), rotations(JointCount, Track<Quaternion>(TrackInterpolation::Spherical)) {
+    addTests({&TrackBenchmark::binarySearch,
+              &TrackBenchmark::cursor,
+              &TrackBenchmark::player});
+
+    for(std::size_t i = 0; i != JointCount; ++i) {
+        for(std::size_t j = 0; j != KeyframeCount; ++j) {
+            const Float time = j/30.0f;
+            translations[i].add(time, Vector3(Float(i), Float(j), 0.0f));
+            rotations[i].add(time, Quaternion::rotation(Deg(Float(i + j)), Vector3::yAxis()));
+        }
+    }
+}
+
+void TrackBenchmark::binarySearch() {
+    std::vector<Vector3> translationValues(JointCount);
+    std::vector<Quaternion> rotationValues(JointCount);
+
+    Float time = 0.0f;
+    benchmark("playing 1000 joints using binary search", 600, [&]() {
+        for(std::size_t i = 0; i != JointCount; ++i) {
+            translationValues[i] = translations[i].at(time);
+            rotationValues[i] = rotations[i].at(time);
+        }
+        time += FrameDuration;
+    });
+
+    CORRADE_COMPARE(translationValues[3], Vector3(3.0f, 299.0f, 0.0f));
+}
+
+void TrackBenchmark::cursor() {
+    std::vector<Vector3> translationValues(JointCount);
+    std::vector<Quaternion> rotationValues(JointCount);
+    std::vector<std::size_t> translationCursors(JointCount), rotationCursors(JointCount);
+
+    Float time = 0.0f;
+    benchmark("playing 1000 joints using cursor", 600, [&]() {
+        for(std::size_t i = 0; i != JointCount; ++i) {
+            translationValues[i] = translations[i].at(time, translationCursors[i]);
+            rotationValues[i] = rotations[i].at(time, rotationCursors[i]);
+        }
+        time += FrameDuration;
+    });
+
+    CORRADE_COMPARE(translationValues[3], Vector3(3.0f, 299.0f, 0.0f));
+}
+
+void TrackBenchmark::player() {
+    Object3D object;
+    AnimableGroup3D group;
+    TrackPlayer3D player(object, &group);
+    std::vector<Vector3> translationValues(JointCount);
+    std::vector<Quaternion> rotationValues(JointCount);
+    for(std::size_t i = 0; i != JointCount; ++i)
+        player.add(translations[i], translationValues[i])
+              .add(rotations[i], rotationValues[i]);
+    player.setState(AnimationState::Running);
+
+    Float time = 0.0f;
+    group.step(time, 0.0f);
+    benchmark("playing 1000 joints using TrackPlayer", 590, [&]() {
+        time += FrameDuration;
+        group.step(time, FrameDuration);
+    });
+
+    CORRADE_COMPARE(translationValues[3].x(), 3.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TrackBenchmark)
@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Angle.h"
+#include "SceneGraph/AnimableGroup.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/TrackPlayer.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class TrackPlayerTest: public TestSuite::Tester {
+    public:
+        TrackPlayerTest();
+
+        void play();
+        void addEmpty();
+        void override();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef Math::Deg<Float> Deg;
+
+TrackPlayerTest::TrackPlayerTest() {
+    addTests({&TrackPlayerTest::play,
+              &TrackPlayerTest::addEmpty,
+              &TrackPlayerTest::override});
+}
+
+void TrackPlayerTest::play() {
+    Object3D object;
+    AnimableGroup3D group;
+    TrackPlayer3D player(object, &group);
+    CORRADE_COMPARE(player.size(), 0);
+
+    Track<Vector3> translation({0.0f, 2.0f}, {Vector3(), Vector3(2.0f, 0.0f, 0.0f)});
+    Track<Quaternion> rotation({0.0f, 4.0f}, {Quaternion(), Quaternion::rotation(Deg(90.0f), Vector3::yAxis())}, TrackInterpolation::Spherical);
+    Track<DualQuaternion> transformation({1.0f, 3.0f}, {DualQuaternion(), DualQuaternion::translation(Vector3::zAxis(2.0f))}, TrackInterpolation::Constant);
+
+    Vector3 translationValue;
+    Quaternion rotationValue;
+    DualQuaternion transformationValue;
+    player.add(translation, translationValue)
+          .add(rotation, rotationValue)
+          .add(transformation, transformationValue);
+    CORRADE_COMPARE(player.size(), 3);
+
+    /* Duration is the longest track */
+    CORRADE_COMPARE(player.duration(), 4.0f);
+
+    player.setState(AnimationState::Running);
+    group.step(10.0f, 0.0f);
+    group.step(11.0f, 1.0f);
+    CORRADE_COMPARE(translationValue, Vector3(1.0f, 0.0f, 0.0f));
+    CORRADE_COMPARE(rotationValue, Quaternion::rotation(Deg(22.5f), Vector3::yAxis()));
+    CORRADE_COMPARE(transformationValue, DualQuaternion());
+
+    group.step(13.0f, 2.0f);
+    CORRADE_COMPARE(translationValue, Vector3(2.0f, 0.0f, 0.0f));
+    CORRADE_COMPARE(rotationValue, Quaternion::rotation(Deg(67.5f), Vector3::yAxis()));
+    CORRADE_COMPARE(transformationValue, DualQuaternion::translation(Vector3::zAxis(2.0f)));
+
+    /* Looping back */
+    player.setRepeated(true);
+    group.step(14.5f, 1.5f);
+    CORRADE_COMPARE(translationValue, Vector3(0.5f, 0.0f, 0.0f));
+    CORRADE_COMPARE(transformationValue, DualQuaternion());
+}
+
+void TrackPlayerTest::addEmpty() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    Object3D object;
+    TrackPlayer3D player(object);
+    Track<Vector3> track;
+    Vector3 value;
+    player.add(track, value);
+    CORRADE_COMPARE(player.size(), 0);
+    CORRADE_COMPARE(o.str(), "SceneGraph::TrackPlayer::add(): the track is empty\n");
+}
+
+void TrackPlayerTest::override() {
+    class Joint: public Object3D, public TrackPlayer3D {
+        public:
+            Joint(AnimableGroup3D* group, const Track<Vector3>& translationTrack): TrackPlayer3D(*this, group) {
+                add(translationTrack, translation);
+            }
+
+        protected:
+            void animationStep(Float time, Float delta) override {
+                TrackPlayer3D::animationStep(time, delta);
+                setTransformation(Matrix4::translation(translation));
+            }
+
+        private:
+            Vector3 translation;
+    };
+
+    AnimableGroup3D group;
+    Track<Vector3> track({0.0f, 1.0f}, {Vector3(), Vector3::xAxis(4.0f)});
+    Joint joint(&group, track);
+    joint.setState(AnimationState::Running);
+
+    group.step(1.0f, 0.0f);
+    group.step(1.25f, 0.25f);
+    CORRADE_COMPARE(joint.transformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TrackPlayerTest)
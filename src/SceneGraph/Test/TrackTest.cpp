@@ -0,0 +1,265 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Angle.h"
+#include "SceneGraph/Track.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class TrackTest: public TestSuite::Tester {
+    public:
+        TrackTest();
+
+        void construct();
+        void constructInvalidSize();
+        void constructUnsorted();
+        void addUnsorted();
+
+        void at();
+        void atEmpty();
+        void atCursor();
+        void atSingleKeyframe();
+
+        void interpolateConstant();
+        void interpolateVector();
+        void interpolateQuaternion();
+        void interpolateQuaternionShortestPath();
+        void interpolateDualQuaternion();
+
+        void debugInterpolation();
+};
+
+typedef Math::Deg<Float> Deg;
+
+TrackTest::TrackTest() {
+    addTests({&TrackTest::construct,
+              &TrackTest::constructInvalidSize,
+              &TrackTest::constructUnsorted,
+              &TrackTest::addUnsorted,
+
+              &TrackTest::at,
+              &TrackTest::atEmpty,
+              &TrackTest::atCursor,
+              &TrackTest::atSingleKeyframe,
+
+              &TrackTest::interpolateConstant,
+              &TrackTest::interpolateVector,
+              &TrackTest::interpolateQuaternion,
+              &TrackTest::interpolateQuaternionShortestPath,
+              &TrackTest::interpolateDualQuaternion,
+
+              &TrackTest::debugInterpolation});
+}
+
+void TrackTest::construct() {
+    Track<Float> a;
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.interpolation(), TrackInterpolation::Linear);
+    CORRADE_COMPARE(a.duration(), 0.0f);
+
+    Track<Float> b({0.5f, 1.0f, 3.0f}, {1.0f, 2.0f, 3.0f}, TrackInterpolation::Constant);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b.interpolation(), TrackInterpolation::Constant);
+    CORRADE_COMPARE(b.duration(), 3.0f);
+    CORRADE_COMPARE(b.times(), (std::vector<Float>{0.5f, 1.0f, 3.0f}));
+    CORRADE_COMPARE(b.values(), (std::vector<Float>{1.0f, 2.0f, 3.0f}));
+
+    a.add(0.0f, 5.0f).add(0.0f, 6.0f).add(2.0f, 7.0f);
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.duration(), 2.0f);
+    CORRADE_COMPARE(a.values(), (std::vector<Float>{5.0f, 6.0f, 7.0f}));
+}
+
+void TrackTest::constructInvalidSize() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    Track<Float>({0.0f, 1.0f}, {1.0f});
+    CORRADE_COMPARE(o.str(), "SceneGraph::Track::Track(): expected the same count of times and values, got 2 and 1\n");
+}
+
+void TrackTest::constructUnsorted() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    Track<Float>({1.0f, 0.0f}, {1.0f, 2.0f});
+    CORRADE_COMPARE(o.str(), "SceneGraph::Track::Track(): keyframe times are not sorted\n");
+}
+
+void TrackTest::addUnsorted() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    Track<Float> track;
+    track.add(1.0f, 0.0f).add(0.5f, 1.0f);
+    CORRADE_COMPARE(track.size(), 1);
+    CORRADE_COMPARE(o.str(), "SceneGraph::Track::add(): keyframe at 0.5 is before the last keyframe at 1\n");
+}
+
+void TrackTest::at() {
+    Track<Float> track({1.0f, 2.0f, 4.0f, 5.0f}, {0.0f, 1.0f, 3.0f, -1.0f});
+
+    /* Clamped outside the track */
+    CORRADE_COMPARE(track.at(-1.0f), 0.0f);
+    CORRADE_COMPARE(track.at(7.0f), -1.0f);
+
+    /* Exactly at keyframes */
+    CORRADE_COMPARE(track.at(1.0f), 0.0f);
+    CORRADE_COMPARE(track.at(4.0f), 3.0f);
+    CORRADE_COMPARE(track.at(5.0f), -1.0f);
+
+    /* Interpolated */
+    CORRADE_COMPARE(track.at(1.5f), 0.5f);
+    CORRADE_COMPARE(track.at(3.0f), 2.0f);
+    CORRADE_COMPARE(track.at(4.25f), 2.0f);
+}
+
+void TrackTest::atEmpty() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    Track<Float>().at(1.0f);
+    CORRADE_COMPARE(o.str(), "SceneGraph::Track::at(): the track is empty\n");
+}
+
+void TrackTest::atCursor() {
+    Track<Float> track;
+    for(std::size_t i = 0; i != 10; ++i)
+        track.add(Float(i), Float(i)*2.0f);
+
+    std::size_t cursor = 0;
+
+    /* Sequential playback */
+    CORRADE_COMPARE(track.at(0.5f, cursor), 1.0f);
+    CORRADE_COMPARE(cursor, 0);
+    CORRADE_COMPARE(track.at(0.75f, cursor), 1.5f);
+    CORRADE_COMPARE(cursor, 0);
+    CORRADE_COMPARE(track.at(1.5f, cursor), 3.0f);
+    CORRADE_COMPARE(cursor, 1);
+
+    /* Jump forward */
+    CORRADE_COMPARE(track.at(7.5f, cursor), 15.0f);
+    CORRADE_COMPARE(cursor, 7);
+
+    /* Jump back */
+    CORRADE_COMPARE(track.at(2.5f, cursor), 5.0f);
+    CORRADE_COMPARE(cursor, 2);
+
+    /* Past the end and before the beginning */
+    CORRADE_COMPARE(track.at(12.0f, cursor), 18.0f);
+    CORRADE_COMPARE(cursor, 9);
+    CORRADE_COMPARE(track.at(-1.0f, cursor), 0.0f);
+    CORRADE_COMPARE(cursor, 0);
+
+    /* Invalid cursor is handled gracefully */
+    cursor = 1000;
+    CORRADE_COMPARE(track.at(3.5f, cursor), 7.0f);
+    CORRADE_COMPARE(cursor, 3);
+}
+
+void TrackTest::atSingleKeyframe() {
+    Track<Float> track({1.0f}, {3.0f});
+
+    std::size_t cursor = 0;
+    CORRADE_COMPARE(track.at(0.0f, cursor), 3.0f);
+    CORRADE_COMPARE(track.at(1.0f, cursor), 3.0f);
+    CORRADE_COMPARE(track.at(2.0f, cursor), 3.0f);
+    CORRADE_COMPARE(cursor, 0);
+}
+
+void TrackTest::interpolateConstant() {
+    Track<Vector3> track({0.0f, 1.0f}, {Vector3(1.0f), Vector3(3.0f)}, TrackInterpolation::Constant);
+    CORRADE_COMPARE(track.at(0.0f), Vector3(1.0f));
+    CORRADE_COMPARE(track.at(0.99f), Vector3(1.0f));
+    CORRADE_COMPARE(track.at(1.0f), Vector3(3.0f));
+}
+
+void TrackTest::interpolateVector() {
+    Track<Vector3> track({0.0f, 1.0f}, {Vector3(1.0f, 2.0f, 3.0f), Vector3(3.0f, 2.0f, 1.0f)});
+    CORRADE_COMPARE(track.at(0.25f), Vector3(1.5f, 2.0f, 2.5f));
+
+    /* Spherical interpolation is the same as linear for vectors */
+    track.setInterpolation(TrackInterpolation::Spherical);
+    CORRADE_COMPARE(track.at(0.25f), Vector3(1.5f, 2.0f, 2.5f));
+}
+
+void TrackTest::interpolateQuaternion() {
+    const Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3::xAxis());
+    const Quaternion b = Quaternion::rotation(Deg(23.0f), Vector3(1.0f, 0.0f, 1.0f).normalized());
+    Track<Quaternion> track({0.0f, 1.0f}, {a, b});
+
+    CORRADE_COMPARE(track.at(0.35f), Quaternion::lerp(a, b, 0.35f));
+
+    track.setInterpolation(TrackInterpolation::Spherical);
+    CORRADE_COMPARE(track.at(0.35f), Quaternion::slerp(a, b, 0.35f));
+
+    /* Same quaternions shouldn't result in NaN */
+    Track<Quaternion> same({0.0f, 1.0f}, {a, a}, TrackInterpolation::Spherical);
+    CORRADE_COMPARE(same.at(0.5f), a);
+}
+
+void TrackTest::interpolateQuaternionShortestPath() {
+    const Quaternion a = Quaternion::rotation(Deg(10.0f), Vector3::zAxis());
+    const Quaternion b = Quaternion::rotation(Deg(30.0f), Vector3::zAxis());
+
+    /* -b represents the same rotation, the interpolation should go along the
+       shortest path */
+    Track<Quaternion> track({0.0f, 1.0f}, {a, -b});
+    CORRADE_COMPARE(track.at(0.5f), Quaternion::rotation(Deg(20.0f), Vector3::zAxis()));
+
+    track.setInterpolation(TrackInterpolation::Spherical);
+    CORRADE_COMPARE(track.at(0.5f), Quaternion::rotation(Deg(20.0f), Vector3::zAxis()));
+}
+
+void TrackTest::interpolateDualQuaternion() {
+    const DualQuaternion a = DualQuaternion::translation({1.0f, 0.0f, 0.0f})*
+                             DualQuaternion::rotation(Deg(10.0f), Vector3::zAxis());
+    const DualQuaternion b = DualQuaternion::translation({3.0f, 2.0f, 0.0f})*
+                             DualQuaternion::rotation(Deg(50.0f), Vector3::zAxis());
+    Track<DualQuaternion> track({0.0f, 1.0f}, {a, b}, TrackInterpolation::Spherical);
+
+    const DualQuaternion spherical = track.at(0.5f);
+    CORRADE_VERIFY(spherical.isNormalized());
+    CORRADE_COMPARE(spherical.rotation(), Quaternion::rotation(Deg(30.0f), Vector3::zAxis()));
+    CORRADE_COMPARE(spherical.translation(), Vector3(2.0f, 1.0f, 0.0f));
+
+    /* Linear blending, rotation along the shortest path */
+    track = Track<DualQuaternion>({0.0f, 1.0f}, {a, -b});
+    const DualQuaternion linear = track.at(0.5f);
+    CORRADE_VERIFY(linear.isNormalized());
+    CORRADE_COMPARE(linear.rotation(), Quaternion::rotation(Deg(30.0f), Vector3::zAxis()));
+}
+
+void TrackTest::debugInterpolation() {
+    std::ostringstream o;
+    Debug(&o) << TrackInterpolation::Spherical;
+    CORRADE_COMPARE(o.str(), "SceneGraph::TrackInterpolation::Spherical\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TrackTest)
@@ -0,0 +1,278 @@
+#ifndef Magnum_SceneGraph_Track_h
+#define Magnum_SceneGraph_Track_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::Track, enum Magnum::SceneGraph::TrackInterpolation
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <Utility/Assert.h>
+
+#include "Math/Functions.h"
+#include "Math/DualQuaternion.h"
+#include "Math/TypeTraits.h"
+#include "Magnum.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Track interpolation
+
+@see @ref Track::setInterpolation()
+*/
+enum class TrackInterpolation: UnsignedByte {
+    /** Value of the previous keyframe is used. */
+    Constant,
+
+    /**
+     * Linear interpolation. Quaternions are interpolated using normalized
+     * linear interpolation (shortest path), dual quaternions using linear
+     * blending.
+     */
+    Linear,
+
+    /**
+     * Spherical interpolation. Quaternions are interpolated using spherical
+     * linear interpolation (shortest path), rotation part of dual
+     * quaternions is interpolated spherically and translation linearly. Other
+     * types are interpolated linearly.
+     */
+    Spherical
+};
+
+/** @debugoperator{Magnum::SceneGraph::Track} */
+Debug MAGNUM_SCENEGRAPH_EXPORT operator<<(Debug debug, TrackInterpolation value);
+
+namespace Implementation {
+    template<class V> inline V interpolate(const V& a, const V& b, Float t, TrackInterpolation) {
+        return Math::lerp(a, b, t);
+    }
+
+    template<class T> Math::Quaternion<T> interpolate(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b, Float t, TrackInterpolation interpolation) {
+        /* Go along the shortest path */
+        const T cosAngle = Math::Quaternion<T>::dot(a, b);
+        const Math::Quaternion<T> shortestB = cosAngle < T(0) ? -b : b;
+
+        /* Spherical interpolation, unless the quaternions are too close */
+        if(interpolation == TrackInterpolation::Spherical && std::abs(cosAngle) < T(1) - Math::TypeTraits<T>::epsilon())
+            return Math::Quaternion<T>::slerp(a, shortestB, t);
+
+        return Math::Quaternion<T>::lerp(a, shortestB, t);
+    }
+
+    template<class T> Math::DualQuaternion<T> interpolate(const Math::DualQuaternion<T>& a, const Math::DualQuaternion<T>& b, Float t, TrackInterpolation interpolation) {
+        /* Rotation spherically, translation linearly */
+        if(interpolation == TrackInterpolation::Spherical)
+            return Math::DualQuaternion<T>::translation(Math::lerp(a.translation(), b.translation(), T(t)))*
+                   Math::DualQuaternion<T>(interpolate(a.rotation(), b.rotation(), t, interpolation));
+
+        /* Dual quaternion linear blending along the shortest path */
+        const Math::DualQuaternion<T> shortestB = Math::Quaternion<T>::dot(a.real(), b.real()) < T(0) ? -b : b;
+        return Math::DualQuaternion<T>((T(1) - t)*a.real() + t*shortestB.real(),
+                                       (T(1) - t)*a.dual() + t*shortestB.dual()).normalized();
+    }
+}
+
+/**
+@brief Keyframe track
+
+Stores list of keyframes, each of them consisting of time and value, sorted
+by time. Value at arbitrary time is computed by interpolating the two
+surrounding keyframes, see @ref TrackInterpolation for list of available
+interpolation modes. Values before the first and after the last keyframe are
+clamped. Translation, rotation and scaling tracks are usually represented
+using @ref Vector3, @ref Quaternion or @ref DualQuaternion:
+@code
+SceneGraph::Track<Quaternion> rotation(SceneGraph::TrackInterpolation::Spherical);
+rotation.add(0.0f, Quaternion())
+    .add(1.0f, Quaternion::rotation(90.0_degf, Vector3::yAxis()))
+    .add(2.0f, Quaternion::rotation(180.0_degf, Vector3::yAxis()));
+
+Quaternion q = rotation.at(0.5f);
+@endcode
+
+@section Track-cursor Sequential playback
+
+Finding the keyframes surrounding given time is done using binary search. If
+the track is played back sequentially, you can pass a cursor to
+@ref at(Float, std::size_t&) const. The cursor remembers position of last
+found keyframe and the lookup then starts from there, making the lookup
+amortized @f$ \mathcal{O}(1) @f$. @ref TrackPlayer does that automatically
+for all tracks it plays.
+
+@see @ref scenegraph
+*/
+template<class V> class Track {
+    public:
+        /** @brief Value type */
+        typedef V Type;
+
+        /**
+         * @brief Constructor
+         * @param interpolation     Interpolation mode
+         *
+         * Creates empty track.
+         */
+        explicit Track(TrackInterpolation interpolation = TrackInterpolation::Linear): _interpolation(interpolation) {}
+
+        /**
+         * @brief Construct track from keyframe data
+         * @param times             Keyframe times
+         * @param values            Keyframe values
+         * @param interpolation     Interpolation mode
+         *
+         * Expects that both arrays have the same size and that the times
+         * are sorted.
+         */
+        explicit Track(std::vector<Float> times, std::vector<V> values, TrackInterpolation interpolation = TrackInterpolation::Linear);
+
+        /** @brief Interpolation mode */
+        TrackInterpolation interpolation() const { return _interpolation; }
+
+        /**
+         * @brief Set interpolation mode
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref TrackInterpolation::Linear.
+         */
+        Track<V>& setInterpolation(TrackInterpolation interpolation) {
+            _interpolation = interpolation;
+            return *this;
+        }
+
+        /** @brief Whether the track is empty */
+        bool isEmpty() const { return _times.empty(); }
+
+        /** @brief Keyframe count */
+        std::size_t size() const { return _times.size(); }
+
+        /** @brief Keyframe times */
+        const std::vector<Float>& times() const { return _times; }
+
+        /** @brief Keyframe values */
+        const std::vector<V>& values() const { return _values; }
+
+        /**
+         * @brief Track duration
+         *
+         * Time of the last keyframe or `0.0f`, if the track is empty.
+         */
+        Float duration() const { return _times.empty() ? 0.0f : _times.back(); }
+
+        /**
+         * @brief Add keyframe
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p time is not smaller than time of the last
+         * keyframe.
+         */
+        Track<V>& add(Float time, const V& value);
+
+        /**
+         * @brief Value at given time
+         *
+         * Finds the surrounding keyframes using binary search and interpolates
+         * between them. Expects that the track is not empty.
+         * @see @ref at(Float, std::size_t&) const
+         */
+        V at(Float time) const {
+            std::size_t cursor = 0;
+            return at(time, cursor);
+        }
+
+        /**
+         * @brief Value at given time using cursor
+         * @param time      Time
+         * @param cursor    Index of keyframe found in previous lookup
+         *
+         * Same as @ref at(Float) const, but the lookup starts at keyframe
+         * @p cursor and the cursor is then updated to index of keyframe
+         * before @p time. If @p time is between the cursor and the next two
+         * keyframes, the lookup is done in constant time, otherwise binary
+         * search is used. Initialize the cursor to `0`.
+         */
+        V at(Float time, std::size_t& cursor) const;
+
+    private:
+        std::size_t find(Float time, std::size_t cursor) const;
+
+        std::vector<Float> _times;
+        std::vector<V> _values;
+        TrackInterpolation _interpolation;
+};
+
+template<class V> Track<V>::Track(std::vector<Float> times, std::vector<V> values, TrackInterpolation interpolation): _times(std::move(times)), _values(std::move(values)), _interpolation(interpolation) {
+    CORRADE_ASSERT(_times.size() == _values.size(),
+        "SceneGraph::Track::Track(): expected the same count of times and values, got" << _times.size() << "and" << _values.size(), );
+    CORRADE_ASSERT(std::is_sorted(_times.begin(), _times.end()),
+        "SceneGraph::Track::Track(): keyframe times are not sorted", );
+}
+
+template<class V> Track<V>& Track<V>::add(const Float time, const V& value) {
+    CORRADE_ASSERT(_times.empty() || _times.back() <= time,
+        "SceneGraph::Track::add(): keyframe at" << time << "is before the last keyframe at" << _times.back(), *this);
+
+    _times.push_back(time);
+    _values.push_back(value);
+    return *this;
+}
+
+template<class V> std::size_t Track<V>::find(const Float time, const std::size_t cursor) const {
+    /* The time is between the cursor and the next keyframe or the one after
+       it, which is the usual case for sequential playback */
+    if(cursor + 1 < _times.size() && _times[cursor] <= time) {
+        if(time < _times[cursor + 1]) return cursor;
+        if(cursor + 2 == _times.size() || time < _times[cursor + 2]) return cursor + 1;
+    }
+
+    /* Otherwise find the first keyframe after given time */
+    const std::size_t next = std::upper_bound(_times.begin(), _times.end(), time) - _times.begin();
+    return next ? next - 1 : 0;
+}
+
+template<class V> V Track<V>::at(const Float time, std::size_t& cursor) const {
+    CORRADE_ASSERT(!_times.empty(), "SceneGraph::Track::at(): the track is empty", V());
+
+    cursor = find(time, cursor);
+
+    /* Clamp values outside the track */
+    if(time <= _times[cursor] || cursor + 1 == _times.size())
+        return _values[cursor];
+
+    if(_interpolation == TrackInterpolation::Constant)
+        return _values[cursor];
+
+    const Float t = (time - _times[cursor])/(_times[cursor + 1] - _times[cursor]);
+    return Implementation::interpolate(_values[cursor], _values[cursor + 1], t, _interpolation);
+}
+
+}}
+
+#endif
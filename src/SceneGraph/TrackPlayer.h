@@ -0,0 +1,205 @@
+#ifndef Magnum_SceneGraph_TrackPlayer_h
+#define Magnum_SceneGraph_TrackPlayer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::TrackPlayer, alias Magnum::SceneGraph::BasicTrackPlayer2D, Magnum::SceneGraph::BasicTrackPlayer3D, typedef Magnum::SceneGraph::TrackPlayer2D, Magnum::SceneGraph::TrackPlayer3D
+ */
+
+#include "Animable.h"
+#include "Track.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Keyframe track player
+
+%Animable which plays back set of @ref Track "keyframe tracks". Each track
+is added together with destination, to which interpolated value is written on
+each animation step. Each track has its own cursor, so the keyframe lookup
+during sequential playback is done in amortized constant time, see
+@ref Track-cursor "Track documentation" for more information. Animation
+duration is set to duration of the longest track.
+
+@section TrackPlayer-usage Usage
+
+Subclass the player, add the tracks and override @ref animationStep() to
+apply the interpolated values to your objects after calling the original
+implementation. Example of animating skeleton joints:
+@code
+class Skeleton: public Object3D, SceneGraph::TrackPlayer3D {
+    public:
+        Skeleton(Object3D* parent, SceneGraph::AnimableGroup3D* group, const std::vector<SceneGraph::Track<Vector3>>& translationTracks, const std::vector<SceneGraph::Track<Quaternion>>& rotationTracks): Object3D(parent), SceneGraph::TrackPlayer3D(*this, group), translations(translationTracks.size()), rotations(rotationTracks.size()) {
+            for(std::size_t i = 0; i != translations.size(); ++i) {
+                joints.push_back(new Object3D(this));
+                add(translationTracks[i], translations[i]);
+                add(rotationTracks[i], rotations[i]);
+            }
+        }
+
+    protected:
+        void animationStep(Float time, Float delta) override {
+            SceneGraph::TrackPlayer3D::animationStep(time, delta);
+            for(std::size_t i = 0; i != joints.size(); ++i)
+                joints[i]->setTransformation(Matrix4::from(rotations[i].toMatrix(), translations[i]));
+        }
+
+    private:
+        std::vector<Object3D*> joints;
+        std::vector<Vector3> translations;
+        std::vector<Quaternion> rotations;
+};
+@endcode
+
+The tracks and destinations must be alive for whole lifetime of the player.
+
+@section TrackPlayer-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Double type) you have to
+use @ref TrackPlayer.hpp implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref TrackPlayer2D
+-   @ref TrackPlayer3D
+
+@see @ref scenegraph, @ref BasicTrackPlayer2D, @ref BasicTrackPlayer3D,
+    @ref TrackPlayer2D, @ref TrackPlayer3D, @ref Track
+*/
+template<UnsignedInt dimensions, class T> class TrackPlayer: public Animable<dimensions, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    %Object this player belongs to
+         * @param group     Group this player belongs to
+         *
+         * Creates player without any tracks.
+         * @see @ref Animable::Animable()
+         */
+        explicit TrackPlayer(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group = nullptr);
+
+        ~TrackPlayer();
+
+        /** @brief Count of played tracks */
+        std::size_t size() const {
+            return _vector3Channels.size() + _quaternionChannels.size() + _dualQuaternionChannels.size();
+        }
+
+        /**
+         * @brief Add track
+         * @param track         Track to play
+         * @param destination   Where to put interpolated value
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the track is not empty. If the track is longer than
+         * current animation duration, the duration is extended.
+         */
+        TrackPlayer<dimensions, T>& add(const Track<Math::Vector3<T>>& track, Math::Vector3<T>& destination);
+
+        /** @overload */
+        TrackPlayer<dimensions, T>& add(const Track<Math::Quaternion<T>>& track, Math::Quaternion<T>& destination);
+
+        /** @overload */
+        TrackPlayer<dimensions, T>& add(const Track<Math::DualQuaternion<T>>& track, Math::DualQuaternion<T>& destination);
+
+    protected:
+        /**
+         * @brief Perform animation step
+         *
+         * Writes value of each track at @p time to its destination. Override
+         * this function to apply the values to your objects, but don't forget
+         * to call the original implementation first.
+         */
+        void animationStep(Float time, Float delta) override;
+
+    private:
+        template<class V> struct Channel {
+            const Track<V>* track;
+            V* destination;
+            std::size_t cursor;
+        };
+
+        template<class V> void addChannel(std::vector<Channel<V>>& channels, const Track<V>& track, V& destination);
+        template<class V> static void play(std::vector<Channel<V>>& channels, Float time);
+
+        std::vector<Channel<Math::Vector3<T>>> _vector3Channels;
+        std::vector<Channel<Math::Quaternion<T>>> _quaternionChannels;
+        std::vector<Channel<Math::DualQuaternion<T>>> _dualQuaternionChannels;
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Track player for two-dimensional scenes
+
+Convenience alternative to <tt>%TrackPlayer<2, T></tt>. See TrackPlayer for
+more information.
+@note Not available on GCC < 4.7. Use <tt>%TrackPlayer<2, T></tt> instead.
+@see @ref TrackPlayer2D, @ref BasicTrackPlayer3D
+*/
+template<class T> using BasicTrackPlayer2D = TrackPlayer<2, T>;
+#endif
+
+/**
+@brief Track player for two-dimensional float scenes
+
+@see @ref TrackPlayer3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicTrackPlayer2D<Float> TrackPlayer2D;
+#else
+typedef TrackPlayer<2, Float> TrackPlayer2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Track player for three-dimensional scenes
+
+Convenience alternative to <tt>%TrackPlayer<3, T></tt>. See TrackPlayer for
+more information.
+@note Not available on GCC < 4.7. Use <tt>%TrackPlayer<3, T></tt> instead.
+@see @ref TrackPlayer3D, @ref BasicTrackPlayer2D
+*/
+template<class T> using BasicTrackPlayer3D = TrackPlayer<3, T>;
+#endif
+
+/**
+@brief Track player for three-dimensional float scenes
+
+@see @ref TrackPlayer2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicTrackPlayer3D<Float> TrackPlayer3D;
+#else
+typedef TrackPlayer<3, Float> TrackPlayer3D;
+#endif
+
+#ifdef CORRADE_TARGET_WINDOWS
+extern template class MAGNUM_SCENEGRAPH_EXPORT TrackPlayer<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT TrackPlayer<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef Magnum_SceneGraph_TrackPlayer_hpp
+#define Magnum_SceneGraph_TrackPlayer_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref TrackPlayer.h
+ */
+
+#include "TrackPlayer.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> TrackPlayer<dimensions, T>::TrackPlayer(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): Animable<dimensions, T>(object, group) {}
+
+template<UnsignedInt dimensions, class T> TrackPlayer<dimensions, T>::~TrackPlayer() {}
+
+template<UnsignedInt dimensions, class T> TrackPlayer<dimensions, T>& TrackPlayer<dimensions, T>::add(const Track<Math::Vector3<T>>& track, Math::Vector3<T>& destination) {
+    addChannel(_vector3Channels, track, destination);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> TrackPlayer<dimensions, T>& TrackPlayer<dimensions, T>::add(const Track<Math::Quaternion<T>>& track, Math::Quaternion<T>& destination) {
+    addChannel(_quaternionChannels, track, destination);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> TrackPlayer<dimensions, T>& TrackPlayer<dimensions, T>::add(const Track<Math::DualQuaternion<T>>& track, Math::DualQuaternion<T>& destination) {
+    addChannel(_dualQuaternionChannels, track, destination);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> template<class V> void TrackPlayer<dimensions, T>::addChannel(std::vector<Channel<V>>& channels, const Track<V>& track, V& destination) {
+    CORRADE_ASSERT(!track.isEmpty(), "SceneGraph::TrackPlayer::add(): the track is empty", );
+
+    channels.push_back({&track, &destination, 0});
+    if(track.duration() > this->duration()) this->setDuration(track.duration());
+}
+
+template<UnsignedInt dimensions, class T> template<class V> void TrackPlayer<dimensions, T>::play(std::vector<Channel<V>>& channels, const Float time) {
+    for(Channel<V>& channel: channels)
+        *channel.destination = channel.track->at(time, channel.cursor);
+}
+
+template<UnsignedInt dimensions, class T> void TrackPlayer<dimensions, T>::animationStep(const Float time, Float) {
+    play(_vector3Channels, time);
+    play(_quaternionChannels, time);
+    play(_dualQuaternionChannels, time);
+}
+
+}}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef Magnum_SceneGraph_TransformationContext_h
+#define Magnum_SceneGraph_TransformationContext_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::TransformationContext
+ */
+
+#include <unordered_map>
+
+#include "Object.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Context for computing object transformations
+
+Holds temporary bookkeeping of
+@ref Object::transformations(std::vector<Object<Transformation>*>, TransformationContext<Transformation>&, const typename Transformation::DataType&) const "Object::transformations()"
+and @ref Object::transformationMatrices(const std::vector<Object<Transformation>*>&, TransformationContext<Transformation>&, const MatrixType&) const "Object::transformationMatrices()"
+outside of the objects, so transformations of one scene can be computed from
+more threads at once. Each thread must have its own context, the scene must
+not be modified during the computation. The context keeps its allocated
+storage between calls, so it is advised to reuse it, e.g.:
+@code
+Scene3D scene;
+std::vector<Object3D*> shadowObjects, mainObjects;
+
+SceneGraph::TransformationContext<SceneGraph::MatrixTransformation3D> shadowContext, mainContext;
+std::thread shadow([&]() {
+    auto transformations = scene.transformationMatrices(shadowObjects, shadowContext, shadowCameraMatrix);
+    // ...
+});
+auto transformations = scene.transformationMatrices(mainObjects, mainContext, cameraMatrix);
+shadow.join();
+@endcode
+*/
+template<class Transformation> class TransformationContext {
+    friend class Object<Transformation>;
+
+    public:
+        /** @brief Constructor */
+        explicit TransformationContext() = default;
+
+    private:
+        struct Mark {
+            Mark(): counter(0xFFFFFFFFu) {}
+
+            UnsignedInt counter;
+            Implementation::ObjectFlags flags;
+        };
+
+        Implementation::ObjectFlags& flags(Object<Transformation>* o) { return _marks[o].flags; }
+        UnsignedInt& counter(Object<Transformation>* o) { return _marks[o].counter; }
+
+        std::unordered_map<const Object<Transformation>*, Mark> _marks;
+};
+
+}}
+
+#endif
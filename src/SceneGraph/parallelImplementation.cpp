@@ -0,0 +1,138 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "parallelImplementation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Utility/Assert.h>
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+namespace {
+
+class ThreadPool {
+    public:
+        explicit ThreadPool(): _function(nullptr), _count(0), _chunkSize(0), _next(0), _participants(0), _running(0), _generation(0), _quit(false) {}
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _quit = true;
+            }
+            _wake.notify_all();
+            for(std::thread& t: _threads) t.join();
+        }
+
+        void run(UnsignedInt threadCount, std::size_t count, std::size_t chunkSize, const std::function<void(std::size_t, std::size_t)>& function) {
+            std::lock_guard<std::mutex> callLock(_callMutex);
+
+            /* Spawn additional workers, if needed */
+            while(_threads.size() < threadCount - 1)
+                _threads.emplace_back(&ThreadPool::worker, this);
+
+            /* Publish the job and wake up the workers */
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _function = &function;
+                _count = count;
+                _chunkSize = chunkSize;
+                _next = 0;
+                _participants = threadCount - 1;
+                ++_generation;
+            }
+            _wake.notify_all();
+
+            /* Process the job on this thread too */
+            process();
+
+            /* Don't let any other workers join, wait for the running ones */
+            std::unique_lock<std::mutex> lock(_mutex);
+            _participants = 0;
+            _done.wait(lock, [this]() { return _running == 0; });
+            _function = nullptr;
+        }
+
+    private:
+        void worker() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            UnsignedLong generation = 0;
+            for(;;) {
+                _wake.wait(lock, [this, &generation]() {
+                    return _quit || (_generation != generation && _participants != 0);
+                });
+                if(_quit) return;
+
+                generation = _generation;
+                --_participants;
+                ++_running;
+
+                lock.unlock();
+                process();
+                lock.lock();
+
+                if(--_running == 0) _done.notify_all();
+            }
+        }
+
+        void process() {
+            for(;;) {
+                const std::size_t begin = _next.fetch_add(_chunkSize);
+                if(begin >= _count) return;
+                (*_function)(begin, std::min(begin + _chunkSize, _count));
+            }
+        }
+
+        std::vector<std::thread> _threads;
+        std::mutex _callMutex, _mutex;
+        std::condition_variable _wake, _done;
+
+        const std::function<void(std::size_t, std::size_t)>* _function;
+        std::size_t _count, _chunkSize;
+        std::atomic<std::size_t> _next;
+        UnsignedInt _participants, _running;
+        UnsignedLong _generation;
+        bool _quit;
+};
+
+}
+
+void parallelFor(const UnsignedInt threadCount, const std::size_t count, const std::size_t chunkSize, const std::function<void(std::size_t, std::size_t)>& function) {
+    CORRADE_INTERNAL_ASSERT(threadCount && chunkSize);
+
+    /* Not worth the synchronization overhead */
+    if(threadCount == 1 || count <= chunkSize) {
+        if(count) function(0, count);
+        return;
+    }
+
+    static ThreadPool pool;
+    pool.run(std::min(threadCount, UnsignedInt((count + chunkSize - 1)/chunkSize)), count, chunkSize, function);
+}
+
+}}}
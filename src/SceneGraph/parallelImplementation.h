@@ -0,0 +1,47 @@
+#ifndef Magnum_SceneGraph_parallelImplementation_h
+#define Magnum_SceneGraph_parallelImplementation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <functional>
+
+#include "Types.h"
+#include "SceneGraph/magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+/*
+Calls `function(begin, end)` for consecutive chunks of range [0, count) with
+at most `chunkSize` items, using at most `threadCount` threads (including the
+calling one). The chunks are distributed dynamically, so faster threads
+process more of them. The workers are kept in a global pool and reused
+between calls, concurrent calls are serialized. If `threadCount` is 1 or the
+range fits into one chunk, the function is called directly.
+*/
+MAGNUM_SCENEGRAPH_EXPORT void parallelFor(UnsignedInt threadCount, std::size_t count, std::size_t chunkSize, const std::function<void(std::size_t, std::size_t)>& function);
+
+}}}
+
+#endif
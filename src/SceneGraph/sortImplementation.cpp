@@ -0,0 +1,68 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "sortImplementation.h"
+
+#include <Utility/Assert.h>
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+void radixSort(std::vector<UnsignedLong>& keys, std::vector<UnsignedInt>& values) {
+    CORRADE_INTERNAL_ASSERT(keys.size() == values.size());
+
+    std::vector<UnsignedLong> keysOut(keys.size());
+    std::vector<UnsignedInt> valuesOut(values.size());
+
+    /* Histograms for all passes computed at once */
+    std::size_t counts[8][256] = {};
+    for(UnsignedLong key: keys)
+        for(std::size_t pass = 0; pass != 8; ++pass)
+            ++counts[pass][(key >> 8*pass) & 0xff];
+
+    for(std::size_t pass = 0; pass != 8; ++pass) {
+        /* All keys have the same byte, the pass wouldn't change anything */
+        if(counts[pass][(keys.empty() ? 0 : keys[0] >> 8*pass) & 0xff] == keys.size())
+            continue;
+
+        /* Convert counts to offsets */
+        std::size_t offset = 0;
+        for(std::size_t& count: counts[pass]) {
+            const std::size_t c = count;
+            count = offset;
+            offset += c;
+        }
+
+        /* Scatter */
+        for(std::size_t i = 0; i != keys.size(); ++i) {
+            const std::size_t position = counts[pass][(keys[i] >> 8*pass) & 0xff]++;
+            keysOut[position] = keys[i];
+            valuesOut[position] = values[i];
+        }
+
+        keys.swap(keysOut);
+        values.swap(valuesOut);
+    }
+}
+
+}}}
@@ -0,0 +1,51 @@
+#ifndef Magnum_SceneGraph_sortImplementation_h
+#define Magnum_SceneGraph_sortImplementation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <vector>
+
+#include "Types.h"
+#include "SceneGraph/magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+/*
+Stable LSD radix sort of `values` by `keys`, eight bits per pass. Passes in
+which all keys have the same byte are skipped, so e.g. keys using only the
+upper half need only four passes. The `keys` are reordered too.
+*/
+MAGNUM_SCENEGRAPH_EXPORT void radixSort(std::vector<UnsignedLong>& keys, std::vector<UnsignedInt>& values);
+
+/* Maps float to unsigned integer with the same ordering */
+inline UnsignedInt sortableFloat(Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits & 0x80000000u ? ~bits : bits|0x80000000u;
+}
+
+}}}
+
+#endif
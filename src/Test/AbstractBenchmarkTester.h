@@ -0,0 +1,59 @@
+#ifndef Magnum_Test_AbstractBenchmarkTester_h
+#define Magnum_Test_AbstractBenchmarkTester_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <string>
+#include <TestSuite/Tester.h>
+#include <Utility/Debug.h>
+
+#include "Magnum.h"
+
+namespace Magnum { namespace Test {
+
+/*
+Tester with simple wall-clock timing. The benchmarked function is run given
+number of times and the average duration of one run is printed to debug
+output. Results of the function are meant to be verified with usual
+CORRADE_COMPARE() / CORRADE_VERIFY() macros afterwards, so the benchmarks can
+run as part of the test suite.
+*/
+class AbstractBenchmarkTester: public TestSuite::Tester {
+    protected:
+        template<class T> void benchmark(const std::string& name, UnsignedInt iterations, T function) {
+            /* Warm-up run, not included in the measurement */
+            function();
+
+            const auto begin = std::chrono::high_resolution_clock::now();
+            for(UnsignedInt i = 0; i != iterations; ++i) function();
+            const auto end = std::chrono::high_resolution_clock::now();
+
+            Debug() << "  BENCH:" << name << std::chrono::duration<Double, std::micro>(end - begin).count()/iterations << "us";
+        }
+};
+
+}}
+
+#endif
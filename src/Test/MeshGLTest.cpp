@@ -22,8 +22,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Buffer.h"
 #include "Context.h"
 #include "Extensions.h"
+#include "Math/Matrix4.h"
 #include "Mesh.h"
 #include "Test/AbstractOpenGLTester.h"
 
@@ -34,10 +36,17 @@ class MeshGLTest: public AbstractOpenGLTester {
         explicit MeshGLTest();
 
         void label();
+        #ifndef MAGNUM_TARGET_GLES2
+        void instanced();
+        #endif
 };
 
 MeshGLTest::MeshGLTest() {
-    addTests({&MeshGLTest::label});
+    addTests({&MeshGLTest::label,
+              #ifndef MAGNUM_TARGET_GLES2
+              &MeshGLTest::instanced
+              #endif
+              });
 }
 
 void MeshGLTest::label() {
@@ -55,6 +64,66 @@ void MeshGLTest::label() {
     MAGNUM_VERIFY_NO_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void MeshGLTest::instanced() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current()->isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not supported"));
+    #endif
+
+    typedef AbstractShaderProgram::Attribute<0, Vector3> Position;
+    typedef AbstractShaderProgram::Attribute<1, Matrix4> Transformation;
+    typedef AbstractShaderProgram::Attribute<5, Int> Id;
+
+    Buffer vertices, instances;
+    vertices.setData(std::vector<Vector3>(3), BufferUsage::StaticDraw);
+    instances.setData(std::vector<char>(3*(sizeof(Matrix4) + sizeof(Int))), BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    CORRADE_COMPARE(mesh.instanceCount(), 1);
+
+    /* Matrix attribute spans four locations, each needs its own divisor */
+    mesh.setVertexCount(3)
+        .addVertexBuffer(vertices, 0, Position())
+        .addInstancedVertexBuffer(instances, 1, 0, Transformation(), Id())
+        .setInstanceCount(3);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(mesh.instanceCount(), 3);
+
+    /* Zero instances doesn't draw anything */
+    mesh.setInstanceCount(0)
+        .draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Instanced draw */
+    mesh.setInstanceCount(3)
+        .draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Without VAOs the divisor is global state, it must be reset after the
+       draw so it doesn't affect meshes drawn later */
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current()->isExtensionSupported<Extensions::GL::APPLE::vertex_array_object>())
+    #endif
+    {
+        GLint divisor = -1;
+        glGetVertexAttribiv(1, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &divisor);
+        CORRADE_COMPARE(divisor, 0);
+        glGetVertexAttribiv(5, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &divisor);
+        CORRADE_COMPARE(divisor, 0);
+    }
+
+    /* Non-instanced mesh using the same locations afterwards */
+    Buffer perVertex;
+    perVertex.setData(std::vector<char>(3*(sizeof(Vector3) + sizeof(Matrix4))), BufferUsage::StaticDraw);
+    Mesh plain;
+    plain.setVertexCount(3)
+        .addVertexBuffer(perVertex, 0, Position(), Transformation())
+        .draw();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
 }}
 
 CORRADE_TEST_MAIN(Magnum::Test::MeshGLTest)